@@ -0,0 +1,113 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: Python int amounts in cashu/core/base.py and cashu/mint/crud.py
+// Checked 64-bit amount arithmetic - ENHANCEMENT beyond nutshell
+// Protocol amounts fit in 64 bits; overflow raises instead of silently wrapping
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace cashu::core {
+
+/**
+ * @brief Protocol amount in the smallest unit of a keyset (sat, msat, cents)
+ */
+using amount_t = uint64_t;
+
+/**
+ * @brief Add amounts
+ * @throws std::overflow_error if the sum exceeds 64 bits
+ */
+inline amount_t checked_add(amount_t a, amount_t b) {
+    amount_t result;
+#if defined(__GNUC__) || defined(__clang__)
+    bool overflow = __builtin_add_overflow(a, b, &result);
+#else
+    result = a + b;
+    bool overflow = result < a;
+#endif
+    if (overflow) {
+        throw std::overflow_error("Amount overflow: " + std::to_string(a) + " + " + std::to_string(b));
+    }
+    return result;
+}
+
+/**
+ * @brief Subtract amounts
+ * @throws std::underflow_error if b > a
+ */
+inline amount_t checked_sub(amount_t a, amount_t b) {
+    if (b > a) {
+        throw std::underflow_error("Amount underflow: " + std::to_string(a) + " - " + std::to_string(b));
+    }
+    return a - b;
+}
+
+/**
+ * @brief Multiply amounts
+ * @throws std::overflow_error if the product exceeds 64 bits
+ */
+inline amount_t checked_mul(amount_t a, amount_t b) {
+    amount_t result;
+#if defined(__GNUC__) || defined(__clang__)
+    bool overflow = __builtin_mul_overflow(a, b, &result);
+#else
+    result = a * b;
+    bool overflow = b != 0 && a > UINT64_MAX / b;
+#endif
+    if (overflow) {
+        throw std::overflow_error("Amount overflow: " + std::to_string(a) + " * " + std::to_string(b));
+    }
+    return result;
+}
+
+/**
+ * @brief Sum amounts with a single overflow check at the end
+ *
+ * Accumulates in four independent lanes with a sticky carry flag per lane,
+ * a branch-free loop the compiler can vectorize.
+ *
+ * @param values Amounts to sum
+ * @param count Number of amounts
+ * @return Total
+ * @throws std::overflow_error if the sum exceeds 64 bits
+ */
+amount_t checked_sum(const amount_t* values, size_t count);
+
+/**
+ * @brief Sum the amount field of proofs, promises or views
+ *
+ * Gathers the amounts in fixed-size chunks on the stack and sums each with
+ * checked_sum().
+ *
+ * @param items Range of objects with an amount_t amount member
+ * @return Total
+ * @throws std::overflow_error if the sum exceeds 64 bits
+ */
+template<typename Range>
+amount_t sum_amounts(const Range& items) {
+    constexpr size_t CHUNK_SIZE = 64;
+    amount_t chunk[CHUNK_SIZE];
+    size_t count = 0;
+    amount_t total = 0;
+    for (const auto& item : items) {
+        chunk[count++] = item.amount;
+        if (count == CHUNK_SIZE) {
+            total = checked_add(total, checked_sum(chunk, count));
+            count = 0;
+        }
+    }
+    return checked_add(total, checked_sum(chunk, count));
+}
+
+/**
+ * @brief Parse decimal amount string (database and JSON representation)
+ * @param str Decimal digits
+ * @return Parsed amount
+ * @throws std::invalid_argument if str is not a non-negative integer below 2^64
+ */
+amount_t parse_amount(const std::string& str);
+
+} // namespace cashu::core
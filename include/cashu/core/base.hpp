@@ -4,19 +4,24 @@
 // Core base classes and data structures for Cashu protocol
 // 100% compatible with nutshell Proof, DLEQ, Amount, Unit, BlindedMessage, BlindedSignature classes
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <memory>
 #include <variant>
 #include <unordered_map>
-#include <boost/multiprecision/cpp_int.hpp>
 
+#include "cashu/core/amount.hpp"
+#include "cashu/core/json_writer.hpp"
+#include "cashu/core/keyset_interner.hpp"
+#include "cashu/core/secret.hpp"
 #include "cashu/core/settings.hpp"
 #include "cashu/core/crypto/secp.hpp"
 
 namespace cashu::core::base {
-    using namespace boost::multiprecision;
 
 // Forward declarations
 class Proof;
@@ -25,6 +30,41 @@ class BlindedSignature;
 class MintQuote;
 class MeltQuote;
 
+/**
+ * @brief Compressed secp256k1 point (33 bytes)
+ */
+using Point33 = std::array<uint8_t, 33>;
+
+/**
+ * @brief Decode a compressed point from hex
+ * The bytes are not checked to be on the curve
+ * @param hex 66 hex digits
+ * @param field Field name for the error message
+ * @return Point bytes
+ * @throws std::invalid_argument if hex is not 33 bytes of hex
+ */
+Point33 point_from_hex(std::string_view hex, const char* field = "point");
+
+/**
+ * @brief Decode a compressed point from hex without throwing
+ * @param hex 66 hex digits
+ * @param point Destination (unspecified on failure)
+ * @return False if hex is not 33 bytes of hex
+ */
+bool try_point_from_hex(std::string_view hex, Point33& point) noexcept;
+
+/**
+ * @brief Encode a compressed point as lowercase hex
+ */
+std::string point_to_hex(const Point33& point);
+
+/**
+ * @brief Y = hash_to_curve(secret) as compressed point (matches nutshell proof.Y)
+ * @param secret Proof secret
+ * @return Compressed point
+ */
+Point33 hash_to_curve_Y(std::string_view secret);
+
 /**
  * Discrete Log Equality (DLEQ) Proof
  * NUTSHELL COMPATIBILITY: Matches DLEQ class in nutshell base.py exactly
@@ -39,6 +79,7 @@ public:
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static DLEQ from_json(const std::string& json);
 };
 
@@ -57,6 +98,7 @@ public:
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static DLEQWallet from_json(const std::string& json);
 };
 
@@ -96,6 +138,7 @@ public:
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static ProofState from_json(const std::string& json);
 };
 
@@ -110,11 +153,15 @@ public:
     std::optional<std::string> preimage;
     std::optional<std::vector<std::string>> signatures;
     
-    // Factory method
+    /**
+     * @brief Parse witness JSON {"preimage": str?, "signatures": [str]?}
+     * @throws std::invalid_argument if the witness is not such an object
+     */
     static HTLCWitness from_witness(const std::string& witness);
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
 };
 
 /**
@@ -128,11 +175,25 @@ public:
     
     std::vector<std::string> signatures;
     
-    // Factory method
+    /**
+     * @brief Parse witness JSON {"signatures": [str]}
+     * @throws std::invalid_argument if the witness is not such an object
+     */
     static P2PKWitness from_witness(const std::string& witness);
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
+};
+
+/**
+ * Field subsets emitted when serializing a Proof
+ * NUTSHELL COMPATIBILITY: Proof.to_dict(include_dleq=True), to_dict_no_dleq(), to_dict_no_secret()
+ */
+enum class ProofProjection : uint8_t {
+    WITH_DLEQ,   // id, amount, secret, C, dleq?, witness?
+    NO_DLEQ,     // id, amount, secret, C, witness?
+    NO_SECRET    // id, amount, C
 };
 
 /**
@@ -143,13 +204,12 @@ public:
 class Proof {
 public:
     Proof() = default;
-    Proof(const std::string& id, const cpp_int& amount, const std::string& secret, const std::string& C);
+    Proof(const std::string& id, amount_t amount, const std::string& secret, const std::string& C);
+    Proof(KeysetHandle keyset, amount_t amount, const std::string& secret, const std::string& C);
     
-    // Core fields (match nutshell Proof exactly)
-    std::string id = "";           // keyset id
-    cpp_int amount = 0;            // token amount
+    // Core fields (match nutshell Proof exactly; keyset id via id()/set_id())
+    amount_t amount = 0;           // token amount
     std::string secret = "";       // secret message to be blinded
-    std::string Y = "";            // hash_to_curve(secret) - computed automatically
     std::string C = "";            // signature on secret, unblinded by wallet
     std::optional<DLEQWallet> dleq;  // DLEQ proof
     std::optional<std::string> witness;  // witness for spending condition
@@ -164,21 +224,173 @@ public:
     std::optional<std::string> melt_id;   // melt operation id
     
     // Factory method (matches nutshell)
-    static Proof from_dict(const std::unordered_map<std::string, std::variant<std::string, cpp_int, bool>>& proof_dict);
+    static Proof from_dict(const std::unordered_map<std::string, std::variant<std::string, amount_t, bool>>& proof_dict);
     
     // Serialization methods (match nutshell exactly)
-    std::unordered_map<std::string, std::variant<std::string, cpp_int, bool>> to_dict(bool include_dleq = false) const;
+    // to_dict() builds a hash map per proof; prefer visit()/write_json() on hot paths.
+    // With include_dleq the DLEQ proof is stored as its JSON object string.
+    std::unordered_map<std::string, std::variant<std::string, amount_t, bool>> to_dict(bool include_dleq = false) const;
     std::string to_base64() const;
-    std::unordered_map<std::string, std::variant<std::string, cpp_int, bool>> to_dict_no_dleq() const;
-    std::unordered_map<std::string, std::variant<std::string, cpp_int, bool>> to_dict_no_secret() const;
+    std::unordered_map<std::string, std::variant<std::string, amount_t, bool>> to_dict_no_dleq() const;
+    std::unordered_map<std::string, std::variant<std::string, amount_t, bool>> to_dict_no_secret() const;
+    
+    /**
+     * @brief Visit serialized fields in nutshell order without copying
+     *
+     * visitor is called as visitor(std::string_view key, value) where value is
+     * std::string_view, amount_t or const DLEQWallet& (for "dleq").
+     *
+     * @param visitor Field visitor
+     * @param projection Fields to emit
+     */
+    template<typename Visitor>
+    void visit(Visitor&& visitor, ProofProjection projection = ProofProjection::NO_DLEQ) const {
+        visitor(std::string_view("id"), std::string_view(id()));
+        visitor(std::string_view("amount"), amount);
+        if (projection != ProofProjection::NO_SECRET) {
+            visitor(std::string_view("secret"), std::string_view(secret));
+        }
+        visitor(std::string_view("C"), std::string_view(C));
+        if (projection == ProofProjection::NO_SECRET) {
+            return;
+        }
+        if (projection == ProofProjection::WITH_DLEQ && dleq.has_value()) {
+            visitor(std::string_view("dleq"), dleq.value());
+        }
+        if (witness.has_value()) {
+            visitor(std::string_view("witness"), std::string_view(witness.value()));
+        }
+    }
+    
+    /**
+     * @brief Serialize projection as a JSON object
+     * @param projection Fields to emit
+     * @return JSON object string
+     */
+    std::string to_json(ProofProjection projection = ProofProjection::NO_DLEQ) const;
+    
+    /**
+     * @brief Append projection as a JSON object
+     * @param writer Destination writer
+     * @param projection Fields to emit
+     */
+    void write_json(JsonWriter& writer, ProofProjection projection = ProofProjection::NO_DLEQ) const;
+    
+    /**
+     * @brief Keyset id
+     * @return Interned id, or the stored string for a keyset never interned
+     */
+    const std::string& id() const { return keyset_.valid() ? KeysetInterner::global().id(keyset_) : id_; }
+    
+    /**
+     * @brief Set the keyset id and resolve its handle
+     *
+     * Uses find(), never intern(), so untrusted input cannot fill the interner.
+     *
+     * @param id Keyset ID
+     */
+    void set_id(std::string_view id);
+    
+    /**
+     * @brief Handle of the keyset id (see KeysetInterner::global())
+     * @return Handle resolved when the id was set, or an invalid handle if the
+     *         keyset was not interned then
+     */
+    KeysetHandle keyset_handle() const { return keyset_; }
     
     // Witness parsing properties (match nutshell)
+    // Read from the cached parsed witness; empty if the witness is malformed.
     std::vector<std::string> p2pksigs() const;
     std::optional<std::string> htlcpreimage() const;
     std::optional<std::vector<std::string>> htlcsigs() const;
     
+    // ---- Spending conditions (NUT-10/11/14) ----
+    // PERFORMANCE: The well-known secret and the witness JSON are parsed on
+    // first access and cached together. Like Y, the cache is not synchronized;
+    // call invalidate_conditions() after changing secret or witness.
+    
+    /**
+     * @brief Parsed NUT-10 secret
+     * @return Secret, or nullptr if secret is not a well-known secret of a known kind
+     */
+    const secret::Secret* nut10_secret() const;
+    
+    /**
+     * @brief Error decoding the spending-condition tags of the NUT-10 secret
+     * @return Error message, or nullptr if the tags are valid or the secret is plain;
+     *         while set, the condition fields of nut10_secret() are not meaningful
+     */
+    const std::string* secret_error() const;
+    
+    /**
+     * @brief Parsed witness (signatures and preimage)
+     * @return Witness; empty if witness is absent or malformed
+     */
+    const HTLCWitness& parsed_witness() const;
+    
+    /**
+     * @brief Drop cached secret and witness parses
+     */
+    void invalidate_conditions() { conditions_.reset(); }
+    
+    // ---- Y = hash_to_curve(secret) ----
+    // PERFORMANCE: Y is computed on first access and cached as compressed
+    // point bytes, so amount-only users (sum_proofs, balances) never hash.
+    // The cache is not synchronized; use compute_Y_batch() before sharing
+    // proofs across threads, and invalidate_Y() after changing secret.
+    
+    /**
+     * @brief Y as hex (matches nutshell proof.Y)
+     * @return Compressed point hex, or "" if secret is empty and Y was never set
+     */
+    std::string Y() const;
+    
+    /**
+     * @brief Y as compressed point bytes
+     * @return 33-byte compressed point
+     * @throws std::runtime_error if secret is empty and Y was never set
+     */
+    const std::array<uint8_t, 33>& Y_bytes() const;
+    
+    /**
+     * @brief Set Y from storage (e.g. ProofUsed.y) instead of hashing
+     * @param Y_hex Compressed point hex (66 characters)
+     * @throws std::invalid_argument if Y_hex is not 33 bytes of hex
+     */
+    void set_Y(const std::string& Y_hex);
+    
+    /**
+     * @brief Set Y from stored compressed point bytes
+     * @param Y_bytes 33-byte compressed point
+     */
+    void set_Y(const std::array<uint8_t, 33>& Y_bytes);
+    
+    /**
+     * @brief Check if Y is already computed or set
+     */
+    bool has_Y() const { return Y_.has_value(); }
+    
+    /**
+     * @brief Drop cached Y (call after modifying secret)
+     */
+    void invalidate_Y() { Y_.reset(); }
+    
+    /**
+     * @brief Compute Y for all proofs that do not have it yet, in parallel
+     * @param proofs Proofs to fill
+     */
+    static void compute_Y_batch(std::vector<Proof>& proofs);
+    
 private:
-    void compute_Y();  // Compute Y = hash_to_curve(secret) using nutshell method
+    struct ConditionCache;
+    
+    KeysetHandle keyset_;  // Authoritative keyset id when valid
+    std::string id_;       // Keyset id, kept only while keyset_ is invalid
+    mutable std::optional<std::array<uint8_t, 33>> Y_;  // Cached compressed Y
+    mutable std::shared_ptr<const ConditionCache> conditions_;  // Cached secret/witness parses
+    
+    const ConditionCache& conditions() const;
+    void compute_Y() const;  // Compute Y = hash_to_curve(secret) using nutshell method
 };
 
 /**
@@ -200,13 +412,15 @@ Unit unit_from_string(const std::string& str);
 /**
  * Amount class with unit conversion
  * NUTSHELL COMPATIBILITY: Matches Amount class in nutshell base.py exactly
+ * Arithmetic is checked: results outside [0, 2^64) throw std::overflow_error
+ * or std::underflow_error instead of wrapping.
  */
 class Amount {
 public:
-    Amount(Unit unit, const cpp_int& amount);
+    Amount(Unit unit, amount_t amount);
     
     Unit unit;
-    cpp_int amount;
+    amount_t amount;
     
     // Unit conversion (matches nutshell exactly)
     Amount to(Unit to_unit, const std::optional<std::string>& round = std::nullopt) const;
@@ -288,15 +502,42 @@ MintQuoteState mint_quote_state_from_string(const std::string& str);
 class BlindedMessage {
 public:
     BlindedMessage() = default;
-    BlindedMessage(const cpp_int& amount, const std::string& id, const std::string& B_);
+    BlindedMessage(amount_t amount, const std::string& id, const std::string& B_);
+    BlindedMessage(amount_t amount, KeysetHandle keyset, const std::string& B_);
     
-    cpp_int amount;        // token amount
-    std::string id;        // keyset id
+    amount_t amount = 0;   // token amount
     std::string B_;        // hex-encoded blinded message
     
+    /**
+     * @brief Keyset id
+     * @return Interned id, or the stored string for a keyset never interned
+     */
+    const std::string& id() const { return keyset_.valid() ? KeysetInterner::global().id(keyset_) : id_; }
+    
+    /**
+     * @brief Set the keyset id and resolve its handle
+     *
+     * Uses find(), never intern(), so untrusted input cannot fill the interner.
+     *
+     * @param id Keyset ID
+     */
+    void set_id(std::string_view id);
+    
+    /**
+     * @brief Handle of the keyset id (see KeysetInterner::global())
+     * @return Handle resolved when the id was set, or an invalid handle if the
+     *         keyset was not interned then
+     */
+    KeysetHandle keyset_handle() const { return keyset_; }
+    
     // Serialization (matches nutshell)
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static BlindedMessage from_json(const std::string& json);
+    
+private:
+    KeysetHandle keyset_;  // Authoritative keyset id when valid
+    std::string id_;       // Keyset id, kept only while keyset_ is invalid
 };
 
 /**
@@ -306,18 +547,84 @@ public:
 class BlindedSignature {
 public:
     BlindedSignature() = default;
-    BlindedSignature(const std::string& id, const cpp_int& amount, const std::string& C_, const std::optional<DLEQ>& dleq = std::nullopt);
+    BlindedSignature(const std::string& id, amount_t amount, const std::string& C_, const std::optional<DLEQ>& dleq = std::nullopt);
+    BlindedSignature(KeysetHandle keyset, amount_t amount, const std::string& C_, const std::optional<DLEQ>& dleq = std::nullopt);
     
-    std::string id;     // keyset id
-    cpp_int amount;     // token amount
+    amount_t amount = 0; // token amount
     std::string C_;     // hex-encoded signature
     std::optional<DLEQ> dleq;  // DLEQ proof
     
+    /**
+     * @brief Keyset id
+     * @return Interned id, or the stored string for a keyset never interned
+     */
+    const std::string& id() const { return keyset_.valid() ? KeysetInterner::global().id(keyset_) : id_; }
+    
+    /**
+     * @brief Set the keyset id and resolve its handle
+     *
+     * Uses find(), never intern(), so untrusted input cannot fill the interner.
+     *
+     * @param id Keyset ID
+     */
+    void set_id(std::string_view id);
+    
+    /**
+     * @brief Handle of the keyset id (see KeysetInterner::global())
+     * @return Handle resolved when the id was set, or an invalid handle if the
+     *         keyset was not interned then
+     */
+    KeysetHandle keyset_handle() const { return keyset_; }
+    
     // Serialization (matches nutshell)
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static BlindedSignature from_json(const std::string& json);
+    
+private:
+    KeysetHandle keyset_;  // Authoritative keyset id when valid
+    std::string id_;       // Keyset id, kept only while keyset_ is invalid
 };
 
+// The write_json_array() overloads take a pointer and count, so they accept
+// vectors, batches and sub-ranges alike.
+
+/**
+ * @brief Serialize proofs as one JSON array in a single pass
+ * @param writer Destination writer
+ * @param proofs First proof
+ * @param count Number of proofs
+ * @param projection Fields to emit per proof
+ */
+void write_json_array(JsonWriter& writer, const Proof* proofs, size_t count,
+                      ProofProjection projection = ProofProjection::NO_DLEQ);
+
+/**
+ * @brief Serialize blinded messages as one JSON array in a single pass
+ * @param writer Destination writer
+ * @param messages First message
+ * @param count Number of messages
+ */
+void write_json_array(JsonWriter& writer, const BlindedMessage* messages, size_t count);
+
+/**
+ * @brief Serialize blinded signatures as one JSON array in a single pass
+ * @param writer Destination writer
+ * @param signatures First signature
+ * @param count Number of signatures
+ */
+void write_json_array(JsonWriter& writer, const BlindedSignature* signatures, size_t count);
+
+/**
+ * @brief Write a swap/mint response body {"signatures":[...]} into out
+ *
+ * out is cleared first; pass the same buffer across requests to reuse its capacity.
+ *
+ * @param out Output buffer
+ * @param signatures Signatures to serialize
+ */
+void write_signatures_response(std::string& out, const std::vector<BlindedSignature>& signatures);
+
 /**
  * Melt quote for Lightning payments
  * NUTSHELL COMPATIBILITY: Matches MeltQuote class in nutshell base.py exactly
@@ -331,7 +638,7 @@ public:
     std::string request;
     std::string checking_id;
     std::string unit;
-    cpp_int amount;
+    amount_t amount = 0;
     int fee_reserve;
     MeltQuoteState state;
     std::optional<int> created_time;
@@ -350,6 +657,7 @@ public:
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static MeltQuote from_json(const std::string& json);
 };
 
@@ -366,7 +674,7 @@ public:
     std::string request;
     std::string checking_id;
     std::string unit;
-    cpp_int amount;
+    amount_t amount = 0;
     MintQuoteState state;
     std::optional<int> created_time;
     std::optional<int> paid_time;
@@ -383,6 +691,7 @@ public:
     
     // Serialization
     std::string to_json() const;
+    void write_json(JsonWriter& writer) const;
     static MintQuote from_json(const std::string& json);
 };
 
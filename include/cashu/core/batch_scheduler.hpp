@@ -0,0 +1,388 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: Ledger._generate_promises and Ledger._verify_proofs in cashu/mint/ledger.py
+// Adaptive micro-batching of signing and verification - ENHANCEMENT beyond nutshell
+// Jobs from concurrent requests are grouped per keyset so one kernel call
+// amortizes key lookup and task dispatch over many outputs or inputs. While
+// the pool has spare batch slots, jobs are dispatched at once (no added
+// latency); once max_in_flight batches are running, jobs accumulate until
+// the batch fills, a running batch finishes, or the window expires, so the
+// added latency is bounded by the window and only paid under load.
+
+#include "cashu/core/base.hpp"
+#include "cashu/core/crypto/denominations.hpp"
+#include "cashu/core/crypto/secp.hpp"
+#include "cashu/core/keyset_interner.hpp"
+#include "cashu/core/proof_batch.hpp"
+#include "cashu/core/settings.hpp"
+#include "cashu/core/task.hpp"
+#include "cashu/core/thread_pool.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cashu::core {
+
+/**
+ * @brief Batching limits
+ */
+struct BatchingOptions {
+    std::chrono::microseconds window{200};  // Longest a job waits for its batch to fill; 0 never waits
+    size_t max_batch_size = 256;            // Batches are dispatched when they reach this size
+    size_t max_in_flight = 0;               // Running batches before jobs start waiting; 0 = pool size
+
+    /**
+     * @brief Derive options from mint settings (mint_batch_window_us, mint_batch_max_size)
+     * @param settings Mint settings
+     * @return Batching options
+     */
+    static BatchingOptions from_settings(const settings::MintSettings& settings);
+
+    /**
+     * @brief Derive options from the published settings (see current_settings())
+     *
+     * Schedulers copy their options when constructed; a reload applies to
+     * schedulers created afterwards.
+     *
+     * @return Batching options
+     */
+    static BatchingOptions current();
+};
+
+/**
+ * @brief Collects jobs into per-keyset batches and runs them on the pool
+ *
+ * The kernel is called once per batch with all jobs of one keyset and fills
+ * results[i], or errors[i] to fail a single job; if it throws, every job of
+ * the batch fails with that exception. Each job's future completes on its own.
+ *
+ * @tparam Job Job description (movable)
+ * @tparam Result Result type (default constructible, movable)
+ */
+template<typename Job, typename Result>
+class MicroBatcher {
+public:
+    using Kernel = std::function<void(KeysetHandle keyset, const Job* jobs, size_t count,
+                                      Result* results, std::exception_ptr* errors)>;
+
+    /**
+     * @param kernel Batch kernel
+     * @param options Batching limits (default: BatchingOptions::current())
+     * @param pool Pool running the batches
+     */
+    explicit MicroBatcher(Kernel kernel, const BatchingOptions& options = BatchingOptions::current(),
+                          ThreadPool& pool = ThreadPool::global())
+        : state_(std::make_shared<State>(std::move(kernel), options, pool)) {}
+
+    /**
+     * @brief Dispatch waiting jobs and wait for all running batches
+     *
+     * On a pool worker, runs queued pool tasks while waiting, like
+     * ThreadPool::wait(), since the batches may be queued behind it.
+     */
+    ~MicroBatcher() {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        while (!state_->open.empty()) {
+            State::dispatch(state_, 0, lock);
+        }
+        if (!state_->pool.in_worker()) {
+            state_->idle_cv.wait(lock, [this]() { return state_->in_flight == 0; });
+            return;
+        }
+        while (state_->in_flight != 0) {
+            lock.unlock();
+            bool ran = state_->pool.run_pending_task();
+            lock.lock();
+            if (!ran && state_->in_flight != 0) {
+                state_->idle_cv.wait_for(lock, std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    MicroBatcher(const MicroBatcher&) = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    /**
+     * @brief Queue a job
+     * @param keyset Keyset the job belongs to
+     * @param job Job
+     * @return Future receiving the job's result or error
+     */
+    std::future<Result> submit(KeysetHandle keyset, Job job) {
+        std::future<Result> future;
+        bool start_timer = false;
+        uint64_t generation = 0;
+        {
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            size_t index = state_->open.size();
+            for (size_t i = 0; i < state_->open.size(); ++i) {
+                if (state_->open[i].keyset == keyset) {
+                    index = i;
+                    break;
+                }
+            }
+            if (index == state_->open.size()) {
+                state_->open.push_back(Batch{keyset, {}, {}, state_->next_generation++});
+                start_timer = true;
+            }
+            Batch& batch = state_->open[index];
+            batch.jobs.push_back(std::move(job));
+            batch.promises.emplace_back();
+            future = batch.promises.back().get_future();
+            ++state_->queued;
+            generation = batch.generation;
+
+            const BatchingOptions& options = state_->options;
+            if (batch.jobs.size() >= options.max_batch_size ||
+                state_->in_flight < state_->max_in_flight ||
+                options.window.count() == 0) {
+                State::dispatch(state_, index, lock);
+                start_timer = false;
+            }
+        }
+        if (start_timer) {
+            // Bound the wait of the first job; later jobs ride along
+            std::weak_ptr<State> weak = state_;
+            TimerQueue::global().schedule(TimerQueue::clock::now() + state_->options.window,
+                                          [weak, keyset, generation]() {
+                if (auto state = weak.lock()) {
+                    State::expire(state, keyset, generation);
+                }
+            });
+        }
+        return future;
+    }
+
+    /**
+     * @brief Dispatch all waiting jobs now
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        while (!state_->open.empty()) {
+            State::dispatch(state_, 0, lock);
+        }
+    }
+
+    /**
+     * @brief Number of jobs waiting for dispatch
+     */
+    size_t queued() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->queued;
+    }
+
+    /**
+     * @brief Number of batches running
+     */
+    size_t in_flight() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->in_flight;
+    }
+
+private:
+    struct Batch {
+        KeysetHandle keyset;
+        std::vector<Job> jobs;
+        std::vector<std::promise<Result>> promises;
+        uint64_t generation = 0;  // Distinguishes successive batches of one keyset
+    };
+
+    // Shared with pool tasks (strongly) and timers (weakly)
+    struct State {
+        State(Kernel kernel, const BatchingOptions& options, ThreadPool& pool)
+            : kernel(std::move(kernel)), options(options), pool(pool),
+              max_in_flight(options.max_in_flight != 0 ? options.max_in_flight : pool.size()) {
+            if (this->options.max_batch_size == 0) {
+                this->options.max_batch_size = 1;
+            }
+        }
+
+        Kernel kernel;
+        BatchingOptions options;
+        ThreadPool& pool;
+        size_t max_in_flight;
+
+        mutable std::mutex mutex;
+        std::condition_variable idle_cv;
+        std::vector<Batch> open;  // Waiting batches, oldest first, one per keyset
+        size_t queued = 0;
+        size_t in_flight = 0;
+        uint64_t next_generation = 0;
+
+        // Move open[index] to the pool (lock held)
+        static void dispatch(const std::shared_ptr<State>& state, size_t index,
+                             std::unique_lock<std::mutex>& /*lock*/) {
+            auto batch = std::make_shared<Batch>(std::move(state->open[index]));
+            state->open.erase(state->open.begin() + static_cast<std::ptrdiff_t>(index));
+            state->queued -= batch->jobs.size();
+            ++state->in_flight;
+            state->pool.post([state, batch]() { run(state, *batch); });
+        }
+
+        // Window of a batch expired; dispatch it if still waiting
+        static void expire(const std::shared_ptr<State>& state, KeysetHandle keyset, uint64_t generation) {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            for (size_t i = 0; i < state->open.size(); ++i) {
+                if (state->open[i].keyset == keyset && state->open[i].generation == generation) {
+                    dispatch(state, i, lock);
+                    return;
+                }
+            }
+        }
+
+        static void run(const std::shared_ptr<State>& state, Batch& batch) {
+            size_t count = batch.jobs.size();
+            // Not std::vector, whose bool specialization has no data()
+            std::unique_ptr<Result[]> results(new Result[count]());
+            std::vector<std::exception_ptr> errors(count);
+            try {
+                state->kernel(batch.keyset, batch.jobs.data(), count, results.get(), errors.data());
+            } catch (...) {
+                std::exception_ptr error = std::current_exception();
+                for (auto& e : errors) {
+                    e = error;
+                }
+            }
+            for (size_t i = 0; i < count; ++i) {
+                if (errors[i]) {
+                    batch.promises[i].set_exception(errors[i]);
+                } else {
+                    batch.promises[i].set_value(std::move(results[i]));
+                }
+            }
+
+            // Work-conserving: a finished batch frees a slot for the oldest waiting one
+            std::unique_lock<std::mutex> lock(state->mutex);
+            --state->in_flight;
+            if (!state->open.empty() && state->in_flight < state->max_in_flight) {
+                dispatch(state, 0, lock);
+            }
+            if (state->in_flight == 0) {
+                state->idle_cv.notify_all();
+            }
+        }
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Private keys of one keyset by amount
+ */
+using KeysetPrivateKeys = crypto::DenominationTable<crypto::PrivateKey>;
+
+/**
+ * @brief Resolves a keyset to its private keys; returns nullptr if unknown
+ *
+ * Called once per batch; the table must stay valid while the batch runs.
+ */
+using KeyProvider = std::function<const KeysetPrivateKeys*(KeysetHandle)>;
+
+/**
+ * @brief One output to sign
+ */
+struct SignJob {
+    amount_t amount = 0;
+    base::Point33 B_{};
+};
+
+/**
+ * @brief One input to verify
+ */
+struct VerifyJob {
+    amount_t amount = 0;
+    std::string secret;
+    base::Point33 C{};
+};
+
+/**
+ * @brief Batched BDHKE signing with DLEQ proofs (C_ = a*B_)
+ * NUTSHELL COMPATIBILITY: Same signatures as Ledger._generate_promises
+ */
+class SigningScheduler {
+public:
+    /**
+     * @param keys Keyset private key provider
+     * @param options Batching limits (default: BatchingOptions::current())
+     * @param pool Pool running the batches
+     */
+    explicit SigningScheduler(KeyProvider keys,
+                              const BatchingOptions& options = BatchingOptions::current(),
+                              ThreadPool& pool = ThreadPool::global());
+
+    /**
+     * @brief Queue one output for signing
+     * @return Future of the signature; fails with KeysetNotFoundError for an
+     *         unknown keyset or std::invalid_argument for a missing amount or invalid B_
+     */
+    std::future<base::BlindedSignature> sign(KeysetHandle keyset, amount_t amount, const base::Point33& B_);
+
+    /**
+     * @brief Queue one output for signing
+     * @throws KeysetNotFoundError if the keyset id was never interned
+     * @throws std::invalid_argument if B_ is not a 33-byte compressed point hex
+     */
+    std::future<base::BlindedSignature> sign(const base::BlindedMessage& output);
+
+    /**
+     * @brief Queue all outputs of a batch, in order
+     */
+    std::vector<std::future<base::BlindedSignature>> sign(const base::BlindedMessageBatch& outputs);
+
+    void flush() { batcher_.flush(); }
+
+private:
+    MicroBatcher<SignJob, base::BlindedSignature> batcher_;
+};
+
+/**
+ * @brief Batched proof verification (C == a*hash_to_curve(secret))
+ * NUTSHELL COMPATIBILITY: Same check as Ledger._verify_proof_bdhke
+ */
+class VerificationScheduler {
+public:
+    /**
+     * @param keys Keyset private key provider
+     * @param options Batching limits (default: BatchingOptions::current())
+     * @param pool Pool running the batches
+     */
+    explicit VerificationScheduler(KeyProvider keys,
+                                   const BatchingOptions& options = BatchingOptions::current(),
+                                   ThreadPool& pool = ThreadPool::global());
+
+    /**
+     * @brief Queue one input for verification
+     * @return Future of the result (false for an invalid signature); fails with
+     *         KeysetNotFoundError for an unknown keyset or std::invalid_argument
+     *         for a missing amount or invalid C
+     */
+    std::future<bool> verify(KeysetHandle keyset, amount_t amount, std::string secret, const base::Point33& C);
+
+    /**
+     * @brief Queue one input for verification
+     * @throws KeysetNotFoundError if the keyset id was never interned
+     * @throws std::invalid_argument if C is not a 33-byte compressed point hex
+     */
+    std::future<bool> verify(const base::Proof& proof);
+
+    /**
+     * @brief Queue all inputs of a batch, in order
+     */
+    std::vector<std::future<bool>> verify(const base::ProofBatch& proofs);
+
+    void flush() { batcher_.flush(); }
+
+private:
+    MicroBatcher<VerifyJob, bool> batcher_;
+};
+
+} // namespace cashu::core
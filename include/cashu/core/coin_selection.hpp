@@ -0,0 +1,203 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: WalletTransactions._select_proofs_to_send and split_wallet_state
+// in cashu/wallet/transactions.py
+// Bucketed proof selection - ENHANCEMENT beyond nutshell
+// Nutshell sorts and scans every proof of the wallet on each send. Unreserved
+// proofs are kept here in one bucket per (keyset, power-of-two denomination),
+// with per-denomination counts across keysets, so selection and output
+// planning cost O(denominations) plus the size of the result.
+
+#include "cashu/core/base.hpp"
+#include "cashu/core/crypto/denominations.hpp"
+#include "cashu/core/keyset_interner.hpp"
+#include "cashu/core/models.hpp"
+#include "cashu/core/settings.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cashu::core {
+
+/**
+ * @brief Stable reference to a proof held by a ProofSelector
+ */
+using ProofId = uint32_t;
+
+/**
+ * @brief Proofs chosen for a send
+ */
+struct ProofSelection {
+    std::vector<ProofId> proofs;
+    amount_t amount = 0;      // Sum of the selected proofs
+    amount_t fee = 0;         // Input fee of the selected proofs (0 without include_fees)
+};
+
+/**
+ * @brief Wallet proof store with denomination-bucketed selection
+ *
+ * Holds the proofs of one mint and unit. Reserved proofs (pending sends) stay
+ * in the store but are not selectable and do not count towards the balance.
+ * Not thread-safe.
+ */
+class ProofSelector {
+public:
+    /**
+     * @param target_amount_count Proofs per denomination plan_outputs() aims to keep
+     * @param max_inputs Most proofs a selection may use; 0 for no limit
+     */
+    explicit ProofSelector(size_t target_amount_count = 3, size_t max_inputs = 0);
+
+    /**
+     * @brief Create from wallet settings (wallet_target_amount_count), without an input limit
+     * @param settings Wallet settings
+     * @return Empty selector
+     */
+    static ProofSelector from_settings(const settings::WalletSettings& settings);
+
+    /**
+     * @brief Set the input fee of a keyset (default 0)
+     * @param keyset Keyset handle
+     * @param fee_ppk Fee per proof in parts per thousand of one unit
+     */
+    void set_input_fee_ppk(KeysetHandle keyset, uint32_t fee_ppk);
+
+    /**
+     * @brief Set the input fee of a keyset from its wallet record
+     * @param keyset Wallet keyset
+     * @throws std::invalid_argument if the keyset has no id or a negative fee
+     */
+    void set_input_fee_ppk(const models::WalletKeyset& keyset);
+
+    /**
+     * @brief Add a proof; proof.reserved decides whether it is selectable
+     * @param proof Proof
+     * @return Id of the proof
+     * @throws std::invalid_argument if the amount is not a power of two
+     * @throws std::overflow_error if the balance would exceed 64 bits
+     */
+    ProofId add(base::Proof proof);
+
+    /**
+     * @brief Remove a proof (e.g. once spent)
+     * @param id Proof id; invalid afterwards and may be reused by add()
+     */
+    void remove(ProofId id);
+
+    /**
+     * @brief Mark a proof reserved (not selectable) or unreserved
+     * @param id Proof id
+     * @param reserved New state
+     */
+    void set_reserved(ProofId id, bool reserved);
+
+    /**
+     * @brief Reserve every proof of a selection
+     * @param selection Result of select()
+     */
+    void reserve(const ProofSelection& selection);
+
+    /**
+     * @brief Proof for an id
+     * @param id Proof id
+     * @return Proof, with reserved reflecting the selector's state
+     */
+    const base::Proof& proof(ProofId id) const { return entries_[id].proof; }
+
+    /**
+     * @brief Copy the proofs of a selection
+     * @param selection Result of select()
+     * @return Proofs in selection order
+     */
+    std::vector<base::Proof> proofs(const ProofSelection& selection) const;
+
+    /**
+     * @brief Sum of unreserved proofs
+     */
+    amount_t balance() const noexcept { return balance_; }
+
+    /**
+     * @brief Number of unreserved proofs of a denomination
+     * @param denomination Power-of-two amount
+     */
+    size_t count(amount_t denomination) const;
+
+    /**
+     * @brief Number of stored proofs, reserved or not
+     */
+    size_t size() const noexcept { return entries_.size() - free_.size(); }
+
+    /**
+     * @brief Input fee of a set of proofs: ceil(sum of input_fee_ppk / 1000)
+     * NUTSHELL COMPATIBILITY: Matches get_fees_for_proofs()
+     * @param ids Proof ids
+     * @return Fee in units
+     */
+    amount_t fee(const std::vector<ProofId>& ids) const;
+
+    /**
+     * @brief Select unreserved proofs worth at least amount (plus their fee)
+     *
+     * Takes the largest denominations that fit, which finds an exact match
+     * whenever one exists. Otherwise the change is less than the denomination
+     * that completes the selection, or a single larger proof is used if that
+     * leaves no more change. Within a denomination, proofs of the keyset with
+     * the lowest input fee are used first. Does not reserve the proofs.
+     *
+     * @param amount Amount to send
+     * @param include_fees Whether the selection must also cover its input fee
+     * @return Selection
+     * @throws std::runtime_error if the balance is too low or more than
+     *         max_inputs proofs would be needed
+     */
+    ProofSelection select(amount_t amount, bool include_fees = true) const;
+
+    /**
+     * @brief Output amounts for receiving amount that refill short denominations
+     * NUTSHELL COMPATIBILITY: Matches split_wallet_state()
+     *
+     * Adds proofs of each denomination, smallest first, until the wallet holds
+     * target_amount_count of it or the amount runs out; the rest is split into
+     * powers of two.
+     *
+     * @param amount Amount to receive
+     * @return Output amounts in ascending order
+     */
+    std::vector<amount_t> plan_outputs(amount_t amount) const;
+
+private:
+    static constexpr size_t DENOMINATIONS = crypto::MAX_DENOMINATIONS;
+    static constexpr uint32_t NOT_IN_BUCKET = UINT32_MAX;
+
+    struct Entry {
+        base::Proof proof;
+        uint16_t keyset = 0;               // Index into keysets_
+        uint8_t denomination = 0;          // log2(amount)
+        bool live = false;
+        uint32_t position = NOT_IN_BUCKET; // Index in its bucket while unreserved
+    };
+
+    struct Keyset {
+        KeysetHandle handle;
+        uint32_t fee_ppk = 0;
+        std::array<std::vector<ProofId>, DENOMINATIONS> buckets;
+    };
+
+    size_t target_amount_count_;
+    size_t max_inputs_;
+    std::vector<Entry> entries_;
+    std::vector<ProofId> free_;                  // Ids of removed entries
+    std::vector<Keyset> keysets_;
+    std::vector<uint16_t> by_fee_;               // keysets_ indices, cheapest first
+    std::array<size_t, DENOMINATIONS> counts_{}; // Unreserved proofs per denomination
+    amount_t balance_ = 0;
+
+    uint16_t keyset_index(KeysetHandle handle);
+    void insert_bucket(ProofId id);
+    void erase_bucket(ProofId id);
+    void plan(amount_t target, std::array<size_t, DENOMINATIONS>& take) const;
+    uint64_t plan_fee_ppk(const std::array<size_t, DENOMINATIONS>& take) const;
+};
+
+} // namespace cashu::core
@@ -4,10 +4,15 @@
 // AES-256-CBC encryption compatible with crypto-js and nutshell exactly
 // 100% compatible key derivation, padding, and encoding
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <boost/multiprecision/cpp_int.hpp>
 
+struct evp_cipher_ctx_st;
+
 namespace cashu::core::crypto {
     using namespace boost::multiprecision;
 
@@ -27,9 +32,111 @@ namespace cashu::core::crypto {
  *   import Utf8 from "crypto-js/enc-utf8.js";
  *   AES.encrypt(decrypted, password).toString()
  *   AES.decrypt(encrypted, password).toString(Utf8);
+ * 
+ * PERFORMANCE: one-shot encrypt/decrypt reuse a cipher context per thread,
+ * and key/IV derivations for decryption are memoized per salt (shared
+ * between copies of the cipher); encryption draws a fresh salt and derives
+ * directly. EncryptStream/DecryptStream process the raw
+ * "Salted__" + salt + ciphertext format incrementally over caller buffers.
  */
 class AESCipher {
 public:
+    // AES block size (128 bits = 16 bytes)
+    static constexpr size_t BLOCK_SIZE = 16;
+    
+    // Raw header: "Salted__" + 8-byte salt
+    static constexpr size_t HEADER_SIZE = 16;
+    
+    /**
+     * @brief Size of the raw (not base64) encrypted form of a message
+     * @param message_length Plaintext length
+     * @return HEADER_SIZE + PKCS7-padded ciphertext length
+     */
+    static constexpr size_t encrypted_size(size_t message_length) {
+        return HEADER_SIZE + (message_length / BLOCK_SIZE + 1) * BLOCK_SIZE;
+    }
+    
+    /**
+     * @brief Incremental encryption into caller buffers
+     * 
+     * Output is the raw crypto-js format ("Salted__" + salt + ciphertext);
+     * base64-urlsafe encoding it gives the same format as encrypt().
+     */
+    class EncryptStream {
+    public:
+        /**
+         * @brief Encrypt the next chunk
+         * 
+         * The first call also writes the 16-byte header.
+         * 
+         * @param in Plaintext chunk
+         * @param length Chunk length
+         * @param out Output buffer of at least length + HEADER_SIZE + BLOCK_SIZE bytes
+         * @return Number of bytes written
+         * @throws std::runtime_error if encryption fails or the stream is finished
+         */
+        size_t update(const uint8_t* in, size_t length, uint8_t* out);
+        
+        /**
+         * @brief Write the final padded block
+         * @param out Output buffer of at least HEADER_SIZE + BLOCK_SIZE bytes
+         * @return Number of bytes written
+         * @throws std::runtime_error if encryption fails or the stream is finished
+         */
+        size_t finish(uint8_t* out);
+        
+    private:
+        friend class AESCipher;
+        EncryptStream(const AESCipher& cipher);
+        
+        std::unique_ptr<evp_cipher_ctx_st, void (*)(evp_cipher_ctx_st*)> ctx_;
+        std::array<uint8_t, HEADER_SIZE> header_;
+        bool header_written_ = false;
+        bool finished_ = false;
+        
+        size_t write_header(uint8_t* out);
+    };
+    
+    /**
+     * @brief Incremental decryption from caller buffers
+     * 
+     * Accepts the raw crypto-js format in chunks of any size; the key is
+     * derived once the 16-byte header has been received.
+     */
+    class DecryptStream {
+    public:
+        /**
+         * @brief Decrypt the next chunk
+         * @param in Encrypted chunk
+         * @param length Chunk length
+         * @param out Output buffer of at least length + BLOCK_SIZE bytes
+         * @return Number of plaintext bytes written
+         * @throws std::invalid_argument if the header is invalid
+         * @throws std::runtime_error if decryption fails or the stream is finished
+         */
+        size_t update(const uint8_t* in, size_t length, uint8_t* out);
+        
+        /**
+         * @brief Check the final block padding and write the remaining plaintext
+         * @param out Output buffer of at least BLOCK_SIZE bytes
+         * @return Number of plaintext bytes written
+         * @throws std::invalid_argument if the input was shorter than header plus one block
+         * @throws std::runtime_error on wrong passphrase or corrupted data
+         */
+        size_t finish(uint8_t* out);
+        
+    private:
+        friend class AESCipher;
+        DecryptStream(const AESCipher& cipher);
+        
+        const AESCipher* cipher_;
+        std::unique_ptr<evp_cipher_ctx_st, void (*)(evp_cipher_ctx_st*)> ctx_;
+        std::array<uint8_t, HEADER_SIZE> header_;
+        size_t header_received_ = 0;
+        size_t payload_received_ = 0;
+        bool finished_ = false;
+    };
+    
     /**
      * @brief Construct AESCipher with encryption key
      * 
@@ -51,14 +158,14 @@ public:
      * @return Base64-urlsafe encoded encrypted string
      * @throws std::runtime_error if encryption fails
      */
-    std::string encrypt(const std::vector<uint8_t>& message);
+    std::string encrypt(const std::vector<uint8_t>& message) const;
     
     /**
      * @brief Convenience overload for string messages
      * @param message String message to encrypt
      * @return Base64-urlsafe encoded encrypted string
      */
-    std::string encrypt(const std::string& message);
+    std::string encrypt(const std::string& message) const;
 
     /**
      * @brief Decrypt AES-256-CBC encrypted string
@@ -75,43 +182,50 @@ public:
      * @throws std::invalid_argument if format is invalid
      * @throws std::runtime_error if decryption fails or wrong passphrase
      */
-    std::string decrypt(const std::string& encrypted);
+    std::string decrypt(const std::string& encrypted) const;
+    
+    /**
+     * @brief Start an incremental encryption with a fresh random salt
+     * @return Encryption stream
+     */
+    EncryptStream encrypt_stream() const;
+    
+    /**
+     * @brief Start an incremental decryption
+     * @return Decryption stream
+     */
+    DecryptStream decrypt_stream() const;
 
 private:
+    // Memoized key/IV derivations, keyed by salt
+    struct KeyCache;
+    
     std::string key_;
     std::string description_;
-    
-    // AES block size (128 bits = 16 bytes)
-    static constexpr size_t BLOCK_SIZE = 16;
+    std::shared_ptr<KeyCache> key_cache_;
     
     // Salt header used by crypto-js
     static constexpr char SALT_HEADER[8] = {'S', 'a', 'l', 't', 'e', 'd', '_', '_'};
-
+    
     /**
-     * @brief Apply PKCS7 padding to data
-     * 
-     * Pads data to block boundary using PKCS7 standard:
-     * - Calculate padding length needed
-     * - Append padding_length bytes, each with value = padding_length
-     * 
-     * @param data Data to pad
-     * @return Padded data
+     * @brief bytes_to_key(key_, salt, 48)
+     * @param salt 8-byte salt
+     * @return 32-byte key followed by 16-byte IV
      */
-    std::vector<uint8_t> pad(const std::vector<uint8_t>& data);
-
+    std::array<uint8_t, 48> derive_key_iv(const uint8_t* salt) const;
+    
     /**
-     * @brief Remove PKCS7 padding from data
-     * 
-     * Removes PKCS7 padding:
-     * - Read last byte to get padding length
-     * - Verify padding is valid
-     * - Remove padding bytes
-     * 
-     * @param data Padded data
-     * @return Unpadded data
-     * @throws std::runtime_error if padding is invalid
+     * @brief Memoized derive_key_iv() for decryption, where salts repeat
+     */
+    std::array<uint8_t, 48> cached_key_iv(const uint8_t* salt) const;
+    
+    /**
+     * @brief Encrypt message into out as "Salted__" + salt + ciphertext
+     * @param ctx Cipher context to (re)initialize
+     * @param out Buffer of at least encrypted_size(length) bytes
+     * @return Number of bytes written
      */
-    std::vector<uint8_t> unpad(const std::vector<uint8_t>& data);
+    size_t encrypt_raw(evp_cipher_ctx_st* ctx, const uint8_t* message, size_t length, uint8_t* out) const;
 
     /**
      * @brief Derive key and IV from password and salt (crypto-js compatible)
@@ -128,23 +242,24 @@ private:
      * @param output Number of output bytes (32 for key + 16 for IV = 48)
      * @return Derived key material (first 32 bytes = key, next 16 bytes = IV)
      */
-    std::vector<uint8_t> bytes_to_key(const std::vector<uint8_t>& password, 
-                                      const std::vector<uint8_t>& salt, 
-                                      size_t output = 48);
+    static std::vector<uint8_t> bytes_to_key(const std::vector<uint8_t>& password, 
+                                             const std::vector<uint8_t>& salt, 
+                                             size_t output = 48);
 
     /**
      * @brief Generate cryptographically secure random bytes
      * @param count Number of bytes to generate
      * @return Random bytes
      */
-    std::vector<uint8_t> generate_random_bytes(size_t count);
+    static std::vector<uint8_t> generate_random_bytes(size_t count);
 
     /**
      * @brief Encode bytes to base64-urlsafe format
      * @param data Bytes to encode
+     * @param length Number of bytes
      * @return Base64-urlsafe encoded string
      */
-    std::string encode_base64_urlsafe(const std::vector<uint8_t>& data);
+    static std::string encode_base64_urlsafe(const uint8_t* data, size_t length);
 
     /**
      * @brief Decode base64-urlsafe format to bytes
@@ -152,7 +267,7 @@ private:
      * @return Decoded bytes
      * @throws std::invalid_argument if encoding is invalid
      */
-    std::vector<uint8_t> decode_base64_urlsafe(const std::string& encoded);
+    static std::vector<uint8_t> decode_base64_urlsafe(const std::string& encoded);
 };
 
 /**
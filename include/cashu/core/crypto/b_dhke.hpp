@@ -73,6 +73,21 @@ std::tuple<PublicKey, PrivateKey, PrivateKey> step2_bob(
     const PrivateKey& a
 );
 
+/**
+ * @brief Step 2 of BDHKE protocol on serialized B', without throwing on bad input
+ * 
+ * ENHANCEMENT beyond nutshell: an output whose B' is not a point on the curve
+ * is reported as an error value.
+ * 
+ * @param B_ Compressed or uncompressed blinded point from Alice
+ * @param a Bob's private key
+ * @return Tuple of (C', e, s), or GENERIC error if B' is not a valid point
+ */
+Result<std::tuple<PublicKey, PrivateKey, PrivateKey>> try_step2_bob(
+    const std::vector<uint8_t>& B_,
+    const PrivateKey& a
+);
+
 /**
  * @brief Step 3 of BDHKE protocol (Alice's side)
  * 
@@ -109,6 +124,23 @@ bool verify(
     const std::string& secret_msg
 );
 
+/**
+ * @brief Verify serialized signature C, without throwing on bad input
+ * 
+ * ENHANCEMENT beyond nutshell: same check as verify(), including the
+ * deprecated hash_to_curve fallback, with rejections as error values.
+ * 
+ * @param a Bob's private key
+ * @param C Compressed or uncompressed signature point
+ * @param secret_msg Original secret message
+ * @return Success, or INVALID_PROOFS if C is not a valid point or does not match
+ */
+Result<void> try_verify(
+    const PrivateKey& a,
+    const std::vector<uint8_t>& C,
+    const std::string& secret_msg
+);
+
 /**
  * @brief Generate hash for DLEQ proof
  * 
@@ -5,6 +5,7 @@
 // Nutshell uses external BIP32 library, cashuv2 provides complete BIP39 support
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <array>
 #include <boost/multiprecision/cpp_int.hpp>
@@ -12,27 +13,60 @@
 namespace cashu::core::crypto {
     using namespace boost::multiprecision;
 
+/**
+ * @brief Result of validating one mnemonic
+ */
+enum class MnemonicStatus : uint8_t {
+    VALID = 0,
+    INVALID_LENGTH,      // Not 12, 15, 18, 21 or 24 words
+    UNKNOWN_WORD,        // Word not in the English wordlist
+    CHECKSUM_MISMATCH    // Checksum bits do not match SHA256(entropy)
+};
+
 /**
  * @brief BIP39 mnemonic utilities
  * 
  * Implementation of BIP39 standard for mnemonic code generation and validation.
- * Supports loading wordlists from files and converting between entropy and mnemonic phrases.
+ * The English wordlist is embedded at compile time (generated from
+ * resources/bip39/english.txt), so no file I/O happens at runtime.
  * 
  * ENHANCEMENT: This provides complete BIP39 support beyond nutshell capabilities.
  * Nutshell relies on external bip32 library, cashuv2 implements full standard.
  */
 class BIP39 {
 public:
+    static constexpr size_t MAX_ENTROPY_BYTES = 32;
+    static constexpr size_t MAX_WORDS = 24;
+    
     /**
-     * @brief Load BIP39 wordlist from file
+     * @brief Get the English BIP39 wordlist
      * 
-     * Loads the English BIP39 wordlist from resources/bip39/english.txt
+     * Returns a copy of the embedded English wordlist. Prefer word_at() and
+     * find_word_index(), which do not allocate.
      * 
      * @return Vector containing all 2048 BIP39 words
-     * @throws std::runtime_error if wordlist file cannot be loaded
      */
     static std::vector<std::string> load_english_wordlist();
     
+    /**
+     * @brief Get word at wordlist index
+     * @param index Word index (0-2047)
+     * @return Word from the embedded English wordlist
+     * @throws std::out_of_range if index >= 2048
+     */
+    static std::string_view word_at(size_t index);
+    
+    /**
+     * @brief Find word index in the English wordlist
+     * 
+     * BIP39 English words are unique in their first 4 letters, so lookup is a
+     * binary search over packed 4-letter prefixes followed by one full compare.
+     * 
+     * @param word Word to find
+     * @return Index of word, or -1 if not found
+     */
+    static int find_word_index(std::string_view word);
+    
     /**
      * @brief Convert entropy bytes to BIP39 mnemonic phrase
      * 
@@ -75,6 +109,23 @@ public:
      */
     static bool validate_mnemonic(const std::string& mnemonic);
     
+    /**
+     * @brief Validate a batch of mnemonic phrases
+     * 
+     * Bulk form of validate_mnemonic() for migrations and backup checks.
+     * Words are tokenized in place and results are written to caller
+     * buffers, so no memory is allocated per mnemonic or per word.
+     * 
+     * @param mnemonics Array of count mnemonic phrases
+     * @param count Number of mnemonics
+     * @param statuses Output array of count statuses
+     * @param entropy_out Optional output of count * MAX_ENTROPY_BYTES bytes; the
+     *                    entropy of mnemonic i is written at offset i * MAX_ENTROPY_BYTES
+     * @return Number of valid mnemonics
+     */
+    static size_t validate_mnemonics(const std::string_view* mnemonics, size_t count,
+                                     MnemonicStatus* statuses, uint8_t* entropy_out = nullptr);
+    
     /**
      * @brief Generate random BIP39 mnemonic phrase
      * 
@@ -90,54 +141,49 @@ public:
      * @throws std::invalid_argument if entropy_bits is invalid
      */
     static std::string generate_mnemonic(int entropy_bits = 256);
-
-private:
+    
     /**
-     * @brief Get path to wordlist file
+     * @brief Derive BIP39 seed from mnemonic phrase
      * 
-     * Returns the full path to the English wordlist file.
-     * Uses compile-time path from CMake or relative path.
+     * PBKDF2-HMAC-SHA512 with 2048 iterations and salt "mnemonic" + passphrase,
+     * as used by the wallet for NUT-13 deterministic secrets. The mnemonic is
+     * not validated here (BIP39 allows seeds from any phrase).
      * 
-     * @return Full path to english.txt
+     * @param mnemonic BIP39 mnemonic phrase
+     * @param passphrase Optional passphrase
+     * @return 64-byte seed
+     * @throws std::runtime_error if PBKDF2 fails
      */
-    static std::string get_wordlist_path();
-    
+    static std::vector<uint8_t> mnemonic_to_seed(const std::string& mnemonic, const std::string& passphrase = "");
+
+private:
     /**
-     * @brief Calculate checksum for entropy
+     * @brief BIP39 checksum byte for entropy
      * 
-     * Calculates BIP39 checksum by taking first (entropy_length/32) bits
-     * from SHA256 hash of entropy.
+     * First byte of SHA256(entropy). The checksum is its top
+     * (entropy_length / 4) bits, at most 8 for 32 bytes of entropy.
      * 
      * @param entropy Entropy bytes
-     * @return Checksum bits as vector<bool>
+     * @param length Entropy length in bytes
+     * @return First hash byte
      */
-    static std::vector<bool> calculate_checksum(const std::vector<uint8_t>& entropy);
+    static uint8_t checksum_byte(const uint8_t* entropy, size_t length);
     
     /**
-     * @brief Convert bytes to bit array
+     * @brief Decode mnemonic phrase into entropy without allocating
      * 
-     * @param bytes Input bytes
-     * @return Bit representation as vector<bool>
-     */
-    static std::vector<bool> bytes_to_bits(const std::vector<uint8_t>& bytes);
-    
-    /**
-     * @brief Convert bit array to bytes
-     * 
-     * @param bits Input bits (must be multiple of 8)
-     * @return Byte representation
-     */
-    static std::vector<uint8_t> bits_to_bytes(const std::vector<bool>& bits);
-    
-    /**
-     * @brief Find word index in wordlist
+     * Packs 11-bit word indices into a 64-bit accumulator and shifts out
+     * entropy bytes, leaving the checksum bits in the low bits.
      * 
-     * @param word Word to find
-     * @param wordlist BIP39 wordlist
-     * @return Index of word, or -1 if not found
+     * @param mnemonic Mnemonic phrase
+     * @param entropy Output buffer of MAX_ENTROPY_BYTES
+     * @param entropy_length Set to the entropy length on success
+     * @param bad_word Set to the unknown word on UNKNOWN_WORD
+     * @return Validation status
      */
-    static int find_word_index(const std::string& word, 
-                              const std::vector<std::string>& wordlist);
+    static MnemonicStatus decode_mnemonic(std::string_view mnemonic, uint8_t* entropy,
+                                          size_t& entropy_length, std::string_view& bad_word);
+
 };
 
 } // namespace cashu::core::crypto
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: replaces Dict[int, PrivateKey] / Dict[int, PublicKey] in cashu/core/crypto/keys.py
+// Dense power-of-two denomination table - ENHANCEMENT beyond nutshell
+// Keys are indexed directly by log2(amount) instead of hashing a cpp_int
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <boost/multiprecision/cpp_int.hpp>
+
+namespace cashu::core::crypto {
+    using namespace boost::multiprecision;
+
+/**
+ * @brief Maximum number of denominations (2^0 .. 2^63)
+ */
+constexpr size_t MAX_DENOMINATIONS = 64;
+
+/**
+ * @brief Count trailing zero bits of a non-zero 64-bit value
+ * @param value Non-zero value
+ * @return Index of the lowest set bit
+ */
+inline unsigned lowest_bit_index(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned index = 0;
+    while ((value & 1) == 0) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Number of set bits, i.e. number of outputs in the split of amount
+ */
+inline unsigned popcount(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+    unsigned count = 0;
+    for (; value != 0; value &= value - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit of a non-zero value (floor(log2(value)))
+ * @param value Non-zero value
+ */
+inline unsigned highest_bit_index(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned index = 0;
+    while (value >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Check if amount is a valid denomination (power of two below 2^64)
+ * @param amount Amount to check
+ * @return True if amount is a power of two
+ */
+constexpr bool is_valid_denomination(uint64_t amount) noexcept {
+    return amount != 0 && (amount & (amount - 1)) == 0;
+}
+
+/**
+ * @brief Check if amount is a valid denomination (power of two below 2^64)
+ * @param amount Amount to check
+ * @return True if amount is a power of two
+ */
+bool is_valid_denomination(const cpp_int& amount);
+
+/**
+ * @brief Get table slot for a denomination
+ * @param amount Power-of-two amount
+ * @return log2(amount)
+ * @throws std::invalid_argument if amount is not a power of two
+ */
+size_t denomination_index(uint64_t amount);
+
+/**
+ * @brief Get table slot for a denomination
+ * @param amount Power-of-two amount
+ * @return log2(amount)
+ * @throws std::invalid_argument if amount is not a power of two below 2^64
+ */
+size_t denomination_index(const cpp_int& amount);
+
+/**
+ * @brief Fixed-size table mapping power-of-two amounts to values
+ *
+ * Stores one value per denomination in a 64-slot array indexed by log2(amount).
+ * A bitmask of occupied slots gives O(1) membership checks and ascending-amount
+ * iteration without sorting.
+ *
+ * Used for keyset private/public keys where nutshell uses Dict[int, Key].
+ *
+ * @tparam T Stored value type (e.g. PrivateKey, PublicKey)
+ */
+template<typename T>
+class DenominationTable {
+public:
+    /**
+     * @brief Forward iterator over occupied slots in ascending amount order
+     *
+     * Dereferences to (amount, value) so structured bindings work:
+     *   for (const auto& [amount, key] : table) { ... }
+     */
+    class const_iterator {
+    public:
+        const_iterator(const DenominationTable* table, uint64_t remaining)
+            : table_(table), remaining_(remaining) {}
+
+        std::pair<uint64_t, const T&> operator*() const {
+            unsigned index = lowest_bit_index(remaining_);
+            return {uint64_t(1) << index, *table_->slots_[index]};
+        }
+
+        const_iterator& operator++() {
+            remaining_ &= remaining_ - 1;  // Clear lowest occupied slot
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const { return remaining_ == other.remaining_; }
+        bool operator!=(const const_iterator& other) const { return remaining_ != other.remaining_; }
+
+    private:
+        const DenominationTable* table_;
+        uint64_t remaining_;
+    };
+
+    DenominationTable() = default;
+
+    /**
+     * @brief Insert or replace value for a denomination
+     * @param amount Power-of-two amount
+     * @param value Value to store
+     * @throws std::invalid_argument if amount is not a power of two
+     */
+    void insert(uint64_t amount, T value) {
+        size_t index = denomination_index(amount);
+        slots_[index] = std::move(value);
+        present_ |= uint64_t(1) << index;
+    }
+
+    /**
+     * @brief Insert or replace value for a denomination
+     * @param amount Power-of-two amount
+     * @param value Value to store
+     * @throws std::invalid_argument if amount is not a power of two below 2^64
+     */
+    void insert(const cpp_int& amount, T value) {
+        insert(uint64_t(1) << denomination_index(amount), std::move(value));
+    }
+
+    /**
+     * @brief Check if a value is stored for amount
+     * @param amount Amount to look up (any value, invalid amounts return false)
+     * @return True if present
+     */
+    bool contains(uint64_t amount) const noexcept {
+        return is_valid_denomination(amount) && ((present_ & amount) != 0);
+    }
+
+    /**
+     * @brief Check if a value is stored for amount
+     * @param amount Amount to look up (any value, invalid amounts return false)
+     * @return True if present
+     */
+    bool contains(const cpp_int& amount) const {
+        return is_valid_denomination(amount) && contains(static_cast<uint64_t>(amount));
+    }
+
+    /**
+     * @brief Checked lookup
+     * @param amount Amount to look up
+     * @return Stored value
+     * @throws std::out_of_range if no value stored for amount
+     */
+    const T& at(uint64_t amount) const {
+        if (!contains(amount)) {
+            throw std::out_of_range("No key for amount " + std::to_string(amount));
+        }
+        return *slots_[lowest_bit_index(amount)];
+    }
+
+    /**
+     * @brief Checked lookup
+     * @param amount Amount to look up
+     * @return Stored value
+     * @throws std::out_of_range if no value stored for amount
+     */
+    const T& at(const cpp_int& amount) const {
+        if (!contains(amount)) {
+            throw std::out_of_range("No key for amount " + amount.str());
+        }
+        return *slots_[lowest_bit_index(static_cast<uint64_t>(amount))];
+    }
+
+    /**
+     * @brief Unchecked lookup for the signing hot path
+     *
+     * Caller must have validated the amount with contains() (e.g. when
+     * checking outputs against the keyset). No hashing and no branches.
+     *
+     * @param amount Power-of-two amount present in the table
+     * @return Stored value
+     */
+    const T& operator[](uint64_t amount) const noexcept {
+        return *slots_[lowest_bit_index(amount) & (MAX_DENOMINATIONS - 1)];
+    }
+
+    /**
+     * @brief Lookup returning nullptr when absent
+     * @param amount Amount to look up
+     * @return Pointer to stored value, or nullptr
+     */
+    const T* find(uint64_t amount) const noexcept {
+        return contains(amount) ? &*slots_[lowest_bit_index(amount)] : nullptr;
+    }
+
+    /**
+     * @brief Number of stored denominations
+     */
+    size_t size() const noexcept {
+        size_t count = 0;
+        for (uint64_t mask = present_; mask != 0; mask &= mask - 1) {
+            ++count;
+        }
+        return count;
+    }
+
+    bool empty() const noexcept { return present_ == 0; }
+
+    /**
+     * @brief Bitmask of stored denominations (bit i set means amount 2^i present)
+     */
+    uint64_t mask() const noexcept { return present_; }
+
+    /**
+     * @brief Stored amounts in ascending order
+     */
+    std::vector<uint64_t> amounts() const {
+        std::vector<uint64_t> result;
+        result.reserve(size());
+        for (uint64_t mask = present_; mask != 0; mask &= mask - 1) {
+            result.push_back(uint64_t(1) << lowest_bit_index(mask));
+        }
+        return result;
+    }
+
+    const_iterator begin() const { return const_iterator(this, present_); }
+    const_iterator end() const { return const_iterator(this, 0); }
+
+private:
+    std::array<std::optional<T>, MAX_DENOMINATIONS> slots_;
+    uint64_t present_ = 0;
+};
+
+} // namespace cashu::core::crypto
@@ -0,0 +1,170 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: cashu/wallet/secrets.py
+// NUT-13 deterministic secrets and blinding factors for wallet backup/restore
+// Derivation matches nutshell; the batched and parallel restore scan is an ENHANCEMENT
+
+#include "secp.hpp"
+#include "keys.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cashu::core::crypto {
+
+/**
+ * @brief Secret and blinding factor derived for one counter
+ */
+struct DeterministicSecret {
+    std::string secret;           // Hex-encoded 32-byte secret (the NUT-13 secret string)
+    PrivateKey r;                 // Blinding factor
+    std::string derivation_path;  // Path of the secret, e.g. "m/129372'/0'/864559728'/0'"
+    uint32_t counter;             // Derivation counter
+};
+
+/**
+ * @brief Deterministic secret with its blinded message B_ = Y + r*G
+ */
+struct BlindedDeterministicSecret {
+    DeterministicSecret secret;
+    PublicKey B_;
+};
+
+/**
+ * @brief Result of a restore scan
+ */
+struct RestoreResult {
+    std::vector<BlindedDeterministicSecret> found;  // Secrets the mint has signed, ascending counter
+    uint32_t next_counter = 0;                      // Counter to store in WalletKeyset.counter
+};
+
+/**
+ * @brief NUT-13 deterministic secret engine
+ *
+ * Derives secrets and blinding factors at
+ *   m/129372'/0'/{keyset_id_int}'/{counter}'/0  (secret)
+ *   m/129372'/0'/{keyset_id_int}'/{counter}'/1  (r)
+ * from the BIP39 seed of the wallet mnemonic.
+ *
+ * The per-keyset node m/129372'/0'/{keyset_id_int}' is derived once and
+ * cached, so each counter costs three child derivations instead of a full
+ * path walk from the master key. Ranges are derived and blinded in parallel
+ * chunks, and restore() blinds several windows ahead while the caller checks
+ * the current one against the mint.
+ *
+ * Thread-safe: the node cache is guarded by a mutex, derivation is const.
+ */
+class DeterministicSecretEngine {
+public:
+    /**
+     * @brief Callback checking a window of blinded messages against the mint
+     *
+     * Receives the window's blinded messages in counter order and returns one
+     * flag per message, true if the mint has a signature for it (NUT-09 restore).
+     */
+    using RestoreCheck = std::function<std::vector<bool>(const std::vector<BlindedDeterministicSecret>&)>;
+
+    /**
+     * @brief Create engine from wallet mnemonic
+     * @param mnemonic BIP39 mnemonic phrase
+     * @param passphrase Optional BIP39 passphrase
+     */
+    explicit DeterministicSecretEngine(const std::string& mnemonic, const std::string& passphrase = "");
+
+    /**
+     * @brief Map keyset id to its NUT-13 derivation index
+     *
+     * int(keyset_id bytes, big endian) mod (2^31 - 1). Hex ids are decoded as
+     * hex, legacy ids as base64 (matches nutshell derive_keyset_id_int).
+     *
+     * @param keyset_id Keyset ID
+     * @return Derivation index below 2^31
+     * @throws std::invalid_argument if keyset_id is neither hex nor base64
+     */
+    static uint32_t keyset_id_to_int(const std::string& keyset_id);
+
+    /**
+     * @brief Derivation path prefix for a counter
+     * @param keyset_id Keyset ID
+     * @param counter Derivation counter
+     * @return "m/129372'/0'/{keyset_id_int}'/{counter}'"
+     */
+    static std::string derivation_path(const std::string& keyset_id, uint32_t counter);
+
+    /**
+     * @brief Derive secret and blinding factor for one counter
+     * @param keyset_id Keyset ID
+     * @param counter Derivation counter (below 2^31)
+     * @return Derived secret
+     * @throws std::invalid_argument if counter is out of range
+     */
+    DeterministicSecret derive(const std::string& keyset_id, uint32_t counter) const;
+
+    /**
+     * @brief Derive secrets for counters [from, from + count)
+     * @param keyset_id Keyset ID
+     * @param from First counter
+     * @param count Number of counters
+     * @return Derived secrets in counter order
+     * @throws std::invalid_argument if the range exceeds 2^31
+     */
+    std::vector<DeterministicSecret> derive_range(const std::string& keyset_id, uint32_t from, uint32_t count) const;
+
+    /**
+     * @brief Derive and blind secrets for counters [from, from + count)
+     *
+     * Computes B_ = hash_to_curve(secret) + r*G for every counter, splitting
+     * the range into chunks that are hashed and blinded in parallel.
+     *
+     * @param keyset_id Keyset ID
+     * @param from First counter
+     * @param count Number of counters
+     * @return Blinded secrets in counter order
+     * @throws std::invalid_argument if the range exceeds 2^31
+     */
+    std::vector<BlindedDeterministicSecret> blind_range(const std::string& keyset_id, uint32_t from, uint32_t count) const;
+
+    /**
+     * @brief Gap-limited restore scan
+     *
+     * Walks windows of window_size counters starting at 0. Up to
+     * parallel_windows windows are derived and blinded concurrently; windows
+     * are checked in order and the scan stops after gap_limit consecutive
+     * windows without a signed output.
+     *
+     * @param keyset_id Keyset ID
+     * @param check Callback reporting which outputs the mint has signed
+     * @param window_size Counters per window (default: 100)
+     * @param gap_limit Empty windows before stopping (default: 3)
+     * @param parallel_windows Windows prepared ahead of the check (default: 4)
+     * @return Found secrets and the next unused counter
+     * @throws std::invalid_argument if window_size or gap_limit is zero
+     * @throws std::runtime_error if check returns a wrong number of flags
+     */
+    RestoreResult restore(const std::string& keyset_id,
+                          const RestoreCheck& check,
+                          uint32_t window_size = 100,
+                          uint32_t gap_limit = 3,
+                          uint32_t parallel_windows = 4) const;
+
+private:
+    std::unique_ptr<BIP32Helper> bip32_;
+    mutable std::mutex node_cache_mutex_;
+    mutable std::unordered_map<uint32_t, BIP32Node> node_cache_;  // keyset_id_int -> m/129372'/0'/{keyset_id_int}'
+
+    /**
+     * @brief Get cached keyset node, deriving it on first use
+     */
+    BIP32Node keyset_node(uint32_t keyset_id_int) const;
+
+    /**
+     * @brief Derive one counter from the keyset node
+     */
+    static DeterministicSecret derive_from_node(const BIP32Node& node, uint32_t keyset_id_int, uint32_t counter);
+};
+
+} // namespace cashu::core::crypto
@@ -5,9 +5,10 @@
 // Supports all historical versions (pre-0.12, 0.12-0.14, 0.15+)
 
 #include "secp.hpp"
+#include "denominations.hpp"
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <optional>
 #include <utility>
 #include <boost/multiprecision/cpp_int.hpp>
 
@@ -23,9 +24,10 @@ namespace cashu::core::crypto {
  * @param mnemonic BIP39 mnemonic seed phrase
  * @param derivation_path BIP32 derivation path (e.g., "m/44'/1'/0'/0")
  * @param amounts List of amounts to derive keys for
- * @return Map from amount to derived private key
+ * @return Table from amount to derived private key
+ * @throws std::invalid_argument if an amount is not a power of 2
  */
-std::unordered_map<cpp_int, PrivateKey> derive_keys(
+DenominationTable<PrivateKey> derive_keys(
     const std::string& mnemonic,
     const std::string& derivation_path,
     const std::vector<cpp_int>& amounts
@@ -40,9 +42,9 @@ std::unordered_map<cpp_int, PrivateKey> derive_keys(
  * @param seed String seed for derivation
  * @param amounts List of amounts to derive keys for
  * @param derivation_path Derivation path suffix (concatenated with seed)
- * @return Map from amount to derived private key
+ * @return Table from amount to derived private key
  */
-std::unordered_map<cpp_int, PrivateKey> derive_keys_deprecated_pre_0_15(
+DenominationTable<PrivateKey> derive_keys_deprecated_pre_0_15(
     const std::string& seed,
     const std::vector<cpp_int>& amounts,
     const std::string& derivation_path
@@ -61,9 +63,9 @@ std::unordered_map<cpp_int, PrivateKey> derive_keys_deprecated_pre_0_15(
  * 
  * @param seed String seed for derivation
  * @param derivation_path Derivation path suffix
- * @return Map from amount to derived private key (fixed amounts: powers of 2)
+ * @return Table from amount to derived private key (fixed amounts: powers of 2)
  */
-std::unordered_map<cpp_int, PrivateKey> derive_keys_backwards_compatible_insecure_pre_0_12(
+DenominationTable<PrivateKey> derive_keys_backwards_compatible_insecure_pre_0_12(
     const std::string& seed,
     const std::string& derivation_path
 );
@@ -82,14 +84,14 @@ PublicKey derive_pubkey(const std::string& seed);
 /**
  * @brief Derive public keys from private keys
  * 
- * Converts a map of private keys to corresponding public keys.
+ * Converts a table of private keys to corresponding public keys.
  * 
- * @param keys Map of private keys by amount
+ * @param keys Table of private keys by amount
  * @param amounts List of amounts to derive public keys for
- * @return Map from amount to public key
+ * @return Table from amount to public key
  */
-std::unordered_map<cpp_int, PublicKey> derive_pubkeys(
-    const std::unordered_map<cpp_int, PrivateKey>& keys,
+DenominationTable<PublicKey> derive_pubkeys(
+    const DenominationTable<PrivateKey>& keys,
     const std::vector<cpp_int>& amounts
 );
 
@@ -97,15 +99,15 @@ std::unordered_map<cpp_int, PublicKey> derive_pubkeys(
  * @brief Deterministic derivation of keyset ID from public keys
  * 
  * Creates a unique identifier for a keyset by:
- * 1. Sorting public keys by amount
+ * 1. Iterating public keys in ascending amount order (table order)
  * 2. Concatenating their serialized representations
  * 3. Hashing with SHA256
  * 4. Taking first 14 hex characters and prefixing with "00"
  * 
- * @param keys Map of public keys by amount
+ * @param keys Table of public keys by amount
  * @return Keyset ID as hex string (format: "00" + 14 hex chars)
  */
-std::string derive_keyset_id(const std::unordered_map<cpp_int, PublicKey>& keys);
+std::string derive_keyset_id(const DenominationTable<PublicKey>& keys);
 
 /**
  * @brief Deprecated keyset ID derivation (pre-v0.15.0)
@@ -113,10 +115,10 @@ std::string derive_keyset_id(const std::unordered_map<cpp_int, PublicKey>& keys)
  * Legacy method that produces base64 keyset IDs instead of hex.
  * Kept for backwards compatibility.
  * 
- * @param keys Map of public keys by amount
+ * @param keys Table of public keys by amount
  * @return Keyset ID as base64 string (12 characters)
  */
-std::string derive_keyset_id_deprecated(const std::unordered_map<cpp_int, PublicKey>& keys);
+std::string derive_keyset_id_deprecated(const DenominationTable<PublicKey>& keys);
 
 /**
  * @brief Version-aware keyset ID derivation (nutshell compatible)
@@ -124,12 +126,12 @@ std::string derive_keyset_id_deprecated(const std::unordered_map<cpp_int, Public
  * Automatically selects the correct keyset ID generation method based on 
  * the nutshell version for full backwards compatibility.
  * 
- * @param keys Map of public keys by amount
+ * @param keys Table of public keys by amount
  * @param version Nutshell version string (e.g., "0.15.0")
  * @return Keyset ID in the format used by that version
  */
 std::string derive_keyset_id_version_aware(
-    const std::unordered_map<cpp_int, PublicKey>& keys,
+    const DenominationTable<PublicKey>& keys,
     const std::string& version
 );
 
@@ -145,6 +147,21 @@ std::string random_hash();
 
 // ---- BIP32 Helper Functions ----
 
+/**
+ * @brief Extended private key at some point of a BIP32 derivation path
+ * 
+ * Callers that derive many children of the same parent (keyset amounts,
+ * NUT-13 counters) keep the parent node instead of re-deriving the path.
+ */
+struct BIP32Node {
+    PrivateKey key;
+    std::vector<uint8_t> chain_code;
+    std::optional<PublicKey> public_key;  // Cached parent pubkey for non-hardened children
+    
+    BIP32Node(const PrivateKey& key, const std::vector<uint8_t>& chain_code)
+        : key(key), chain_code(chain_code) {}
+};
+
 /**
  * @brief BIP32 key derivation utility class
  * 
@@ -160,6 +177,17 @@ public:
      */
     explicit BIP32Helper(const std::string& mnemonic, const std::string& passphrase = "");
     
+    /**
+     * @brief Initialize from raw seed bytes
+     * 
+     * Used by the wallet, which derives NUT-13 secrets from the BIP39
+     * PBKDF2 seed (see BIP39::mnemonic_to_seed) like nutshell's BIP32.from_seed.
+     * 
+     * @param seed Seed bytes
+     * @return Helper rooted at the seed's master key
+     */
+    static BIP32Helper from_seed(const std::vector<uint8_t>& seed);
+    
     /**
      * @brief Derive private key from BIP32 path
      * @param path BIP32 derivation path (e.g., "m/44'/1'/0'/0/0'")
@@ -167,6 +195,25 @@ public:
      */
     PrivateKey get_privkey_from_path(const std::string& path);
     
+    /**
+     * @brief Derive extended key node from BIP32 path
+     * @param path BIP32 derivation path (e.g., "m/129372'/0'")
+     * @return Derived node (key and chain code)
+     */
+    BIP32Node get_node_from_path(const std::string& path);
+    
+    /**
+     * @brief Derive a direct child of a node
+     * 
+     * For non-hardened indices the parent public key is taken from
+     * parent.public_key when set, saving one point multiplication.
+     * 
+     * @param parent Parent node
+     * @param index Child index (with hardened bit if needed)
+     * @return Child node
+     */
+    static BIP32Node derive_child(const BIP32Node& parent, uint32_t index);
+    
     /**
      * @brief Check if a BIP32 path is valid
      * @param path Path to validate
@@ -178,6 +225,13 @@ private:
     std::vector<uint8_t> seed_;
     std::vector<uint8_t> master_chain_code_;
     
+    BIP32Helper() = default;
+    
+    /**
+     * @brief Master node derived from seed_ with HMAC-SHA512("Bitcoin seed")
+     */
+    BIP32Node master_node() const;
+    
     /**
      * @brief Parse BIP32 derivation path
      * @param path Path string to parse
@@ -190,12 +244,14 @@ private:
      * @param parent_key Parent private key
      * @param parent_chain_code Parent chain code
      * @param index Derivation index (with hardened bit if needed)
+     * @param parent_pubkey Precomputed parent public key (non-hardened only, optional)
      * @return Pair of (derived private key, derived chain code)
      */
-    std::pair<PrivateKey, std::vector<uint8_t>> derive_child_key_with_chain_code(
+    static std::pair<PrivateKey, std::vector<uint8_t>> derive_child_key_with_chain_code(
         const PrivateKey& parent_key, 
         const std::vector<uint8_t>& parent_chain_code,
-        uint32_t index
+        uint32_t index,
+        const PublicKey* parent_pubkey = nullptr
     );
 };
 
@@ -240,9 +296,9 @@ VersionTuple parse_version(const std::string& version_str);
  * @param derivation_path BIP32 path or simple string (depends on version)
  * @param amounts List of amounts to derive keys for (or empty for pre-0.12)
  * @param version Nutshell version string (e.g., "0.15.0")
- * @return Map from amount to derived private key
+ * @return Table from amount to derived private key
  */
-std::unordered_map<cpp_int, PrivateKey> derive_keys_version_aware(
+DenominationTable<PrivateKey> derive_keys_version_aware(
     const std::string& seed_or_mnemonic,
     const std::string& derivation_path,
     const std::vector<cpp_int>& amounts,
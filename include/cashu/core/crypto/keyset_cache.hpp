@@ -0,0 +1,157 @@
+#pragma once
+
+// Binary keyset cache file - ENHANCEMENT beyond nutshell
+// Persists derived keyset keys so a restarting mint can memory-map them
+// instead of re-deriving every key from the mnemonic with BIP32
+
+#include "secp.hpp"
+#include "aes.hpp"
+#include "denominations.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cashu::core::crypto {
+
+/**
+ * @brief Fully derived keyset as stored in the cache
+ */
+struct CachedKeyset {
+    std::string id;                               // Keyset ID (hex or legacy base64)
+    DenominationTable<PrivateKey> private_keys;   // Private keys by amount
+    DenominationTable<PublicKey> public_keys;     // Public keys by amount
+};
+
+/**
+ * @brief Memory-mapped binary cache of derived keysets
+ *
+ * File layout (all integers little endian):
+ *
+ *   Header (48 bytes):
+ *     magic            8 bytes  "CASHUKS\0"
+ *     version          u32      FORMAT_VERSION
+ *     keyset_count     u32
+ *     mac              32 bytes HMAC-SHA256 over all records
+ *   Record (repeated keyset_count times):
+ *     id_length        u16
+ *     id               id_length bytes
+ *     amount_mask      u64      bit i set = amount 2^i present
+ *     ciphertext_len   u32
+ *     ciphertext       AESCipher output of the concatenated 32-byte scalars
+ *     pubkeys          popcount(amount_mask) * 33 bytes, compressed, ascending amount
+ *
+ * Private scalars are encrypted with AESCipher and the records authenticated
+ * with an HMAC, both keyed from the mint seed. load() checks the HMAC once, so
+ * a tampered cache or one written for another seed is rejected as a whole.
+ * get() additionally recomputes each keyset id from its public keys.
+ */
+class KeysetCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr size_t HEADER_SIZE = 48;
+
+    /**
+     * @brief Construct cache bound to a file path
+     * @param path Cache file path
+     * @param seed Mint seed; keys AESCipher for the private scalars and the record HMAC
+     * @throws std::invalid_argument if seed is empty
+     */
+    KeysetCache(const std::string& path, const std::string& seed);
+    ~KeysetCache();
+
+    KeysetCache(const KeysetCache&) = delete;
+    KeysetCache& operator=(const KeysetCache&) = delete;
+
+    /**
+     * @brief Memory-map the cache file and validate header and HMAC
+     * @return False if the file is missing, has another version, is corrupt
+     *         or was written with another seed
+     */
+    bool load();
+
+    /**
+     * @brief Check if a keyset is present in the mapped file
+     * @param keyset_id Keyset ID
+     * @return True if present
+     */
+    bool contains(const std::string& keyset_id) const;
+
+    /**
+     * @brief Decode a cached keyset
+     *
+     * Decrypts the scalars, parses the public keys and recomputes the keyset
+     * id from them. The records were authenticated by load(), so the scalars
+     * are not re-checked against the public keys. Returns nullopt if the
+     * keyset is absent or fails validation, in which case the caller should
+     * fall back to derivation.
+     *
+     * @param keyset_id Keyset ID
+     * @return Cached keyset or nullopt
+     */
+    std::optional<CachedKeyset> get(const std::string& keyset_id) const;
+
+    /**
+     * @brief Write keysets to the cache file
+     *
+     * Writes to a temporary file and renames it over the cache path so
+     * readers never observe a partial file.
+     *
+     * @param keysets Keysets to store
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::vector<CachedKeyset>& keysets) const;
+
+    /**
+     * @brief Unmap the cache file
+     */
+    void close();
+
+private:
+    std::string path_;
+    AESCipher cipher_;  // Reused so key derivations are memoized across get() calls
+    uint8_t mac_key_[32];  // HMAC-SHA256 key for the records, derived from the seed
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::unordered_map<std::string, size_t> offsets_;  // Keyset ID -> record offset
+
+    /**
+     * @brief Build keyset ID -> offset index, validating record bounds
+     * @return False if a record overruns the file
+     */
+    bool index_records(uint32_t keyset_count);
+};
+
+/**
+ * @brief Where the keys of a mint keyset come from
+ */
+struct KeysetSource {
+    std::string id;                  // Keyset ID recorded by the mint
+    std::string derivation_path;     // BIP32 path, or seed suffix before 0.15
+    std::vector<cpp_int> amounts;    // Amounts to derive keys for
+    std::string version;             // Nutshell version that created the keyset
+};
+
+/**
+ * @brief Load mint keysets, serving them from the keyset cache when possible
+ *
+ * Uses the cache at mint_keyset_cache_path from the published settings, if set.
+ * Keysets missing from the cache or failing its validation are derived with
+ * derive_keys_version_aware(), and the cache is then rewritten once with all
+ * of the given keysets. The cache is keyed with the seed itself rather than
+ * mint_seed_decryption_key: that key is only set when the seed is stored
+ * encrypted, and the file holds nothing the seed does not already give away. Every loaded keyset
+ * id is interned with KeysetInterner::global().
+ *
+ * @param sources Keysets to load
+ * @param seed Mint seed or mnemonic
+ * @return Loaded keysets, in the order of sources
+ * @throws std::invalid_argument if a derived keyset does not hash to its id
+ */
+std::vector<CachedKeyset> load_keysets(
+    const std::vector<KeysetSource>& sources,
+    const std::string& seed
+);
+
+} // namespace cashu::core::crypto
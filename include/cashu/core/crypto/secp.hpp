@@ -3,9 +3,14 @@
 // NUTSHELL COMPATIBILITY: cashu/core/crypto/secp.py
 // Complete secp256k1 wrapper providing C++ interface compatible with nutshell's PrivateKey/PublicKey
 
+#include "cashu/core/result.hpp"
 #include <boost/multiprecision/cpp_int.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
 
 namespace cashu::core::crypto {
@@ -141,6 +146,20 @@ public:
      */
     explicit PublicKey(const std::string& hex_string);
     
+    /**
+     * @brief Parse serialized point data without throwing
+     * @param point_data Compressed (33 bytes) or uncompressed (65 bytes) point data
+     * @return Public key, or GENERIC error if the data is not a point on the curve
+     */
+    static Result<PublicKey> parse(const std::vector<uint8_t>& point_data);
+    
+    /**
+     * @brief Parse hex point data without throwing
+     * @param hex_string Point data as hex string
+     * @return Public key, or GENERIC error if the data is not a point on the curve
+     */
+    static Result<PublicKey> parse(const std::string& hex_string);
+    
     /**
      * @brief Point addition (P1 + P2)
      * @param other Public key to add
@@ -279,6 +298,23 @@ namespace secp_utils {
      */
     std::vector<uint8_t> hex_to_bytes(const std::string& hex);
     
+    /**
+     * @brief Decode exactly size bytes of hex without allocating or throwing
+     * @param hex Hex string of 2 * size digits, either case, no 0x prefix
+     * @param out Destination of size bytes (partially written on failure)
+     * @param size Number of bytes to decode
+     * @return False if hex has another length or contains a non-hex digit
+     */
+    bool hex_to_bytes(std::string_view hex, uint8_t* out, size_t size) noexcept;
+    
+    /**
+     * @brief Check whether data is a valid serialized point, without throwing
+     * @param data Compressed (33 bytes) or uncompressed (65 bytes) point data
+     * @param size Size of data
+     * @return True if data is a point on the curve
+     */
+    bool is_valid_point(const uint8_t* data, size_t size);
+    
     /**
      * @brief Convert bytes to hex string
      * @param bytes Byte vector
@@ -286,12 +322,51 @@ namespace secp_utils {
      */
     std::string bytes_to_hex(const std::vector<uint8_t>& bytes);
     
+    /**
+     * @brief Convert bytes to hex string
+     * @param data Bytes
+     * @param size Number of bytes
+     * @return Hex string (lowercase, no 0x prefix)
+     */
+    std::string bytes_to_hex(const uint8_t* data, size_t size);
+    
     /**
      * @brief Check if value is valid private key (0 < key < curve_order)
      * @param value Value to check
      * @return True if valid
      */
     bool is_valid_private_key(const cpp_int& value);
+    
+    /**
+     * @brief One BIP-340 Schnorr signature check for schnorr_verify_batch()
+     */
+    struct SchnorrCheck {
+        size_t pubkey = 0;                // Index into the pubkey table
+        const uint8_t* msg32 = nullptr;   // 32-byte message digest
+        const uint8_t* sig64 = nullptr;   // 64-byte signature
+    };
+    
+    /**
+     * @brief Verify many Schnorr signatures
+     * 
+     * NUTSHELL COMPATIBILITY: Each check matches coincurve's
+     * PublicKey.schnorr_verify(msg32, sig, None, raw=True) as used by
+     * nutshell's verify_schnorr_signature (x-only key of a compressed pubkey).
+     * 
+     * PERFORMANCE: Every pubkey in the table is parsed once no matter how
+     * many checks reference it, and checks are verified in parallel chunks.
+     * libsecp256k1 has no batch verification API, so each check is still
+     * verified individually.
+     * 
+     * @param pubkeys Compressed pubkeys (33 bytes each)
+     * @param pubkey_count Number of pubkeys
+     * @param checks Checks to verify
+     * @param count Number of checks
+     * @param results Receives 1 (valid) or 0 (invalid signature or pubkey) per check
+     * @throws std::out_of_range if a check references a pubkey outside the table
+     */
+    void schnorr_verify_batch(const std::array<uint8_t, 33>* pubkeys, size_t pubkey_count,
+                              const SchnorrCheck* checks, size_t count, uint8_t* results);
 }
 
 } // namespace cashu::core::crypto
\ No newline at end of file
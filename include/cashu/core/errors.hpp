@@ -119,7 +119,7 @@ public:
     static constexpr int DEFAULT_CODE = 11001;
     static constexpr const char* DEFAULT_DETAIL = "Token already spent.";
     
-    TokenAlreadySpentError();
+    explicit TokenAlreadySpentError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -151,7 +151,7 @@ public:
     static constexpr int DEFAULT_CODE = 11004;
     static constexpr const char* DEFAULT_DETAIL = "no secret in proofs";
     
-    NoSecretInProofsError();
+    explicit NoSecretInProofsError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -302,7 +302,7 @@ public:
     static constexpr int DEFAULT_CODE = 20001;
     static constexpr const char* DEFAULT_DETAIL = "quote not paid";
     
-    QuoteNotPaidError();
+    explicit QuoteNotPaidError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -313,7 +313,7 @@ public:
     static constexpr int DEFAULT_CODE = 20002;
     static constexpr const char* DEFAULT_DETAIL = "Tokens have already been issued for quote";
     
-    TokensAlreadyIssuedError();
+    explicit TokensAlreadyIssuedError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -324,7 +324,7 @@ public:
     static constexpr int DEFAULT_CODE = 20003;
     static constexpr const char* DEFAULT_DETAIL = "Minting is disabled";
     
-    MintingDisabledError();
+    explicit MintingDisabledError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -346,7 +346,7 @@ public:
     static constexpr int DEFAULT_CODE = 20005;
     static constexpr const char* DEFAULT_DETAIL = "Quote is pending";
     
-    QuotePendingError();
+    explicit QuotePendingError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -357,7 +357,7 @@ public:
     static constexpr int DEFAULT_CODE = 20006;
     static constexpr const char* DEFAULT_DETAIL = "Invoice already paid";
     
-    InvoiceAlreadyPaidError();
+    explicit InvoiceAlreadyPaidError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -368,7 +368,7 @@ public:
     static constexpr int DEFAULT_CODE = 20007;
     static constexpr const char* DEFAULT_DETAIL = "Quote is expired";
     
-    QuoteExpiredError();
+    explicit QuoteExpiredError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -379,7 +379,7 @@ public:
     static constexpr int DEFAULT_CODE = 20008;
     static constexpr const char* DEFAULT_DETAIL = "Signature for mint request invalid";
     
-    QuoteSignatureInvalidError();
+    explicit QuoteSignatureInvalidError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -390,7 +390,7 @@ public:
     static constexpr int DEFAULT_CODE = 20009;
     static constexpr const char* DEFAULT_DETAIL = "Pubkey required for mint quote";
     
-    QuoteRequiresPubkeyError();
+    explicit QuoteRequiresPubkeyError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 //=============================================================================
@@ -405,7 +405,7 @@ public:
     static constexpr int DEFAULT_CODE = 30001;
     static constexpr const char* DEFAULT_DETAIL = "Endpoint requires clear auth";
     
-    ClearAuthRequiredError();
+    explicit ClearAuthRequiredError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -416,7 +416,7 @@ public:
     static constexpr int DEFAULT_CODE = 30002;
     static constexpr const char* DEFAULT_DETAIL = "Clear authentication failed";
     
-    ClearAuthFailedError();
+    explicit ClearAuthFailedError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -427,7 +427,7 @@ public:
     static constexpr int DEFAULT_CODE = 31001;
     static constexpr const char* DEFAULT_DETAIL = "Endpoint requires blind auth";
     
-    BlindAuthRequiredError();
+    explicit BlindAuthRequiredError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -438,7 +438,7 @@ public:
     static constexpr int DEFAULT_CODE = 31002;
     static constexpr const char* DEFAULT_DETAIL = "Blind authentication failed";
     
-    BlindAuthFailedError();
+    explicit BlindAuthFailedError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 /**
@@ -460,7 +460,7 @@ public:
     static constexpr int DEFAULT_CODE = 31004;
     static constexpr const char* DEFAULT_DETAIL = "BAT mint rate limit exceeded";
     
-    BlindAuthRateLimitExceededError();
+    explicit BlindAuthRateLimitExceededError(const std::optional<std::string>& detail = std::nullopt);
 };
 
 //=============================================================================
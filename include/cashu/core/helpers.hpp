@@ -5,13 +5,15 @@
 // 100% compatible with nutshell NUT-08 Lightning fee reserve and blank outputs
 
 #include "cashu/core/base.hpp"
+#include "cashu/core/thread_pool.hpp"
 #include <vector>
 #include <string>
 #include <functional>
 #include <future>
+#include <tuple>
+#include <type_traits>
 
 namespace cashu::core::helpers {
-    using namespace boost::multiprecision;
     using namespace cashu::core::base;
 
 /**
@@ -32,8 +34,9 @@ std::string amount_summary(const std::vector<Proof>& proofs, Unit unit);
  * 
  * @param proofs List of proofs to sum
  * @return Total amount in satoshis
+ * @throws std::overflow_error if the total exceeds 64 bits
  */
-cpp_int sum_proofs(const std::vector<Proof>& proofs);
+amount_t sum_proofs(const std::vector<Proof>& proofs);
 
 /**
  * @brief Calculate total amount from list of blinded signatures
@@ -41,8 +44,9 @@ cpp_int sum_proofs(const std::vector<Proof>& proofs);
  * 
  * @param promises List of blinded signatures to sum
  * @return Total amount in satoshis
+ * @throws std::overflow_error if the total exceeds 64 bits
  */
-cpp_int sum_promises(const std::vector<BlindedSignature>& promises);
+amount_t sum_promises(const std::vector<BlindedSignature>& promises);
 
 /**
  * @brief Calculate Lightning fee reserve according to NUT-08
@@ -58,7 +62,7 @@ cpp_int sum_promises(const std::vector<BlindedSignature>& promises);
  * 
  * NUT-08: Lightning fee reserve calculation for overpayment protection
  */
-cpp_int fee_reserve(const cpp_int& amount_msat);
+amount_t fee_reserve(amount_t amount_msat);
 
 /**
  * @brief Calculate number of blank outputs for fee overpayment (NUT-08 core function)
@@ -79,34 +83,40 @@ cpp_int fee_reserve(const cpp_int& amount_msat);
 int calculate_number_of_blank_outputs(int fee_reserve_sat);
 
 /**
- * @brief Async wrapper function for C++ (simplified version)
- * NUTSHELL COMPATIBILITY: Simplified version of nutshell's async_wrap
+ * @brief Run a function on the shared thread pool
+ * NUTSHELL COMPATIBILITY: Equivalent of nutshell's async_wrap, which runs the
+ * function in asyncio's default executor
  * 
  * @param func Function to wrap
+ * @param args Arguments, copied or moved into the task
  * @return Future result
  * 
- * Note: This is a simplified version of nutshell's async_wrap.
- * For full async support, would need boost::asio or similar async framework.
- * Nutshell uses asyncio event loops and thread pool executors.
+ * PERFORMANCE: Submits to ThreadPool::global() instead of std::async, so a
+ * call costs a queue push rather than a new OS thread and concurrency stays
+ * bounded by Settings::thread_pool_size.
  */
 template<typename Func, typename... Args>
-std::future<std::invoke_result_t<Func, Args...>> async_wrap(Func&& func, Args&&... args) {
-    return std::async(std::launch::async, std::forward<Func>(func), std::forward<Args>(args)...);
+std::future<std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>> async_wrap(Func&& func, Args&&... args) {
+    return ThreadPool::global().submit(
+        [func = std::forward<Func>(func), arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable {
+            return std::apply(std::move(func), std::move(arguments));
+        });
 }
 
 /**
- * @brief Async unwrap function (simplified version)
- * NUTSHELL COMPATIBILITY: Simplified version of nutshell's async_unwrap
+ * @brief Wait for an async_wrap result
+ * NUTSHELL COMPATIBILITY: Equivalent of nutshell's async_unwrap
  * 
  * @param future Future to unwrap
  * @return Result value
  * 
- * Note: This is a simplified version of nutshell's async_unwrap.
- * Nutshell uses asyncio.run_until_complete for proper async execution.
+ * On a pool worker, queued tasks run while waiting so nested
+ * async_wrap/async_unwrap calls cannot deadlock the pool. Coroutines should
+ * co_await await_future(...) instead (see task.hpp).
  */
 template<typename T>
 T async_unwrap(std::future<T>& future) {
-    return future.get();
+    return ThreadPool::global().wait(future);
 }
 
 } // namespace cashu::core::helpers
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: produces the same JSON as pydantic .json() on cashu/core/base.py models
+// Append-only JSON writer - ENHANCEMENT beyond nutshell
+// Serializes directly into a caller-owned buffer; reusing the buffer across
+// responses makes steady-state serialization allocation-free
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cashu::core {
+
+/**
+ * @brief Streaming JSON writer appending to a std::string
+ *
+ * Commas between members and elements are inserted automatically; keys and
+ * string values are escaped per RFC 8259. Nesting state is kept in a fixed
+ * bit stack, so the writer itself never allocates.
+ *
+ * Usage:
+ *   std::string buffer;
+ *   JsonWriter w(buffer);
+ *   w.begin_object().key("amount").value(amount_t(8)).end_object();
+ */
+class JsonWriter {
+public:
+    static constexpr size_t MAX_DEPTH = 64;
+
+    /**
+     * @brief Create writer appending to out (existing contents are kept)
+     * @param out Output buffer
+     */
+    explicit JsonWriter(std::string& out) noexcept : out_(out) {}
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /**
+     * @brief Clear buffer and nesting state, keeping buffer capacity
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Reserve additional buffer capacity
+     * @param bytes Expected number of bytes still to be written
+     */
+    void reserve(size_t bytes) { out_.reserve(out_.size() + bytes); }
+
+    // ---- Structure ----
+
+    /**
+     * @throws std::length_error if nesting exceeds MAX_DEPTH
+     */
+    JsonWriter& begin_object();
+    JsonWriter& end_object();
+
+    /**
+     * @throws std::length_error if nesting exceeds MAX_DEPTH
+     */
+    JsonWriter& begin_array();
+    JsonWriter& end_array();
+
+    /**
+     * @brief Write object key (the next call writes its value)
+     * @param name Key, escaped as needed
+     */
+    JsonWriter& key(std::string_view name);
+
+    // ---- Values ----
+
+    JsonWriter& value(std::string_view str);
+    JsonWriter& value(const std::string& str) { return value(std::string_view(str)); }
+    JsonWriter& value(const char* str) { return value(std::string_view(str)); }
+    JsonWriter& value(uint64_t number);
+    JsonWriter& value(int64_t number);
+    JsonWriter& value(int number) { return value(static_cast<int64_t>(number)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& null();
+
+    /**
+     * @brief Write pre-serialized JSON verbatim (caller guarantees validity)
+     * @param json Serialized JSON value
+     */
+    JsonWriter& raw(std::string_view json);
+
+    /**
+     * @brief Write key and value in one call
+     */
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& val) {
+        key(name);
+        return value(val);
+    }
+
+    /**
+     * @brief Append str to out as a quoted, escaped JSON string
+     * @param out Output buffer
+     * @param str Raw string
+     */
+    static void append_escaped(std::string& out, std::string_view str);
+
+    std::string& buffer() noexcept { return out_; }
+    const std::string& buffer() const noexcept { return out_; }
+
+private:
+    std::string& out_;
+    uint64_t has_member_ = 0;   // Bit per depth: current container already has an entry
+    size_t depth_ = 0;
+    bool after_key_ = false;    // Next value belongs to the key just written
+
+    /**
+     * @brief Emit separating comma if needed and mark current container non-empty
+     */
+    void prefix();
+
+    void push();
+    void pop();
+};
+
+} // namespace cashu::core
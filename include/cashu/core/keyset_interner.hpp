@@ -0,0 +1,113 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: keyset ids are plain strings in nutshell (cashu/core/base.py)
+// Keyset ID interning - ENHANCEMENT beyond nutshell
+// Maps keyset ids to compact integer handles once at parse time so hot paths
+// compare and hash integers instead of 16-character strings
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cashu::core {
+
+/**
+ * @brief Compact handle for an interned keyset id
+ *
+ * Handles are process-local: persist the keyset id string, not the handle.
+ */
+struct KeysetHandle {
+    static constexpr uint16_t INVALID = 0xFFFF;
+
+    uint16_t value = INVALID;
+
+    bool valid() const noexcept { return value != INVALID; }
+
+    bool operator==(const KeysetHandle& other) const noexcept { return value == other.value; }
+    bool operator!=(const KeysetHandle& other) const noexcept { return value != other.value; }
+    bool operator<(const KeysetHandle& other) const noexcept { return value < other.value; }
+};
+
+/**
+ * @brief Hash functor for KeysetHandle keys in unordered containers
+ */
+struct KeysetHandleHash {
+    size_t operator()(const KeysetHandle& handle) const noexcept { return handle.value; }
+};
+
+/**
+ * @brief Thread-safe keyset id interner
+ *
+ * Handles are assigned densely from 0 in first-seen order and never reused.
+ * intern() takes a shared lock on the fast path; id() is lock-free.
+ * Interned ids are never freed: intern only keysets the mint or wallet
+ * loads itself and resolve ids from requests and tokens with find().
+ * Both hex ids ("00" + 14 hex chars) and legacy base64 ids are accepted.
+ */
+class KeysetInterner {
+public:
+    static constexpr size_t CAPACITY = KeysetHandle::INVALID;  // Handles 0 .. 65534
+
+    KeysetInterner() = default;
+    ~KeysetInterner();
+
+    KeysetInterner(const KeysetInterner&) = delete;
+    KeysetInterner& operator=(const KeysetInterner&) = delete;
+
+    /**
+     * @brief Process-wide interner used by base types and batches
+     */
+    static KeysetInterner& global();
+
+    /**
+     * @brief Get handle for keyset id, assigning one on first use
+     * @param id Keyset ID
+     * @return Handle for id
+     * @throws std::invalid_argument if id is empty
+     * @throws std::length_error if CAPACITY ids are already interned
+     */
+    KeysetHandle intern(std::string_view id);
+
+    /**
+     * @brief Look up handle without interning
+     * @param id Keyset ID
+     * @return Handle, or nullopt if id was never interned
+     */
+    std::optional<KeysetHandle> find(std::string_view id) const;
+
+    /**
+     * @brief Keyset id for handle
+     * @param handle Handle returned by intern()
+     * @return Keyset ID (reference stays valid for the interner's lifetime)
+     * @throws std::out_of_range if handle was not issued by this interner
+     */
+    const std::string& id(KeysetHandle handle) const;
+
+    /**
+     * @brief Number of interned ids
+     */
+    size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 256;
+    static constexpr size_t CHUNK_COUNT = (CAPACITY + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint16_t> lookup_;  // Views into chunk storage
+    std::array<std::atomic<std::string*>, CHUNK_COUNT> chunks_{};  // Stable id storage
+    std::atomic<size_t> size_{0};
+};
+
+} // namespace cashu::core
+
+namespace std {
+template<>
+struct hash<cashu::core::KeysetHandle> : cashu::core::KeysetHandleHash {};
+}
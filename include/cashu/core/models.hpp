@@ -3,21 +3,24 @@
 // NUTSHELL COMPATIBILITY: cashu/mint/crud.py + cashu/wallet/crud.py  
 // Database models and schemas for 100% nutshell compatibility
 // Reference: Complete database schema analysis from nutshell codebase
+// Each model's static fields() schema drives its to_json/from_json, binary
+// rows and column metadata (see schema.hpp)
 
+#include "cashu/core/amount.hpp"
 #include "cashu/core/base.hpp"
 #include "cashu/core/settings.hpp"
 #include "cashu/core/errors.hpp"
-#include <boost/multiprecision/cpp_int.hpp>
+#include "cashu/core/schema.hpp"
 #include <string>
 #include <vector>
 #include <optional>
 #include <unordered_map>
 #include <chrono>
+#include <tuple>
 #include <nlohmann/json.hpp>
 
 namespace cashu::core::models {
 
-using namespace boost::multiprecision;
 using json = nlohmann::json;
 using timestamp_t = std::chrono::system_clock::time_point;
 
@@ -85,6 +88,12 @@ struct DBVersion {
     std::string db;          // Database name/type
     int version;             // Current schema version
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("db", &DBVersion::db),
+            schema::field("version", &DBVersion::version));
+    }
+    
     // JSON serialization
     json to_json() const;
     static DBVersion from_json(const json& j);
@@ -112,8 +121,27 @@ struct MintKeyset {
     std::string unit;                           // Currency unit
     std::optional<int> input_fee_ppk;           // Input fee per thousand
     std::string amounts;                        // JSON array of supported amounts
-    cpp_int balance = 0;                        // Current balance
-    cpp_int fees_paid = 0;                      // Total fees paid
+    amount_t balance = 0;                       // Current balance
+    amount_t fees_paid = 0;                     // Total fees paid
+    
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("id", &MintKeyset::id),
+            schema::field("derivation_path", &MintKeyset::derivation_path),
+            schema::field("seed", &MintKeyset::seed),
+            schema::field("encrypted_seed", &MintKeyset::encrypted_seed),
+            schema::field("seed_encryption_method", &MintKeyset::seed_encryption_method),
+            schema::field("valid_from", &MintKeyset::valid_from),
+            schema::field("valid_to", &MintKeyset::valid_to),
+            schema::field("first_seen", &MintKeyset::first_seen),
+            schema::field("active", &MintKeyset::active),
+            schema::field("version", &MintKeyset::version),
+            schema::field("unit", &MintKeyset::unit),
+            schema::field("input_fee_ppk", &MintKeyset::input_fee_ppk),
+            schema::field("amounts", &MintKeyset::amounts),
+            schema::field("balance", &MintKeyset::balance),
+            schema::field("fees_paid", &MintKeyset::fees_paid));
+    }
     
     // JSON serialization
     json to_json() const;
@@ -126,9 +154,16 @@ struct MintKeyset {
  */
 struct MintPubkey {
     std::string id;                 // Keyset ID reference
-    cpp_int amount;                 // Amount denomination
+    amount_t amount;                // Amount denomination
     std::string pubkey;             // Public key hex
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("id", &MintPubkey::id),
+            schema::field("amount", &MintPubkey::amount),
+            schema::field("pubkey", &MintPubkey::pubkey));
+    }
+    
     // JSON serialization
     json to_json() const;
     static MintPubkey from_json(const json& j);
@@ -139,7 +174,7 @@ struct MintPubkey {
  * Table: promises
  */
 struct Promise {
-    cpp_int amount;                             // Promise amount
+    amount_t amount;                            // Promise amount
     std::optional<std::string> id;              // Keyset ID
     std::string b_;                             // Blinded message (B_)
     std::string c_;                             // Blinded signature (C_)
@@ -149,6 +184,19 @@ struct Promise {
     std::optional<std::string> mint_quote;     // Associated mint quote
     std::optional<std::string> swap_id;        // Swap operation ID
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &Promise::amount),
+            schema::field("id", &Promise::id),
+            schema::field("b_", &Promise::b_),
+            schema::field("c_", &Promise::c_),
+            schema::field("dleq_e", &Promise::dleq_e),
+            schema::field("dleq_s", &Promise::dleq_s),
+            schema::field("created", &Promise::created),
+            schema::field("mint_quote", &Promise::mint_quote),
+            schema::field("swap_id", &Promise::swap_id));
+    }
+    
     // JSON serialization
     json to_json() const;
     static Promise from_json(const json& j);
@@ -159,7 +207,7 @@ struct Promise {
  * Table: proofs_used
  */
 struct ProofUsed {
-    cpp_int amount;                             // Proof amount
+    amount_t amount;                            // Proof amount
     std::optional<std::string> id;              // Keyset ID
     std::string c;                              // Unblinded signature
     std::string secret;                         // Proof secret
@@ -168,6 +216,18 @@ struct ProofUsed {
     std::optional<timestamp_t> created;        // When proof was created
     std::optional<std::string> melt_quote;     // Associated melt quote
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &ProofUsed::amount),
+            schema::field("id", &ProofUsed::id),
+            schema::field("c", &ProofUsed::c),
+            schema::field("secret", &ProofUsed::secret),
+            schema::field("y", &ProofUsed::y),
+            schema::field("witness", &ProofUsed::witness),
+            schema::field("created", &ProofUsed::created),
+            schema::field("melt_quote", &ProofUsed::melt_quote));
+    }
+    
     // JSON serialization
     json to_json() const;
     static ProofUsed from_json(const json& j);
@@ -178,7 +238,7 @@ struct ProofUsed {
  * Table: proofs_pending
  */
 struct ProofPending {
-    cpp_int amount;                             // Proof amount
+    amount_t amount;                            // Proof amount
     std::optional<std::string> id;              // Keyset ID
     std::string c;                              // Unblinded signature
     std::string secret;                         // Proof secret
@@ -187,6 +247,18 @@ struct ProofPending {
     timestamp_t created;                        // Creation timestamp (default NOW())
     std::optional<std::string> melt_quote;     // Associated melt quote
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &ProofPending::amount),
+            schema::field("id", &ProofPending::id),
+            schema::field("c", &ProofPending::c),
+            schema::field("secret", &ProofPending::secret),
+            schema::field("y", &ProofPending::y),
+            schema::field("witness", &ProofPending::witness),
+            schema::field("created", &ProofPending::created),
+            schema::field("melt_quote", &ProofPending::melt_quote));
+    }
+    
     // JSON serialization
     json to_json() const;
     static ProofPending from_json(const json& j);
@@ -202,7 +274,7 @@ struct MintQuote {
     std::string request;                        // Lightning invoice
     std::string checking_id;                    // Payment checking ID
     std::string unit;                           // Currency unit
-    cpp_int amount;                             // Quote amount
+    amount_t amount;                            // Quote amount
     bool paid;                                  // Whether invoice is paid
     bool issued;                                // Whether tokens were issued
     std::optional<timestamp_t> created_time;   // Quote creation time
@@ -210,6 +282,22 @@ struct MintQuote {
     std::optional<std::string> state;          // Quote state (UNPAID/PAID/PENDING/ISSUED)
     std::optional<std::string> pubkey;         // NUT-20 quote lock pubkey
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("quote", &MintQuote::quote),
+            schema::field("method", &MintQuote::method),
+            schema::field("request", &MintQuote::request),
+            schema::field("checking_id", &MintQuote::checking_id),
+            schema::field("unit", &MintQuote::unit),
+            schema::field("amount", &MintQuote::amount),
+            schema::field("paid", &MintQuote::paid),
+            schema::field("issued", &MintQuote::issued),
+            schema::field("created_time", &MintQuote::created_time),
+            schema::field("paid_time", &MintQuote::paid_time),
+            schema::field("state", &MintQuote::state),
+            schema::field("pubkey", &MintQuote::pubkey));
+    }
+    
     // JSON serialization
     json to_json() const;
     static MintQuote from_json(const json& j);
@@ -225,12 +313,12 @@ struct MeltQuote {
     std::string request;                        // Lightning payment request
     std::string checking_id;                    // Payment checking ID
     std::string unit;                           // Currency unit
-    cpp_int amount;                             // Input amount
-    std::optional<cpp_int> fee_reserve;         // Reserved fee amount
+    amount_t amount;                            // Input amount
+    std::optional<amount_t> fee_reserve;        // Reserved fee amount
     bool paid;                                  // Whether payment succeeded
     std::optional<timestamp_t> created_time;   // Quote creation time
     std::optional<timestamp_t> paid_time;      // Payment completion time
-    std::optional<cpp_int> fee_paid;            // Actual fee paid
+    std::optional<amount_t> fee_paid;           // Actual fee paid
     std::optional<std::string> proof;          // Payment proof/preimage
     std::optional<std::string> state;          // Quote state (UNPAID/PENDING/PAID)
     std::optional<std::string> payment_preimage; // Lightning payment preimage
@@ -238,6 +326,27 @@ struct MeltQuote {
     std::optional<timestamp_t> expiry;         // Quote expiration
     std::optional<std::string> outputs;        // JSON blinded outputs for change
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("quote", &MeltQuote::quote),
+            schema::field("method", &MeltQuote::method),
+            schema::field("request", &MeltQuote::request),
+            schema::field("checking_id", &MeltQuote::checking_id),
+            schema::field("unit", &MeltQuote::unit),
+            schema::field("amount", &MeltQuote::amount),
+            schema::field("fee_reserve", &MeltQuote::fee_reserve),
+            schema::field("paid", &MeltQuote::paid),
+            schema::field("created_time", &MeltQuote::created_time),
+            schema::field("paid_time", &MeltQuote::paid_time),
+            schema::field("fee_paid", &MeltQuote::fee_paid),
+            schema::field("proof", &MeltQuote::proof),
+            schema::field("state", &MeltQuote::state),
+            schema::field("payment_preimage", &MeltQuote::payment_preimage),
+            schema::field("change", &MeltQuote::change),
+            schema::field("expiry", &MeltQuote::expiry),
+            schema::field("outputs", &MeltQuote::outputs));
+    }
+    
     // JSON serialization
     json to_json() const;
     static MeltQuote from_json(const json& j);
@@ -254,6 +363,15 @@ struct BalanceLog {
     int backend_balance;                        // Backend balance snapshot
     timestamp_t time;                           // Log timestamp (default NOW())
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("unit", &BalanceLog::unit),
+            schema::field("keyset_balance", &BalanceLog::keyset_balance),
+            schema::field("keyset_fees_paid", &BalanceLog::keyset_fees_paid),
+            schema::field("backend_balance", &BalanceLog::backend_balance),
+            schema::field("time", &BalanceLog::time));
+    }
+    
     // JSON serialization
     json to_json() const;
     static BalanceLog from_json(const json& j);
@@ -268,7 +386,7 @@ struct BalanceLog {
  * Table: proofs (wallet context)
  */
 struct WalletProof {
-    cpp_int amount;                             // Proof amount
+    amount_t amount;                            // Proof amount
     std::string C;                              // Unblinded signature (note: uppercase C)
     std::string secret;                         // Proof secret
     std::optional<std::string> id;              // Keyset ID
@@ -281,6 +399,22 @@ struct WalletProof {
     std::optional<std::string> mint_id;         // Mint operation ID
     std::optional<std::string> melt_id;         // Melt operation ID
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &WalletProof::amount),
+            schema::field("C", &WalletProof::C),
+            schema::field("secret", &WalletProof::secret),
+            schema::field("id", &WalletProof::id),
+            schema::field("reserved", &WalletProof::reserved),
+            schema::field("send_id", &WalletProof::send_id),
+            schema::field("time_created", &WalletProof::time_created),
+            schema::field("time_reserved", &WalletProof::time_reserved),
+            schema::field("derivation_path", &WalletProof::derivation_path),
+            schema::field("dleq", &WalletProof::dleq),
+            schema::field("mint_id", &WalletProof::mint_id),
+            schema::field("melt_id", &WalletProof::melt_id));
+    }
+    
     // JSON serialization
     json to_json() const;
     static WalletProof from_json(const json& j);
@@ -291,7 +425,7 @@ struct WalletProof {
  * Table: proofs_used (wallet context)
  */
 struct WalletProofUsed {
-    cpp_int amount;                             // Proof amount
+    amount_t amount;                            // Proof amount
     std::string C;                              // Unblinded signature (note: uppercase C)
     std::string secret;                         // Proof secret
     std::optional<std::string> id;              // Keyset ID
@@ -300,6 +434,18 @@ struct WalletProofUsed {
     std::optional<std::string> mint_id;         // Mint operation ID
     std::optional<std::string> melt_id;         // Melt operation ID
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &WalletProofUsed::amount),
+            schema::field("C", &WalletProofUsed::C),
+            schema::field("secret", &WalletProofUsed::secret),
+            schema::field("id", &WalletProofUsed::id),
+            schema::field("time_used", &WalletProofUsed::time_used),
+            schema::field("derivation_path", &WalletProofUsed::derivation_path),
+            schema::field("mint_id", &WalletProofUsed::mint_id),
+            schema::field("melt_id", &WalletProofUsed::melt_id));
+    }
+    
     // JSON serialization
     json to_json() const;
     static WalletProofUsed from_json(const json& j);
@@ -321,6 +467,20 @@ struct WalletKeyset {
     std::optional<std::string> unit;            // Currency unit
     std::optional<int> input_fee_ppk;           // Input fee per thousand
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("id", &WalletKeyset::id),
+            schema::field("mint_url", &WalletKeyset::mint_url),
+            schema::field("valid_from", &WalletKeyset::valid_from),
+            schema::field("valid_to", &WalletKeyset::valid_to),
+            schema::field("first_seen", &WalletKeyset::first_seen),
+            schema::field("active", &WalletKeyset::active),
+            schema::field("public_keys", &WalletKeyset::public_keys),
+            schema::field("counter", &WalletKeyset::counter),
+            schema::field("unit", &WalletKeyset::unit),
+            schema::field("input_fee_ppk", &WalletKeyset::input_fee_ppk));
+    }
+    
     // JSON serialization
     json to_json() const;
     static WalletKeyset from_json(const json& j);
@@ -341,6 +501,19 @@ struct Invoice {
     timestamp_t time_paid;                      // Payment time (default NOW())
     std::optional<bool> out;                    // Outgoing (TRUE) or incoming (FALSE)
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("amount", &Invoice::amount),
+            schema::field("bolt11", &Invoice::bolt11),
+            schema::field("id", &Invoice::id),
+            schema::field("payment_hash", &Invoice::payment_hash),
+            schema::field("preimage", &Invoice::preimage),
+            schema::field("paid", &Invoice::paid),
+            schema::field("time_created", &Invoice::time_created),
+            schema::field("time_paid", &Invoice::time_paid),
+            schema::field("out", &Invoice::out));
+    }
+    
     // JSON serialization
     json to_json() const;
     static Invoice from_json(const json& j);
@@ -354,6 +527,12 @@ struct Seed {
     std::string seed;                           // Master seed
     std::string mnemonic;                       // BIP39 mnemonic
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("seed", &Seed::seed),
+            schema::field("mnemonic", &Seed::mnemonic));
+    }
+    
     // JSON serialization
     json to_json() const;
     static Seed from_json(const json& j);
@@ -377,6 +556,22 @@ struct WalletMintQuote {
     std::optional<int> expiry;                  // Expiry timestamp
     std::optional<std::string> privkey;         // Private key for NUT-20
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("quote", &WalletMintQuote::quote),
+            schema::field("mint", &WalletMintQuote::mint),
+            schema::field("method", &WalletMintQuote::method),
+            schema::field("request", &WalletMintQuote::request),
+            schema::field("checking_id", &WalletMintQuote::checking_id),
+            schema::field("unit", &WalletMintQuote::unit),
+            schema::field("amount", &WalletMintQuote::amount),
+            schema::field("state", &WalletMintQuote::state),
+            schema::field("created_time", &WalletMintQuote::created_time),
+            schema::field("paid_time", &WalletMintQuote::paid_time),
+            schema::field("expiry", &WalletMintQuote::expiry),
+            schema::field("privkey", &WalletMintQuote::privkey));
+    }
+    
     // JSON serialization
     json to_json() const;
     static WalletMintQuote from_json(const json& j);
@@ -403,6 +598,25 @@ struct WalletMeltQuote {
     std::optional<int> expiry;                  // Expiry timestamp
     std::optional<std::string> change;          // Change signatures JSON
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("quote", &WalletMeltQuote::quote),
+            schema::field("mint", &WalletMeltQuote::mint),
+            schema::field("method", &WalletMeltQuote::method),
+            schema::field("request", &WalletMeltQuote::request),
+            schema::field("checking_id", &WalletMeltQuote::checking_id),
+            schema::field("unit", &WalletMeltQuote::unit),
+            schema::field("amount", &WalletMeltQuote::amount),
+            schema::field("fee_reserve", &WalletMeltQuote::fee_reserve),
+            schema::field("state", &WalletMeltQuote::state),
+            schema::field("created_time", &WalletMeltQuote::created_time),
+            schema::field("paid_time", &WalletMeltQuote::paid_time),
+            schema::field("fee_paid", &WalletMeltQuote::fee_paid),
+            schema::field("payment_preimage", &WalletMeltQuote::payment_preimage),
+            schema::field("expiry", &WalletMeltQuote::expiry),
+            schema::field("change", &WalletMeltQuote::change));
+    }
+    
     // JSON serialization
     json to_json() const;
     static WalletMeltQuote from_json(const json& j);
@@ -416,6 +630,12 @@ struct NostrState {
     std::string type;                           // Operation type
     std::optional<timestamp_t> last;            // Last operation timestamp
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("type", &NostrState::type),
+            schema::field("last", &NostrState::last));
+    }
+    
     // JSON serialization
     json to_json() const;
     static NostrState from_json(const json& j);
@@ -435,6 +655,18 @@ struct Mint {
     std::optional<std::string> username;        // Basic auth username
     std::optional<std::string> password;        // Basic auth password
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("id", &Mint::id),
+            schema::field("url", &Mint::url),
+            schema::field("info", &Mint::info),
+            schema::field("updated", &Mint::updated),
+            schema::field("access_token", &Mint::access_token),
+            schema::field("refresh_token", &Mint::refresh_token),
+            schema::field("username", &Mint::username),
+            schema::field("password", &Mint::password));
+    }
+    
     // JSON serialization
     json to_json() const;
     static Mint from_json(const json& j);
@@ -452,6 +684,12 @@ struct User {
     std::string id;                             // User identifier (PRIMARY KEY)
     std::optional<timestamp_t> last_access;    // Last access time
     
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("id", &User::id),
+            schema::field("last_access", &User::last_access));
+    }
+    
     // JSON serialization
     json to_json() const;
     static User from_json(const json& j);
@@ -466,7 +704,13 @@ struct User {
  */
 struct Balance {
     std::string keyset;                         // Keyset identifier
-    cpp_int balance;                            // Net balance (issued - redeemed)
+    int64_t balance;                            // Net balance (issued - redeemed)
+    
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("keyset", &Balance::keyset),
+            schema::field("balance", &Balance::balance));
+    }
     
     // JSON serialization
     json to_json() const;
@@ -478,7 +722,13 @@ struct Balance {
  */
 struct BalanceIssued {
     std::string keyset;                         // Keyset identifier
-    cpp_int balance;                            // Total issued amount
+    amount_t balance;                           // Total issued amount
+    
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("keyset", &BalanceIssued::keyset),
+            schema::field("balance", &BalanceIssued::balance));
+    }
     
     // JSON serialization
     json to_json() const;
@@ -490,7 +740,13 @@ struct BalanceIssued {
  */
 struct BalanceRedeemed {
     std::string keyset;                         // Keyset identifier
-    cpp_int balance;                            // Total redeemed amount
+    amount_t balance;                           // Total redeemed amount
+    
+    static constexpr auto fields() {
+        return std::make_tuple(
+            schema::field("keyset", &BalanceRedeemed::keyset),
+            schema::field("balance", &BalanceRedeemed::balance));
+    }
     
     // JSON serialization
     json to_json() const;
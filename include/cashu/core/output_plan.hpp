@@ -0,0 +1,191 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: amount_split in cashu/core/split.py, get_fees_for_proofs in
+// cashu/mint/verification.py and cashu/wallet/wallet.py, fee_reserve and
+// calculate_number_of_blank_outputs in cashu/core/helpers.py
+// Integer output planning - ENHANCEMENT beyond nutshell
+// Splits, input fees and NUT-08 blank-output counts are computed on uint64_t
+// with bit scans and popcount instead of big integers and floating-point log2,
+// and batch variants fill one preallocated plan for many amounts at once.
+
+#include "cashu/core/amount.hpp"
+#include "cashu/core/crypto/denominations.hpp"
+#include "cashu/core/keyset_interner.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cashu::core {
+
+// Bit scans live in denominations.hpp next to lowest_bit_index
+using crypto::popcount;
+using crypto::highest_bit_index;
+
+/**
+ * @brief Number of outputs in the power-of-two split of amount
+ */
+inline size_t split_count(amount_t amount) noexcept {
+    return popcount(amount);
+}
+
+/**
+ * @brief Write the power-of-two split of amount in ascending order
+ * @param amount Amount to split
+ * @param out Buffer of at least split_count(amount) amounts
+ * @return Pointer past the last written amount
+ */
+inline amount_t* split_into(amount_t amount, amount_t* out) noexcept {
+    for (; amount != 0; amount &= amount - 1) {
+        *out++ = amount_t(1) << crypto::lowest_bit_index(amount);
+    }
+    return out;
+}
+
+/**
+ * @brief Split amount into powers of two
+ * NUTSHELL COMPATIBILITY: Matches amount_split(), ascending order
+ * @param amount Amount to split
+ * @return Denominations in ascending order (empty for 0)
+ */
+std::vector<amount_t> amount_split(amount_t amount);
+
+/**
+ * @brief Input fee for a sum of per-proof fees: ceil(fee_ppk_sum / 1000)
+ * NUTSHELL COMPATIBILITY: Matches the rounding of get_fees_for_proofs()
+ */
+inline amount_t input_fee(uint64_t fee_ppk_sum) noexcept {
+    return fee_ppk_sum / 1000 + (fee_ppk_sum % 1000 != 0 ? 1 : 0);
+}
+
+/**
+ * @brief Number of NUT-08 blank outputs for a fee reserve: max(ceil(log2(fee_reserve)), 1), 0 for 0
+ * NUTSHELL COMPATIBILITY: Matches calculate_number_of_blank_outputs()
+ *
+ * Computed exactly as the bit width of fee_reserve - 1, which avoids the
+ * rounding of log2 on large reserves.
+ */
+inline size_t blank_output_count(amount_t fee_reserve) noexcept {
+    if (fee_reserve <= 2) {
+        return fee_reserve == 0 ? 0 : 1;
+    }
+    return highest_bit_index(fee_reserve - 1) + 1;
+}
+
+/**
+ * @brief Lightning fee reserve: max(fee_min, amount * fee_basis_points / 10000)
+ * NUTSHELL COMPATIBILITY: Matches fee_reserve() with lightning_fee_percent = fee_basis_points / 100
+ *
+ * The percentage is taken without an intermediate product, so it cannot overflow.
+ *
+ * @param amount_msat Amount in millisatoshis
+ * @param fee_min_msat Minimum reserve in millisatoshis
+ * @param fee_basis_points Fee in hundredths of a percent
+ * @return Fee reserve in millisatoshis
+ */
+amount_t lightning_fee_reserve(amount_t amount_msat, amount_t fee_min_msat, uint32_t fee_basis_points);
+
+/**
+ * @brief Input fees per keyset, indexed directly by keyset handle
+ */
+class InputFeeTable {
+public:
+    /**
+     * @brief Set the fee of a keyset
+     * @param keyset Keyset handle
+     * @param fee_ppk Fee per input in parts per thousand
+     */
+    void set(KeysetHandle keyset, uint32_t fee_ppk);
+
+    /**
+     * @brief Fee of a keyset (0 if never set)
+     */
+    uint32_t get(KeysetHandle keyset) const noexcept {
+        return keyset.value < fee_ppk_.size() ? fee_ppk_[keyset.value] : 0;
+    }
+
+    /**
+     * @brief Sum of per-input fees of a set of inputs, in parts per thousand
+     * @param keysets Keyset of every input
+     */
+    uint64_t fee_ppk(const std::vector<KeysetHandle>& keysets) const noexcept;
+
+    /**
+     * @brief Input fee of a set of inputs: ceil(sum of fee_ppk / 1000)
+     * @param keysets Keyset of every input (e.g. ProofBatch::keysets())
+     */
+    amount_t fee(const std::vector<KeysetHandle>& keysets) const noexcept {
+        return input_fee(fee_ppk(keysets));
+    }
+
+private:
+    std::vector<uint32_t> fee_ppk_;
+};
+
+/**
+ * @brief Power-of-two splits of many amounts in one flat buffer
+ *
+ * Output amounts of request i are outputs()[offset(i)] .. outputs()[offset(i + 1) - 1],
+ * in ascending order. Reusing a plan keeps its storage, so planning a batch
+ * of the same shape again does not allocate.
+ */
+class OutputPlan {
+public:
+    /**
+     * @brief Plan the splits of amounts, replacing the current plan
+     * @param amounts Amounts to split
+     * @param count Number of amounts
+     */
+    void plan(const amount_t* amounts, size_t count);
+
+    /**
+     * @brief Plan the splits of amounts, replacing the current plan
+     */
+    void plan(const std::vector<amount_t>& amounts) { plan(amounts.data(), amounts.size()); }
+
+    /**
+     * @brief Plan NUT-08 blank outputs for fee reserves, replacing the current plan
+     *
+     * Blank outputs carry no amount (nutshell uses 1 as a placeholder); every
+     * entry of the plan is set to 1.
+     *
+     * @param fee_reserves Fee reserves of the melts
+     * @param count Number of melts
+     */
+    void plan_blank(const amount_t* fee_reserves, size_t count);
+
+    /**
+     * @brief Number of planned requests
+     */
+    size_t size() const noexcept { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    /**
+     * @brief All planned outputs, request by request
+     */
+    const std::vector<amount_t>& outputs() const noexcept { return outputs_; }
+
+    /**
+     * @brief Index of the first output of request i; offset(size()) is outputs().size()
+     */
+    size_t offset(size_t i) const { return offsets_[i]; }
+
+    /**
+     * @brief Number of outputs of request i
+     */
+    size_t count(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+    /**
+     * @brief First output of request i
+     */
+    const amount_t* begin(size_t i) const { return outputs_.data() + offsets_[i]; }
+
+    /**
+     * @brief Past the last output of request i
+     */
+    const amount_t* end(size_t i) const { return outputs_.data() + offsets_[i + 1]; }
+
+private:
+    std::vector<amount_t> outputs_;
+    std::vector<size_t> offsets_;
+};
+
+} // namespace cashu::core
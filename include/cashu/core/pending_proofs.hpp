@@ -0,0 +1,140 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: db_write._set_proofs_pending / _unset_proofs_pending and
+// the proofs_pending table (ProofPending in cashu/core/models.py)
+// Striped pending-proof manager - ENHANCEMENT beyond nutshell
+// Inputs of a melt are reserved while its Lightning payment is in flight.
+// Nutshell serializes this behind one database lock. Here each Y maps to
+// one of many lock stripes, and a melt locks only the stripes of its own
+// inputs, so melts with disjoint inputs never wait for each other.
+
+#include "cashu/core/models.hpp"
+#include "cashu/core/point_hash.hpp"
+#include "cashu/core/proof_batch.hpp"
+#include "cashu/core/result.hpp"
+#include "cashu/core/spent_index.hpp"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cashu::core {
+
+/**
+ * @brief Inputs of in-flight melts, keyed by binary Y and grouped by melt quote
+ *
+ * All operations are thread-safe. Each quote holds at most one input set.
+ */
+class PendingProofs {
+public:
+    /**
+     * @param stripes Number of lock stripes (rounded up to a power of two)
+     */
+    explicit PendingProofs(size_t stripes = 256);
+    ~PendingProofs();
+
+    PendingProofs(const PendingProofs&) = delete;
+    PendingProofs& operator=(const PendingProofs&) = delete;
+
+    /**
+     * @brief Mark all inputs of a melt pending, or none
+     *
+     * The stripes of all inputs are locked together (in ascending order), so
+     * no other melt observes part of the set. The quote's inputs are
+     * published only after every Y is pending; until then release() and
+     * inputs_of() treat the quote as holding none. On failure nothing changes.
+     *
+     * @param quote Melt quote id
+     * @param Ys Compressed hash_to_curve(secret) of every input
+     * @param count Number of inputs
+     * @return Success; TRANSACTION ("no proofs provided.") if count is 0;
+     *         QUOTE_PENDING if the quote already holds or is reserving inputs;
+     *         TRANSACTION_DUPLICATE_INPUTS if a Y occurs twice; TRANSACTION
+     *         ("proofs are pending.") if an input is pending for another quote
+     */
+    Result<void> try_mark_pending(const std::string& quote, const base::Point33* Ys, size_t count);
+
+    /**
+     * @brief Mark all inputs of a melt pending, or none
+     */
+    Result<void> try_mark_pending(const std::string& quote, const std::vector<base::Point33>& Ys) {
+        return try_mark_pending(quote, Ys.data(), Ys.size());
+    }
+
+    /**
+     * @brief Mark all inputs of a batch pending, or none
+     * @throws std::logic_error if some rows still lack Y
+     */
+    Result<void> try_mark_pending(const std::string& quote, const base::ProofBatch& proofs);
+
+    /**
+     * @brief Mark all inputs of a batch pending, or none
+     * @throws QuotePendingError, TransactionDuplicateInputsError or TransactionError
+     *         for the errors of try_mark_pending()
+     */
+    void mark_pending(const std::string& quote, const base::ProofBatch& proofs);
+
+    /**
+     * @brief Release the inputs of a melt (payment settled or failed)
+     * @param quote Melt quote id
+     * @return Number of released inputs (0 if the quote holds none)
+     */
+    size_t release(const std::string& quote);
+
+    /**
+     * @brief Whether Y is pending
+     */
+    bool is_pending(const base::Point33& Y) const;
+
+    /**
+     * @brief Melt quote holding Y, if Y is pending
+     */
+    std::optional<std::string> quote_of(const base::Point33& Y) const;
+
+    /**
+     * @brief Inputs a quote holds (empty if none)
+     */
+    std::vector<base::Point33> inputs_of(const std::string& quote) const;
+
+    /**
+     * @brief NUT-07 state of Y
+     * NUTSHELL COMPATIBILITY: Matches db_read.get_proofs_states (spent before pending)
+     * @param Y Compressed hash_to_curve(secret)
+     * @param spent Spent-proof index
+     */
+    models::ProofSpentState state(const base::Point33& Y, const SpentIndex& spent) const;
+
+    /**
+     * @brief Restore pending inputs from proofs_pending rows (startup)
+     *
+     * Rows are grouped by melt_quote (rows without one form the "" group).
+     * The y column is used if present; otherwise the secret is hashed.
+     *
+     * @param proofs Rows of proofs_pending
+     * @return Number of restored inputs
+     * @throws std::invalid_argument if a y column is not a 33-byte compressed point hex
+     * @throws TransactionError if a Y occurs twice
+     */
+    size_t load(const std::vector<models::ProofPending>& proofs);
+
+    /**
+     * @brief Number of pending inputs
+     */
+    size_t size() const;
+
+private:
+    struct Stripe;
+    struct QuoteStripe;
+
+    std::unique_ptr<Stripe[]> stripes_;
+    size_t stripe_mask_;
+    std::unique_ptr<QuoteStripe[]> quote_stripes_;
+    size_t quote_stripe_mask_;
+    PointHash hasher_;  // Seeded, so clients cannot grind inputs into one stripe
+
+    Stripe& stripe(const base::Point33& Y) const noexcept;
+    QuoteStripe& quote_stripe(const std::string& quote) const noexcept;
+};
+
+} // namespace cashu::core
@@ -0,0 +1,74 @@
+#pragma once
+
+// Seeded hashing of binary Y - ENHANCEMENT beyond nutshell
+// Shared by the hash tables and lock stripes keyed by Y (SpentIndex,
+// PendingProofs)
+
+#include "cashu/core/base.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace cashu::core {
+
+/**
+ * @brief Smallest power of two not below value (1 for 0)
+ *
+ * Table, shard and stripe counts are powers of two so a hash word can be masked.
+ */
+size_t next_power_of_two(size_t value) noexcept;
+
+/**
+ * @brief Seeded hash of a compressed point
+ *
+ * Y is uniform, but clients choose the secrets behind it. Without a secret
+ * per-instance seed they could grind secrets whose Ys share a bucket, probe
+ * sequence or lock stripe. word(Y, i) hashes the i-th 8-byte word of the
+ * x coordinate, so the four words are independent of each other.
+ */
+class PointHash {
+public:
+    static constexpr size_t WORDS = 4;
+
+    /**
+     * @brief Hash with a random seed
+     */
+    PointHash();
+
+    explicit PointHash(uint64_t seed) noexcept : seed_(seed) {}
+
+    /**
+     * @brief Seeded hash of one x-coordinate word
+     * @param Y Compressed point
+     * @param i Word index (0 .. WORDS - 1)
+     */
+    uint64_t word(const base::Point33& Y, size_t i) const noexcept {
+        return mix(load_le64(&Y[1 + 8 * i]) ^ seed_ ^ Y[0]);
+    }
+
+    size_t operator()(const base::Point33& Y) const noexcept {
+        return static_cast<size_t>(word(Y, 0));
+    }
+
+private:
+    uint64_t seed_;
+
+    static uint64_t load_le64(const uint8_t* data) noexcept {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t value) noexcept {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    }
+};
+
+} // namespace cashu::core
@@ -0,0 +1,241 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: columnar form of List[Proof] from cashu/core/base.py
+// Struct-of-arrays proof container - ENHANCEMENT beyond nutshell
+// Used on hot paths (batch verification, duplicate detection, summing);
+// converts to and from std::vector<Proof> at the API edge
+
+#include "cashu/core/base.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cashu::core::base {
+
+/**
+ * @brief Proofs stored column by column
+ *
+ * Columns:
+ *   keyset        KeysetHandle from KeysetInterner::global()
+ *   amount        amount_t
+ *   C, Y          33-byte compressed points
+ *   secret        offsets into one contiguous arena
+ *   witness/dleq  optional per proof
+ *
+ * Only protocol fields are carried; wallet bookkeeping fields (reserved,
+ * send_id, time_*, mint_id, melt_id, derivation_path) are not.
+ */
+class ProofBatch {
+public:
+    ProofBatch() = default;
+
+    /**
+     * @brief Build batch from proofs
+     *
+     * Proofs without a cached Y are hashed in parallel.
+     *
+     * @param proofs Proofs to convert
+     * @return Batch with one row per proof, in order
+     * @throws std::invalid_argument if C is not a compressed point hex or the keyset id is empty
+     */
+    static ProofBatch from_proofs(const std::vector<Proof>& proofs);
+
+    /**
+     * @brief Convert back to proofs (Y is carried over, not recomputed)
+     * @return Proofs in batch order
+     */
+    std::vector<Proof> to_proofs() const;
+
+    /**
+     * @brief Reserve capacity
+     * @param count Number of proofs
+     * @param secret_bytes Total secret bytes (0 to estimate 64 per proof)
+     */
+    void reserve(size_t count, size_t secret_bytes = 0);
+
+    /**
+     * @brief Remove all rows, keeping column capacity for reuse
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Append one proof (computes Y if the proof has none)
+     * @param proof Proof to append
+     * @throws std::invalid_argument if C is not a compressed point hex
+     * @throws KeysetNotFoundError if the keyset id was never interned
+     */
+    void push_back(const Proof& proof);
+
+    /**
+     * @brief Append one already-decoded proof without hashing its secret
+     *
+     * Y stays unset until compute_pending_Y(); used by parsers that fill the
+     * batch row by row and hash everything at the end in parallel.
+     *
+     * @param keyset Interned keyset id
+     * @param amount Proof amount
+     * @param secret Proof secret
+     * @param C Unblinded signature
+     * @param witness Optional witness
+     * @param dleq Optional DLEQ proof
+     * @throws std::length_error if the secret arena would exceed 4 GiB
+     */
+    void push_back_unhashed(KeysetHandle keyset, amount_t amount, std::string_view secret, const Point33& C,
+                            std::optional<std::string> witness = std::nullopt,
+                            std::optional<DLEQWallet> dleq = std::nullopt);
+
+    /**
+     * @brief Hash Y for all rows appended by push_back_unhashed(), in parallel
+     */
+    void compute_pending_Y();
+
+    /**
+     * @brief Whether some rows still lack Y
+     */
+    bool has_pending_Y() const noexcept { return !pending_Y_.empty(); }
+
+    size_t size() const noexcept { return amounts_.size(); }
+    bool empty() const noexcept { return amounts_.empty(); }
+
+    // ---- Column access ----
+
+    const std::vector<KeysetHandle>& keysets() const noexcept { return keysets_; }
+    KeysetHandle keyset(size_t i) const { return keysets_[i]; }
+    const std::string& keyset_id(size_t i) const { return KeysetInterner::global().id(keysets_[i]); }
+
+    const std::vector<amount_t>& amounts() const noexcept { return amounts_; }
+    amount_t amount(size_t i) const { return amounts_[i]; }
+
+    const std::vector<Point33>& C() const noexcept { return C_; }
+    const std::vector<Point33>& Y() const noexcept { return Y_; }
+
+    std::string_view secret(size_t i) const {
+        return std::string_view(secret_arena_).substr(secret_offsets_[i], secret_offsets_[i + 1] - secret_offsets_[i]);
+    }
+
+    const std::optional<std::string>& witness(size_t i) const { return witnesses_[i]; }
+    const std::optional<DLEQWallet>& dleq(size_t i) const { return dleqs_[i]; }
+
+    // ---- Batch operations ----
+
+    /**
+     * @brief Sum of all amounts
+     * @return Total amount
+     * @throws std::overflow_error if the sum exceeds 64 bits
+     */
+    amount_t total_amount() const;
+
+    /**
+     * @brief Sum of amounts per keyset
+     * @return (keyset, total) pairs in first-seen order
+     * @throws std::overflow_error if a sum exceeds 64 bits
+     */
+    std::vector<std::pair<KeysetHandle, amount_t>> amounts_by_keyset() const;
+
+    /**
+     * @brief Find a proof whose Y equals an earlier proof's Y
+     * @return Index of the first duplicate (in sorted-Y order), or nullopt
+     * @throws std::logic_error if some rows still lack Y
+     */
+    std::optional<size_t> find_duplicate_Y() const;
+
+private:
+    std::vector<KeysetHandle> keysets_;
+    std::vector<amount_t> amounts_;
+    std::vector<Point33> C_;
+    std::vector<Point33> Y_;
+    std::string secret_arena_;
+    std::vector<uint32_t> secret_offsets_ = {0};             // size() + 1 entries
+    std::vector<std::optional<std::string>> witnesses_;
+    std::vector<std::optional<DLEQWallet>> dleqs_;
+    std::vector<uint32_t> pending_Y_;                          // Rows whose Y is not computed yet
+
+    /**
+     * @brief Append all columns except Y
+     */
+    void push_columns(const Proof& proof);
+};
+
+/**
+ * @brief Blinded messages stored column by column
+ *
+ * Columnar counterpart of std::vector<BlindedMessage> for request outputs:
+ * keyset handle, amount and the 33-byte blinded point B_.
+ */
+class BlindedMessageBatch {
+public:
+    BlindedMessageBatch() = default;
+
+    /**
+     * @brief Build batch from blinded messages
+     * @param messages Messages to convert
+     * @return Batch with one row per message, in order
+     * @throws std::invalid_argument if B_ is not a compressed point hex
+     * @throws KeysetNotFoundError if the keyset id was never interned
+     */
+    static BlindedMessageBatch from_messages(const std::vector<BlindedMessage>& messages);
+
+    /**
+     * @brief Convert back to blinded messages
+     * @return Messages in batch order
+     */
+    std::vector<BlindedMessage> to_messages() const;
+
+    void reserve(size_t count);
+
+    /**
+     * @brief Remove all rows, keeping column capacity for reuse
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Append one message
+     * @throws std::invalid_argument if B_ is not a compressed point hex
+     * @throws KeysetNotFoundError if the keyset id was never interned
+     */
+    void push_back(const BlindedMessage& message);
+
+    /**
+     * @brief Append one already-decoded message
+     */
+    void push_back(KeysetHandle keyset, amount_t amount, const Point33& B_);
+
+    size_t size() const noexcept { return amounts_.size(); }
+    bool empty() const noexcept { return amounts_.empty(); }
+
+    // ---- Column access ----
+
+    const std::vector<KeysetHandle>& keysets() const noexcept { return keysets_; }
+    KeysetHandle keyset(size_t i) const { return keysets_[i]; }
+    const std::string& keyset_id(size_t i) const { return KeysetInterner::global().id(keysets_[i]); }
+
+    const std::vector<amount_t>& amounts() const noexcept { return amounts_; }
+    amount_t amount(size_t i) const { return amounts_[i]; }
+
+    const std::vector<Point33>& B_() const noexcept { return B_points_; }
+
+    // ---- Batch operations ----
+
+    /**
+     * @brief Sum of all amounts
+     * @throws std::overflow_error if the sum exceeds 64 bits
+     */
+    amount_t total_amount() const;
+
+    /**
+     * @brief Find a message whose B_ equals an earlier message's B_
+     * @return Index of the first duplicate (in sorted-B_ order), or nullopt
+     */
+    std::optional<size_t> find_duplicate_B_() const;
+
+private:
+    std::vector<KeysetHandle> keysets_;
+    std::vector<amount_t> amounts_;
+    std::vector<Point33> B_points_;
+};
+
+} // namespace cashu::core::base
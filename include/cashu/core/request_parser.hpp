@@ -0,0 +1,159 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: PostSwapRequest, PostMeltRequest and PostMintRequest in cashu/core/models.py
+// Streaming request parser - ENHANCEMENT beyond nutshell
+// Parses request bodies with SAX callbacks straight into columnar batches and
+// enforces mint limits while parsing, so oversized requests are rejected on
+// the first violation instead of after a full DOM has been built
+
+#include "cashu/core/proof_batch.hpp"
+#include "cashu/core/result.hpp"
+#include "cashu/core/settings.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cashu::core {
+
+/**
+ * @brief Request body being parsed (selects required and accepted fields)
+ *
+ *   SWAP  {"inputs":[Proof], "outputs":[BlindedMessage]}
+ *   MELT  {"quote":str, "inputs":[Proof], "outputs":[BlindedMessage]|null}
+ *   MINT  {"quote":str, "outputs":[BlindedMessage], "signature":str|null}
+ */
+enum class RequestKind {
+    SWAP,
+    MELT,
+    MINT
+};
+
+/**
+ * @brief Limits enforced while parsing
+ */
+struct RequestLimits {
+    size_t max_body_bytes = 0;     // Checked before parsing starts
+    size_t max_inputs = 0;
+    size_t max_outputs = 0;
+    size_t max_secret_length = 0;  // In bytes, as stored in the secret arena
+
+    /**
+     * @brief Derive limits from mint settings
+     *
+     * Input and output counts use mint_max_request_length (nutshell's
+     * maximum length of request arrays), secrets use mint_max_secret_length.
+     * Nutshell has no body size setting; max_body_bytes is the largest body
+     * that can carry the maximum counts, with escaped secrets and witnesses.
+     *
+     * @param settings Mint limit settings
+     * @return Limits for request parsing
+     */
+    static RequestLimits from_settings(const settings::MintLimits& settings);
+
+    /**
+     * @brief Derive limits from the published settings (see current_settings())
+     * @return Limits for request parsing
+     */
+    static RequestLimits current();
+};
+
+/**
+ * @brief Decoded request
+ *
+ * Points (C, B_) are decoded to binary and Y is computed for every input.
+ * Fields that do not apply to the request kind stay empty.
+ */
+struct ParsedRequest {
+    base::ProofBatch inputs;
+    base::BlindedMessageBatch outputs;
+    std::optional<std::string> quote;
+    std::optional<std::string> signature;  // NUT-20 mint quote signature
+
+    /**
+     * @brief Reset all fields, keeping batch capacity for reuse
+     */
+    void clear() noexcept;
+};
+
+/**
+ * @brief SAX-based parser for mint request bodies
+ *
+ * Keyset ids are resolved with KeysetInterner::global().find() and never
+ * interned, so request bodies cannot grow the interner; the mint interns its
+ * own keyset ids when loading keysets. Unknown members are skipped.
+ */
+class RequestParser {
+public:
+    /**
+     * @brief Parser following the published settings
+     *
+     * Limits are read from current_settings() on every parse, so a settings
+     * reload applies to the next request.
+     */
+    RequestParser() = default;
+
+    /**
+     * @brief Parser with fixed limits
+     * @param limits Limits for every parse
+     */
+    explicit RequestParser(const RequestLimits& limits) : limits_(limits) {}
+
+    /**
+     * @brief Parse request body
+     * @param kind Request kind
+     * @param body JSON body
+     * @return Decoded request
+     * @throws TransactionError if the body or an input/output count exceeds its limit
+     * @throws SecretTooLongError if a secret exceeds max_secret_length
+     * @throws KeysetNotFoundError if a keyset id was never interned
+     * @throws std::invalid_argument if the body is malformed or misses a required field
+     */
+    ParsedRequest parse(RequestKind kind, std::string_view body) const;
+
+    /**
+     * @brief Parse request body into an existing result, reusing its buffers
+     *
+     * out is cleared first; on error its contents are unspecified.
+     *
+     * @param kind Request kind
+     * @param body JSON body
+     * @param out Result to fill
+     * @throws Same as parse(RequestKind, std::string_view)
+     */
+    void parse(RequestKind kind, std::string_view body, ParsedRequest& out) const;
+
+    /**
+     * @brief Parse request body without throwing on rejection
+     *
+     * Rejections carry the codes of the exceptions parse() throws
+     * (GENERIC for std::invalid_argument).
+     *
+     * @param kind Request kind
+     * @param body JSON body
+     * @return Decoded request or the first violation
+     */
+    Result<ParsedRequest> try_parse(RequestKind kind, std::string_view body) const;
+
+    /**
+     * @brief Parse request body into an existing result without throwing on rejection
+     *
+     * out is cleared first; on error its contents are unspecified.
+     *
+     * @param kind Request kind
+     * @param body JSON body
+     * @param out Result to fill
+     * @return Success or the first violation
+     */
+    Result<void> try_parse(RequestKind kind, std::string_view body, ParsedRequest& out) const;
+
+    /**
+     * @brief Limits the next parse enforces
+     */
+    RequestLimits limits() const { return limits_ ? *limits_ : RequestLimits::current(); }
+
+private:
+    std::optional<RequestLimits> limits_;  // Empty to follow the published settings
+};
+
+} // namespace cashu::core
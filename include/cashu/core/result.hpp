@@ -0,0 +1,214 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: error codes and bodies of cashu/core/errors.py
+// Non-throwing error path - ENHANCEMENT beyond nutshell
+// Validation and crypto functions with a try_ prefix (or returning Result)
+// report rejections as values, so rejecting a request costs a branch instead
+// of a stack unwind. Error bodies for default details are serialized once.
+// The throwing APIs remain and raise the same exception types as before.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace cashu::core {
+
+/**
+ * @brief Error codes, equal to the DEFAULT_CODE of the CashuError subclasses
+ *
+ * GENERIC (0) stands for failures nutshell reports as plain exceptions
+ * (malformed input); its throwing form is std::invalid_argument.
+ */
+enum class CashuErrorCode : int {
+    GENERIC = 0,
+
+    // General (10000-10999)
+    NOT_ALLOWED = 10000,
+    OUTPUTS_ALREADY_SIGNED = 10002,
+    INVALID_PROOFS = 10003,
+
+    // Transaction (11000-11999)
+    TRANSACTION = 11000,
+    TOKEN_ALREADY_SPENT = 11001,
+    TRANSACTION_NOT_BALANCED = 11002,
+    SECRET_TOO_LONG = 11003,
+    NO_SECRET_IN_PROOFS = 11004,
+    TRANSACTION_UNIT = 11005,
+    TRANSACTION_AMOUNT_EXCEEDS_LIMIT = 11006,
+    TRANSACTION_DUPLICATE_INPUTS = 11007,
+    TRANSACTION_DUPLICATE_OUTPUTS = 11008,
+    TRANSACTION_MULTIPLE_UNITS = 11009,
+    TRANSACTION_UNIT_MISMATCH = 11010,
+    TRANSACTION_AMOUNTLESS_INVOICE = 11011,
+    TRANSACTION_AMOUNT_INVOICE_MISMATCH = 11012,
+
+    // Keyset (12000-12999)
+    KEYSET = 12000,
+    KEYSET_NOT_FOUND = 12001,
+    KEYSET_INACTIVE = 12002,
+
+    // Lightning (20000-29999)
+    LIGHTNING = 20000,
+    QUOTE_NOT_PAID = 20001,
+    TOKENS_ALREADY_ISSUED = 20002,
+    MINTING_DISABLED = 20003,
+    LIGHTNING_PAYMENT_FAILED = 20004,
+    QUOTE_PENDING = 20005,
+    INVOICE_ALREADY_PAID = 20006,
+    QUOTE_EXPIRED = 20007,
+    QUOTE_SIGNATURE_INVALID = 20008,
+    QUOTE_REQUIRES_PUBKEY = 20009,
+
+    // Authentication (30000-31999)
+    CLEAR_AUTH_REQUIRED = 30001,
+    CLEAR_AUTH_FAILED = 30002,
+    BLIND_AUTH_REQUIRED = 31001,
+    BLIND_AUTH_FAILED = 31002,
+    BLIND_AUTH_AMOUNT_EXCEEDED = 31003,
+    BLIND_AUTH_RATE_LIMIT_EXCEEDED = 31004
+};
+
+class CashuError;
+
+/**
+ * @brief Error value: code plus optional detail
+ *
+ * Without a detail the error carries the default detail of its code and
+ * constructing it does not allocate. A custom detail is serialized into the
+ * error body when the error is constructed.
+ */
+class Error {
+public:
+    Error(CashuErrorCode code) noexcept : code_(code) {}
+    Error(CashuErrorCode code, std::string detail);
+
+    /**
+     * @brief Convert a caught exception
+     */
+    static Error from(const CashuError& error);
+
+    CashuErrorCode code() const noexcept { return code_; }
+
+    /**
+     * @brief Detail message (the code's default detail if none was given)
+     */
+    std::string_view detail() const noexcept;
+
+    /**
+     * @brief JSON error body {"code": ..., "detail": ...}, as CashuError::to_json().dump()
+     *
+     * Bodies with the default detail are serialized once per process and
+     * shared; a custom body lives as long as this error.
+     *
+     * @throws std::out_of_range for a code outside CashuErrorCode without a detail
+     */
+    const std::string& body() const;
+
+    /**
+     * @brief Throw the exception the throwing API would have thrown
+     * @throws The CashuError subclass for the code, or std::invalid_argument for GENERIC
+     */
+    [[noreturn]] void raise() const;
+
+private:
+    CashuErrorCode code_;
+    std::string detail_;  // Empty for the default detail
+    std::string body_;    // Empty for the default detail
+};
+
+/**
+ * @brief Default detail of a code ("" for GENERIC)
+ */
+std::string_view default_detail(CashuErrorCode code) noexcept;
+
+/**
+ * @brief Pre-serialized JSON body of a code with its default detail
+ */
+const std::string& default_error_body(CashuErrorCode code);
+
+/**
+ * @brief Value or Error, in the manner of std::expected (C++23)
+ *
+ * value() on an error throws through Error::raise(), which turns a Result
+ * back into the throwing API.
+ */
+template<typename T>
+class [[nodiscard]] Result {
+public:
+    Result(T value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    Result(Error error) : storage_(std::in_place_index<1>, std::move(error)) {}
+    Result(CashuErrorCode code) : storage_(std::in_place_index<1>, code) {}
+
+    bool has_value() const noexcept { return storage_.index() == 0; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    T& value() & {
+        check();
+        return std::get<0>(storage_);
+    }
+
+    const T& value() const& {
+        check();
+        return std::get<0>(storage_);
+    }
+
+    T&& value() && {
+        check();
+        return std::get<0>(std::move(storage_));
+    }
+
+    T& operator*() & { return std::get<0>(storage_); }
+    const T& operator*() const& { return std::get<0>(storage_); }
+    T* operator->() { return &std::get<0>(storage_); }
+    const T* operator->() const { return &std::get<0>(storage_); }
+
+    /**
+     * @brief Error; only valid if !has_value()
+     */
+    const Error& error() const { return std::get<1>(storage_); }
+
+private:
+    std::variant<T, Error> storage_;
+
+    void check() const {
+        if (!has_value()) {
+            std::get<1>(storage_).raise();
+        }
+    }
+};
+
+/**
+ * @brief Success or Error
+ */
+template<>
+class [[nodiscard]] Result<void> {
+public:
+    Result() noexcept : error_(CashuErrorCode::GENERIC), ok_(true) {}
+    Result(Error error) : error_(std::move(error)), ok_(false) {}
+    Result(CashuErrorCode code) noexcept : error_(code), ok_(false) {}
+
+    bool has_value() const noexcept { return ok_; }
+    explicit operator bool() const noexcept { return ok_; }
+
+    /**
+     * @brief Throw the error, if any
+     */
+    void value() const {
+        if (!ok_) {
+            error_.raise();
+        }
+    }
+
+    /**
+     * @brief Error; only valid if !has_value()
+     */
+    const Error& error() const noexcept { return error_; }
+
+private:
+    Error error_;
+    bool ok_;
+};
+
+} // namespace cashu::core
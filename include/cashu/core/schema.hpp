@@ -0,0 +1,495 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: field sets mirror the tables in cashu/mint/migrations.py and cashu/wallet/migrations.py
+// Compile-time model schemas - ENHANCEMENT beyond nutshell
+// One constexpr field list per model struct drives its JSON codec, a compact
+// binary row codec and column metadata for the persistence layer
+
+#include "cashu/core/amount.hpp"
+#include "cashu/core/json_writer.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace cashu::core::schema {
+
+/**
+ * @brief Storage type of a column
+ */
+enum class ColumnType : uint8_t {
+    TEXT,
+    INTEGER,    // 32-bit signed
+    BIGINT,     // 64-bit (amounts, balances)
+    BOOLEAN,
+    TIMESTAMP   // Unix seconds
+};
+
+/**
+ * @brief Column metadata derived from a field
+ */
+struct Column {
+    std::string_view name;
+    ColumnType type;
+    bool nullable;
+};
+
+/**
+ * @brief Named pointer to a data member
+ */
+template<typename T, typename M>
+struct Field {
+    using owner_type = T;
+    using value_type = M;
+
+    std::string_view name;
+    M T::* member;
+};
+
+/**
+ * @brief Declare a field (used inside a struct's static constexpr fields())
+ */
+template<typename T, typename M>
+constexpr Field<T, M> field(std::string_view name, M T::* member) {
+    return Field<T, M>{name, member};
+}
+
+//=============================================================================
+// Binary Primitives
+//=============================================================================
+
+/**
+ * @brief Append unsigned LEB128 varint
+ */
+inline void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Append zigzag-encoded signed varint
+ */
+inline void put_svarint(std::string& out, int64_t value) {
+    put_varint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * @brief Bounds-checked cursor over an encoded row buffer
+ */
+class RowReader {
+public:
+    explicit RowReader(std::string_view data) : pos_(data.data()), end_(data.data() + data.size()) {}
+
+    size_t remaining() const noexcept { return static_cast<size_t>(end_ - pos_); }
+    const char* position() const noexcept { return pos_; }
+
+    uint8_t byte() {
+        if (pos_ == end_) truncated();
+        return static_cast<uint8_t>(*pos_++);
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::invalid_argument("Malformed row: varint too long");
+    }
+
+    int64_t svarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    std::string_view bytes(size_t size) {
+        if (size > remaining()) truncated();
+        std::string_view view(pos_, size);
+        pos_ += size;
+        return view;
+    }
+
+private:
+    const char* pos_;
+    const char* end_;
+
+    [[noreturn]] static void truncated() {
+        throw std::invalid_argument("Malformed row: truncated");
+    }
+};
+
+//=============================================================================
+// Value Codecs
+//=============================================================================
+
+/**
+ * @brief Per-type encoding rules
+ *
+ * JSON: strings and bools as-is, int as number, 64-bit integers as decimal
+ * strings (nutshell BIGINT columns; avoids precision loss in JS clients),
+ * timestamps as Unix seconds. Binary: varints, length-prefixed strings.
+ */
+template<typename V>
+struct Codec;
+
+template<>
+struct Codec<std::string> {
+    static constexpr ColumnType column = ColumnType::TEXT;
+
+    static nlohmann::json to_json(const std::string& v) { return v; }
+    static void from_json(const nlohmann::json& j, std::string& v) { v = j.get<std::string>(); }
+    static void write_json(JsonWriter& w, const std::string& v) { w.value(v); }
+    static void encode(std::string& out, const std::string& v) {
+        put_varint(out, v.size());
+        out.append(v);
+    }
+    static void decode(RowReader& in, std::string& v) {
+        size_t size = static_cast<size_t>(in.varint());
+        v.assign(in.bytes(size));
+    }
+};
+
+template<>
+struct Codec<int> {
+    static constexpr ColumnType column = ColumnType::INTEGER;
+
+    static nlohmann::json to_json(int v) { return v; }
+    static void from_json(const nlohmann::json& j, int& v) { v = j.get<int>(); }
+    static void write_json(JsonWriter& w, int v) { w.value(v); }
+    static void encode(std::string& out, int v) { put_svarint(out, v); }
+    static void decode(RowReader& in, int& v) {
+        int64_t value = in.svarint();
+        if (value < INT32_MIN || value > INT32_MAX) {
+            throw std::invalid_argument("Malformed row: int out of range");
+        }
+        v = static_cast<int>(value);
+    }
+};
+
+template<>
+struct Codec<int64_t> {
+    static constexpr ColumnType column = ColumnType::BIGINT;
+
+    static nlohmann::json to_json(int64_t v) { return std::to_string(v); }
+    static void from_json(const nlohmann::json& j, int64_t& v) {
+        v = j.is_string() ? std::stoll(j.get<std::string>()) : j.get<int64_t>();
+    }
+    static void write_json(JsonWriter& w, int64_t v) { w.value(std::to_string(v)); }
+    static void encode(std::string& out, int64_t v) { put_svarint(out, v); }
+    static void decode(RowReader& in, int64_t& v) { v = in.svarint(); }
+};
+
+template<>
+struct Codec<amount_t> {
+    static constexpr ColumnType column = ColumnType::BIGINT;
+
+    static nlohmann::json to_json(amount_t v) { return std::to_string(v); }
+    static void from_json(const nlohmann::json& j, amount_t& v) {
+        v = j.is_string() ? parse_amount(j.get<std::string>()) : j.get<amount_t>();
+    }
+    static void write_json(JsonWriter& w, amount_t v) { w.value(std::to_string(v)); }
+    static void encode(std::string& out, amount_t v) { put_varint(out, v); }
+    static void decode(RowReader& in, amount_t& v) { v = in.varint(); }
+};
+
+template<>
+struct Codec<bool> {
+    static constexpr ColumnType column = ColumnType::BOOLEAN;
+
+    static nlohmann::json to_json(bool v) { return v; }
+    static void from_json(const nlohmann::json& j, bool& v) { v = j.get<bool>(); }
+    static void write_json(JsonWriter& w, bool v) { w.value(v); }
+    static void encode(std::string& out, bool v) { out.push_back(v ? 1 : 0); }
+    static void decode(RowReader& in, bool& v) {
+        uint8_t b = in.byte();
+        if (b > 1) {
+            throw std::invalid_argument("Malformed row: invalid bool");
+        }
+        v = b == 1;
+    }
+};
+
+template<>
+struct Codec<std::chrono::system_clock::time_point> {
+    using time_point = std::chrono::system_clock::time_point;
+    static constexpr ColumnType column = ColumnType::TIMESTAMP;
+
+    static int64_t seconds(const time_point& v) {
+        return std::chrono::duration_cast<std::chrono::seconds>(v.time_since_epoch()).count();
+    }
+
+    static nlohmann::json to_json(const time_point& v) { return seconds(v); }
+    static void from_json(const nlohmann::json& j, time_point& v) { v = time_point(std::chrono::seconds(j.get<int64_t>())); }
+    static void write_json(JsonWriter& w, const time_point& v) { w.value(seconds(v)); }
+    static void encode(std::string& out, const time_point& v) { put_svarint(out, seconds(v)); }
+    static void decode(RowReader& in, time_point& v) { v = time_point(std::chrono::seconds(in.svarint())); }
+};
+
+//=============================================================================
+// Schema Operations
+//=============================================================================
+
+namespace detail {
+    template<typename V>
+    struct is_optional : std::false_type {};
+
+    template<typename V>
+    struct is_optional<std::optional<V>> : std::true_type {};
+
+    template<typename V>
+    struct stored {
+        using type = V;
+    };
+
+    template<typename V>
+    struct stored<std::optional<V>> {
+        using type = V;
+    };
+
+    template<typename F>
+    using value_of = typename std::decay_t<F>::value_type;
+
+    template<typename F>
+    using codec_of = Codec<typename stored<value_of<F>>::type>;
+
+    template<typename T, typename Fn>
+    constexpr void for_each_field(Fn&& fn) {
+        std::apply([&fn](const auto&... fields) { (fn(fields), ...); }, T::fields());
+    }
+
+    // Bit i set when field i must be present (non-optional member)
+    template<typename T>
+    constexpr uint64_t required_mask() {
+        uint64_t mask = 0;
+        size_t index = 0;
+        for_each_field<T>([&](const auto& field) {
+            if (!is_optional<value_of<decltype(field)>>::value) {
+                mask |= uint64_t(1) << index;
+            }
+            ++index;
+        });
+        return mask;
+    }
+}
+
+/**
+ * @brief Number of fields in T's schema
+ */
+template<typename T>
+constexpr size_t field_count() {
+    return std::tuple_size_v<decltype(T::fields())>;
+}
+
+/**
+ * @brief Column metadata for T, in schema order
+ */
+template<typename T>
+constexpr std::array<Column, field_count<T>()> columns() {
+    return std::apply([](const auto&... fields) {
+        return std::array<Column, sizeof...(fields)>{Column{
+            fields.name,
+            detail::codec_of<decltype(fields)>::column,
+            detail::is_optional<detail::value_of<decltype(fields)>>::value}...};
+    }, T::fields());
+}
+
+/**
+ * @brief Encode as JSON object (empty optionals are omitted)
+ */
+template<typename T>
+nlohmann::json to_json(const T& object) {
+    nlohmann::json j = nlohmann::json::object();
+    detail::for_each_field<T>([&](const auto& field) {
+        using Codec = detail::codec_of<decltype(field)>;
+        const auto& value = object.*(field.member);
+        if constexpr (detail::is_optional<detail::value_of<decltype(field)>>::value) {
+            if (value.has_value()) {
+                j[std::string(field.name)] = Codec::to_json(*value);
+            }
+        } else {
+            j[std::string(field.name)] = Codec::to_json(value);
+        }
+    });
+    return j;
+}
+
+/**
+ * @brief Stream as JSON object in schema order, without a DOM
+ */
+template<typename T>
+void write_json(JsonWriter& writer, const T& object) {
+    writer.begin_object();
+    detail::for_each_field<T>([&](const auto& field) {
+        using Codec = detail::codec_of<decltype(field)>;
+        const auto& value = object.*(field.member);
+        if constexpr (detail::is_optional<detail::value_of<decltype(field)>>::value) {
+            if (value.has_value()) {
+                writer.key(field.name);
+                Codec::write_json(writer, *value);
+            }
+        } else {
+            writer.key(field.name);
+            Codec::write_json(writer, value);
+        }
+    });
+    writer.end_object();
+}
+
+/**
+ * @brief Decode from JSON object
+ *
+ * Walks the object's members once and matches each key against the field
+ * list; unknown keys are ignored and null counts as absent.
+ *
+ * @throws std::invalid_argument if j is not an object or a required field is missing
+ * @throws nlohmann::json::exception if a value has the wrong JSON type
+ */
+template<typename T>
+T from_json(const nlohmann::json& j) {
+    static_assert(field_count<T>() <= 64, "schema supports at most 64 fields");
+    if (!j.is_object()) {
+        throw std::invalid_argument("Expected JSON object");
+    }
+
+    T object{};
+    uint64_t seen = 0;
+    for (auto it = j.begin(); it != j.end(); ++it) {
+        if (it->is_null()) {
+            continue;
+        }
+        const std::string& key = it.key();
+        size_t index = 0;
+        std::apply([&](const auto&... fields) {
+            auto match = [&](const auto& field) {
+                if (key != field.name) {
+                    ++index;
+                    return false;
+                }
+                using Codec = detail::codec_of<decltype(field)>;
+                auto& value = object.*(field.member);
+                if constexpr (detail::is_optional<detail::value_of<decltype(field)>>::value) {
+                    Codec::from_json(*it, value.emplace());
+                } else {
+                    Codec::from_json(*it, value);
+                }
+                seen |= uint64_t(1) << index;
+                return true;
+            };
+            (match(fields) || ...);
+        }, T::fields());
+    }
+
+    constexpr uint64_t required = detail::required_mask<T>();
+    if ((seen & required) != required) {
+        size_t index = 0;
+        detail::for_each_field<T>([&](const auto& field) {
+            if ((required & ~seen) & (uint64_t(1) << index)) {
+                throw std::invalid_argument("Missing required field: " + std::string(field.name));
+            }
+            ++index;
+        });
+    }
+    return object;
+}
+
+/**
+ * @brief Append compact binary row
+ *
+ * Layout: field count, then each field in schema order; optionals carry a
+ * presence byte.
+ */
+template<typename T>
+void encode_row(std::string& out, const T& object) {
+    put_varint(out, field_count<T>());
+    detail::for_each_field<T>([&](const auto& field) {
+        using Codec = detail::codec_of<decltype(field)>;
+        const auto& value = object.*(field.member);
+        if constexpr (detail::is_optional<detail::value_of<decltype(field)>>::value) {
+            out.push_back(value.has_value() ? 1 : 0);
+            if (value.has_value()) {
+                Codec::encode(out, *value);
+            }
+        } else {
+            Codec::encode(out, value);
+        }
+    });
+}
+
+/**
+ * @brief Decode one binary row
+ * @param in Reader positioned at the row
+ * @return Decoded object
+ * @throws std::invalid_argument if the row is truncated or has a different field count
+ */
+template<typename T>
+T decode_row(RowReader& in) {
+    if (in.varint() != field_count<T>()) {
+        throw std::invalid_argument("Malformed row: field count does not match schema");
+    }
+    T object{};
+    detail::for_each_field<T>([&](const auto& field) {
+        using Codec = detail::codec_of<decltype(field)>;
+        auto& value = object.*(field.member);
+        if constexpr (detail::is_optional<detail::value_of<decltype(field)>>::value) {
+            uint8_t present = in.byte();
+            if (present > 1) {
+                throw std::invalid_argument("Malformed row: invalid presence flag");
+            }
+            if (present) {
+                Codec::decode(in, value.emplace());
+            } else {
+                value.reset();
+            }
+        } else {
+            Codec::decode(in, value);
+        }
+    });
+    return object;
+}
+
+/**
+ * @brief Append row count followed by each row
+ */
+template<typename T>
+void encode_rows(std::string& out, const T* rows, size_t count) {
+    put_varint(out, count);
+    for (size_t i = 0; i < count; ++i) {
+        encode_row(out, rows[i]);
+    }
+}
+
+/**
+ * @brief Decode rows written by encode_rows, appending to out
+ * @throws std::invalid_argument if the data is malformed or has trailing bytes
+ */
+template<typename T>
+void decode_rows(std::string_view data, std::vector<T>& out) {
+    RowReader in(data);
+    uint64_t count = in.varint();
+    if (count > in.remaining()) {
+        throw std::invalid_argument("Malformed rows: count exceeds data");
+    }
+    out.reserve(out.size() + static_cast<size_t>(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        out.push_back(decode_row<T>(in));
+    }
+    if (in.remaining() != 0) {
+        throw std::invalid_argument("Malformed rows: trailing bytes");
+    }
+}
+
+} // namespace cashu::core::schema
@@ -0,0 +1,129 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: cashu/core/secret.py, P2PKSecret in cashu/core/p2pk.py, HTLCSecret in cashu/core/htlc.py
+// NUT-10 well-known secrets: ["<kind>", {"nonce": str, "data": str, "tags": [[str, ...], ...]}]
+// PERFORMANCE: deserialize() decodes the spending-condition tags (sigflag,
+// n_sigs, pubkeys, locktime, refund) once, so verification never looks them up again
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cashu::core::secret {
+
+/**
+ * @brief Kind of a well-known secret
+ * NUTSHELL COMPATIBILITY: Matches SecretKind enum in nutshell secret.py
+ */
+enum class SecretKind {
+    P2PK,   // NUT-11
+    HTLC    // NUT-14
+};
+
+std::string to_string(SecretKind kind);
+SecretKind secret_kind_from_string(std::string_view str);
+
+/**
+ * @brief Signature flag of a spending condition
+ * NUTSHELL COMPATIBILITY: Matches SigFlags enum in nutshell p2pk.py
+ */
+enum class SigFlag {
+    SIG_INPUTS,   // Each input carries signatures over its own secret
+    SIG_ALL       // First input carries signatures over all inputs and outputs
+};
+
+std::string to_string(SigFlag flag);
+SigFlag sig_flag_from_string(std::string_view str);
+
+/**
+ * @brief Secret tags
+ * NUTSHELL COMPATIBILITY: Matches Tags class in nutshell secret.py
+ */
+class Tags {
+public:
+    std::vector<std::vector<std::string>> tags;
+
+    /**
+     * @brief First value of the first tag with this name
+     */
+    std::optional<std::string> get_tag(std::string_view name) const;
+
+    /**
+     * @brief All values of all tags with this name, in order
+     */
+    std::vector<std::string> get_tag_all(std::string_view name) const;
+
+    bool operator==(const Tags& other) const { return tags == other.tags; }
+    bool operator!=(const Tags& other) const { return tags != other.tags; }
+};
+
+/**
+ * @brief Parsed NUT-10 well-known secret
+ * NUTSHELL COMPATIBILITY: Matches Secret, P2PKSecret and HTLCSecret in nutshell
+ *
+ * For P2PK, data is the primary pubkey; for HTLC, data is the hex SHA-256
+ * hash of the preimage.
+ */
+class Secret {
+public:
+    SecretKind kind = SecretKind::P2PK;
+    std::string nonce;
+    std::string data;
+    Tags tags;
+
+    // Spending-condition tags, decoded by deserialize() or decode_tags()
+    SigFlag sigflag = SigFlag::SIG_INPUTS;
+    std::optional<int64_t> locktime;       // Unix time
+    size_t n_sigs = 1;                     // Required signatures from pubkeys
+    size_t n_sigs_refund = 1;              // Required signatures from refund after locktime
+    std::vector<std::string> pubkeys;      // "pubkeys" tag values (data not included)
+    std::vector<std::string> refund;       // "refund" tag values
+
+    /**
+     * @brief Pubkeys that can sign before locktime
+     *
+     * P2PK: data followed by the "pubkeys" tag; HTLC: the "pubkeys" tag only.
+     */
+    std::vector<std::string> signing_pubkeys() const;
+
+    /**
+     * @brief Check whether both secrets lock to the same condition (kind, data and tags)
+     */
+    bool same_condition(const Secret& other) const {
+        return kind == other.kind && data == other.data && tags == other.tags;
+    }
+
+    /**
+     * @brief Cheap pre-check whether a proof secret may be a well-known secret
+     * @return True if the secret starts with a JSON array
+     */
+    static bool is_well_known(std::string_view secret);
+
+    /**
+     * @brief Parse well-known secret
+     * @param secret Proof secret
+     * @return Parsed secret
+     * @throws std::invalid_argument if the secret is not a NUT-10 secret of a known
+     *         kind or a spending-condition tag is malformed
+     */
+    static Secret deserialize(std::string_view secret);
+
+    /**
+     * @brief Parse the [kind, {data, nonce, tags}] shape without decoding tag values
+     * @param secret Proof secret
+     * @return Parsed secret with default spending-condition fields
+     * @throws std::invalid_argument if the secret is not a NUT-10 secret of a known kind
+     */
+    static Secret parse(std::string_view secret);
+
+    /**
+     * @brief Decode sigflag, locktime, n_sigs, n_sigs_refund, pubkeys and refund from tags
+     * @throws std::invalid_argument if a spending-condition tag is malformed
+     */
+    void decode_tags();
+};
+
+} // namespace cashu::core::secret
@@ -7,6 +7,12 @@
 #include <vector>
 #include <optional>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 
 namespace cashu::core::settings {
 
@@ -17,9 +23,6 @@ constexpr const char* VERSION = "0.17.0";
 class CashuSettings;
 class Settings;
 
-// Global settings instance (singleton pattern)
-extern std::unique_ptr<Settings> settings;
-
 /**
  * Environment file utilities
  */
@@ -33,11 +36,14 @@ public:
     
     /**
      * Load environment variables from file
+     * Replaces the values of any previously loaded file
      */
     static void load_env_file(const std::string& env_file);
     
     /**
      * Get environment variable with default
+     * Process environment first, then the loaded .env file; thread-safe
+     * against concurrent load_env_file()
      */
     template<typename T>
     static T get_env(const std::string& key, const T& default_value);
@@ -75,6 +81,7 @@ public:
     bool debug_mint_only_deprecated;
     std::optional<std::string> db_backup_path;
     bool db_connection_pool;
+    int thread_pool_size;  // Worker threads of ThreadPool::global(); 0 = hardware concurrency. Startup only
 };
 
 /**
@@ -89,6 +96,7 @@ public:
     std::optional<std::string> mint_seed_decryption_key;
     std::string mint_derivation_path;
     std::vector<std::string> mint_derivation_path_list;
+    std::optional<std::string> mint_keyset_cache_path;  // Binary keyset cache (see KeysetCache)
     
     // Network settings
     std::string mint_listen_host;
@@ -103,6 +111,10 @@ public:
     int mint_input_fee_ppk;
     bool mint_disable_melt_on_error;
     
+    // Signing/verification micro-batching (see BatchingOptions)
+    int mint_batch_window_us;
+    int mint_batch_max_size;
+    
     // Task intervals
     int mint_regular_tasks_interval_seconds;
 };
@@ -299,6 +311,8 @@ public:
     
     /**
      * Reload settings from environment
+     * Rewrites this instance in place; use reload_settings() to update the
+     * settings other threads read
      */
     void reload();
     
@@ -321,7 +335,89 @@ void initialize_settings();
 
 /**
  * Get global settings instance
+ * Same as current_settings(): the published snapshot is the only settings
+ * instance, so a reload is seen by every reader. Settings that size resources
+ * when they are first used, like thread_pool_size, are read once and need a restart to change
+ */
+const Settings& get_settings();
+
+/**
+ * Immutable settings published for concurrent readers - ENHANCEMENT beyond nutshell
+ * Nutshell reads the mutable global settings object; here a reload builds a
+ * new snapshot and swaps it in atomically, so readers never see a half-written
+ * object and can hold a snapshot across a reload
+ */
+class SettingsSnapshot {
+public:
+    SettingsSnapshot(Settings settings, uint64_t generation);
+    
+    const Settings settings;
+    const uint64_t generation;  // 1 for the startup settings, incremented by every reload
+};
+
+/**
+ * Get the published settings snapshot
+ * Initializes settings on first use; the snapshot stays valid while held
+ */
+std::shared_ptr<const SettingsSnapshot> settings_snapshot();
+
+/**
+ * Get the published settings for hot paths
+ * Costs one atomic load while no reload happened. The reference stays valid
+ * until the calling thread calls current_settings() again after a reload;
+ * hold settings_snapshot() to keep settings across calls
+ */
+const Settings& current_settings();
+
+/**
+ * Reload settings from the environment and .env file and publish them
+ * Invalid settings throw and leave the published snapshot unchanged
+ * @return The new snapshot
+ */
+std::shared_ptr<const SettingsSnapshot> reload_settings();
+
+/**
+ * Reloads settings when the .env file changes or a reload is requested - ENHANCEMENT beyond nutshell
+ * Polls on a background thread; a failed reload keeps the previous settings
+ * and is reported through last_error()
  */
-Settings& get_settings();
+class SettingsWatcher {
+public:
+    /**
+     * Start watching
+     * @param interval Polling interval for file changes and reload requests
+     */
+    explicit SettingsWatcher(std::chrono::milliseconds interval = std::chrono::seconds(1));
+    ~SettingsWatcher();
+    
+    SettingsWatcher(const SettingsWatcher&) = delete;
+    SettingsWatcher& operator=(const SettingsWatcher&) = delete;
+    
+    /**
+     * Ask running watchers to reload at their next poll
+     * Async-signal-safe
+     */
+    static void request_reload() noexcept;
+    
+    /**
+     * Install a handler calling request_reload() for a signal (e.g. SIGHUP)
+     */
+    static void install_signal_handler(int signum);
+    
+    /**
+     * Error of the last failed reload, cleared by a successful one
+     */
+    std::optional<std::string> last_error() const;
+    
+private:
+    std::chrono::milliseconds interval_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::optional<std::string> last_error_;
+    std::thread thread_;
+    
+    void run();
+};
 
 } // namespace cashu::core::settings
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: the proofs_used table (ProofUsed in cashu/core/models.py)
+// as queried by Ledger._check_proofs_spendable in cashu/mint/ledger.py
+// In-memory spent-proof index - ENHANCEMENT beyond nutshell
+// Spent Y values are kept in sharded lock-free open-addressing tables behind
+// a blocked Bloom filter. Most inputs of a swap or melt are new, and those
+// are answered by one cache line of the filter without probing a table.
+// Insertion is insert-if-absent, so two concurrent spends of one proof
+// cannot both succeed.
+
+#include "cashu/core/models.hpp"
+#include "cashu/core/point_hash.hpp"
+#include "cashu/core/proof_batch.hpp"
+#include "cashu/core/result.hpp"
+#include "cashu/core/thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cashu::core {
+
+/**
+ * @brief Concurrent set of spent proofs, keyed by binary Y
+ *
+ * All operations are thread-safe. insert(), contains() and erase() are
+ * lock-free. The exception is a shard that is growing: operations on it wait
+ * until the larger table is published. Growth is rare when the index is
+ * constructed with the expected number of spent proofs. A replaced table is
+ * freed as soon as no thread can still be probing it. Entries are never
+ * removed except by erase(), which only rolls back failed inserts.
+ *
+ * The Bloom filter is sized once at construction. Beyond expected_proofs its
+ * false-positive rate rises, which costs table probes but never correctness.
+ */
+class SpentIndex {
+public:
+    /**
+     * @param expected_proofs Expected number of spent proofs (sizes tables and filter)
+     * @param shards Number of independently growing tables (rounded up to a power of two)
+     */
+    explicit SpentIndex(size_t expected_proofs = size_t(1) << 16, size_t shards = 64);
+    ~SpentIndex();
+
+    SpentIndex(const SpentIndex&) = delete;
+    SpentIndex& operator=(const SpentIndex&) = delete;
+
+    /**
+     * @brief Mark Y spent if it is not already
+     * @param Y Compressed hash_to_curve(secret)
+     * @return True if Y was inserted, false if it was already spent
+     */
+    bool insert(const base::Point33& Y);
+
+    /**
+     * @brief Whether Y is spent
+     * @param Y Compressed hash_to_curve(secret)
+     */
+    bool contains(const base::Point33& Y) const;
+
+    /**
+     * @brief Remove Y (rollback of an insert whose transaction failed)
+     * @param Y Compressed hash_to_curve(secret)
+     * @return True if Y was present
+     */
+    bool erase(const base::Point33& Y);
+
+    /**
+     * @brief Mark all Ys spent, or none
+     *
+     * Fails without inserting if one is already spent. Otherwise inserts in
+     * order; if one is spent concurrently (or occurs twice), the inserted
+     * ones are erased again. Between insert and rollback they read as
+     * spent, so a concurrent spend of them is rejected as well.
+     *
+     * @param Ys Points to insert
+     * @param count Number of points
+     * @return Success, or TOKEN_ALREADY_SPENT
+     */
+    Result<void> insert_all(const base::Point33* Ys, size_t count);
+
+    /**
+     * @brief Mark all Ys spent, or none
+     */
+    Result<void> insert_all(const std::vector<base::Point33>& Ys) { return insert_all(Ys.data(), Ys.size()); }
+
+    /**
+     * @brief Mark all inputs of a batch spent, or none
+     * @param proofs Inputs with Y computed
+     * @return Success, or TOKEN_ALREADY_SPENT
+     * @throws std::logic_error if some rows still lack Y
+     */
+    Result<void> insert_all(const base::ProofBatch& proofs);
+
+    /**
+     * @brief Index of the first spent Y, if any
+     * @param Ys Points to check
+     * @param count Number of points
+     * @return Index of the first spent point, or count if none is spent
+     */
+    size_t find_spent(const base::Point33* Ys, size_t count) const;
+
+    /**
+     * @brief Insert spent Ys in parallel (startup rebuild)
+     * @param Ys Points to insert
+     * @param pool Pool running the inserts
+     * @return Number of points that were not already present
+     */
+    size_t load(const std::vector<base::Point33>& Ys, ThreadPool& pool = ThreadPool::global());
+
+    /**
+     * @brief Rebuild from proofs_used rows in parallel
+     *
+     * Uses the stored y column; rows without it are hashed from their secret.
+     *
+     * @param proofs Rows of proofs_used
+     * @param pool Pool running the inserts
+     * @return Number of rows that were not already present
+     * @throws std::invalid_argument if a y column is not a 33-byte compressed point hex
+     */
+    size_t load(const std::vector<models::ProofUsed>& proofs, ThreadPool& pool = ThreadPool::global());
+
+    /**
+     * @brief Number of spent proofs
+     */
+    size_t size() const noexcept;
+
+private:
+    struct Table;
+    struct Shard;
+    struct Block;
+    struct Hashes;
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_mask_;
+    unsigned shard_bits_;
+    std::unique_ptr<Block[]> filter_;
+    size_t filter_mask_;
+    PointHash hasher_;
+
+    Hashes hash(const base::Point33& Y) const noexcept;
+    bool filter_may_contain(const Hashes& hashes) const noexcept;
+    void filter_add(const Hashes& hashes) noexcept;
+    void grow(Shard& shard, Table* full);
+    static void wait_for_growth(const Shard& shard, const Table* old);
+};
+
+} // namespace cashu::core
@@ -0,0 +1,192 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: Executor behind async_wrap in cashu/core/helpers.py
+// Work-stealing thread pool - ENHANCEMENT beyond nutshell
+// Nutshell runs blocking work on asyncio's default ThreadPoolExecutor; this
+// pool plays the same role for helpers::async_wrap and the parallel crypto
+// batch paths, with a bounded number of threads instead of one per task
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cashu::core {
+
+/**
+ * @brief Scheduling priority of a pool task
+ *
+ * Workers run every queued HIGH task (own or stolen) before any NORMAL task,
+ * and NORMAL before LOW. Priorities do not preempt running tasks.
+ */
+enum class TaskPriority : uint8_t {
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2
+};
+
+/**
+ * @brief Work-stealing thread pool
+ *
+ * Every worker owns one deque per priority. Tasks submitted from a worker go
+ * to its own deque and are popped LIFO for cache locality; tasks submitted
+ * from other threads are spread round-robin. Idle workers steal FIFO from
+ * the other workers' deques before going to sleep.
+ */
+class ThreadPool {
+public:
+    static constexpr size_t PRIORITY_COUNT = 3;
+
+    /**
+     * @brief Start worker threads
+     * @param threads Number of workers; 0 uses std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    /**
+     * @brief Run all queued tasks, then join the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Process-wide pool, sized by Settings::thread_pool_size on first use
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief Number of worker threads
+     */
+    size_t size() const noexcept { return workers_.size(); }
+
+    /**
+     * @brief Check whether the calling thread is a worker of this pool
+     */
+    bool in_worker() const noexcept;
+
+    /**
+     * @brief Queue a task; exceptions thrown by the task are discarded
+     * @param task Task to run
+     * @param priority Scheduling priority
+     */
+    void post(std::function<void()> task, TaskPriority priority = TaskPriority::NORMAL);
+
+    /**
+     * @brief Queue a task and get its result as a future
+     * @param func Callable without arguments
+     * @param priority Scheduling priority
+     * @return Future receiving the result or exception of func
+     */
+    template<typename Func>
+    std::future<std::invoke_result_t<std::decay_t<Func>>> submit(Func&& func,
+                                                                TaskPriority priority = TaskPriority::NORMAL) {
+        using Result = std::invoke_result_t<std::decay_t<Func>>;
+        // std::function needs a copyable target; packaged_task is move-only
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> future = task->get_future();
+        post([task]() { (*task)(); }, priority);
+        return future;
+    }
+
+    /**
+     * @brief Run body(begin, end) over [0, count) in parallel chunks
+     *
+     * The calling thread runs chunks too, so parallel_for may be called from
+     * a worker (including nested calls) without deadlocking. Returns after
+     * every chunk has finished.
+     *
+     * @param count Number of items
+     * @param min_chunk Smallest number of items worth a separate task
+     * @param body Callable as body(size_t begin, size_t end)
+     * @param priority Priority of the helper tasks
+     * @throws The first exception thrown by body, after all chunks finished
+     */
+    template<typename Body>
+    void parallel_for(size_t count, size_t min_chunk, Body&& body,
+                      TaskPriority priority = TaskPriority::NORMAL) {
+        if (count == 0) {
+            return;
+        }
+        size_t step = std::max<size_t>(1, min_chunk);
+        size_t chunks = std::max<size_t>(1, std::min((count + step - 1) / step, size()));
+        if (chunks == 1) {
+            body(size_t{0}, count);
+            return;
+        }
+        run_chunks(count, chunks, std::function<void(size_t, size_t)>(std::ref(body)), priority);
+    }
+
+    /**
+     * @brief Wait for a future, running queued tasks while waiting on a worker
+     *
+     * Blocking a worker on a task queued behind it would deadlock a small pool.
+     *
+     * @param future Future to wait for
+     * @return Result of future.get()
+     */
+    template<typename T>
+    T wait(std::future<T>& future) {
+        wait_ready(future);
+        return future.get();
+    }
+
+    /**
+     * @brief Block until a future is ready without taking its result
+     *
+     * Runs queued tasks while waiting on a worker, like wait().
+     *
+     * @param future Future to wait for
+     */
+    template<typename T>
+    void wait_ready(const std::future<T>& future) {
+        if (!in_worker()) {
+            future.wait();
+            return;
+        }
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!run_pending_task()) {
+                future.wait_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    /**
+     * @brief Run one queued task on the calling thread
+     * @return True if a task was run
+     */
+    bool run_pending_task();
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> queues[PRIORITY_COUNT];
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_worker_{0};   // Round-robin target for external submissions
+    std::atomic<size_t> queued_{0};        // Tasks pushed but not yet popped
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stopping_ = false;                // Guarded by sleep_mutex_
+
+    void worker_loop(size_t index);
+    bool pop_task(size_t self, std::function<void()>& task);
+    void run_chunks(size_t count, size_t chunks, std::function<void(size_t, size_t)> body,
+                    TaskPriority priority);
+};
+
+} // namespace cashu::core
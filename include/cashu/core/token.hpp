@@ -0,0 +1,218 @@
+#pragma once
+
+// NUTSHELL COMPATIBILITY: TokenV3 and TokenV4 in cashu/core/base.py (NUT-00 serialization)
+// Token encoding for "cashuA" (V3, JSON) and "cashuB" (V4, CBOR) tokens
+// PERFORMANCE: V4 decoding returns views into the decoded CBOR buffer
+// instead of copying every field into std::string
+
+#include "cashu/core/base.hpp"
+#include "cashu/core/proof_batch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cashu::core::base {
+
+/**
+ * @brief Non-owning view of a byte string
+ */
+struct ByteView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    bool empty() const noexcept { return size == 0; }
+
+    /**
+     * @brief Lowercase hex encoding of the bytes
+     */
+    std::string hex() const;
+};
+
+/**
+ * @brief Non-owning view of a V4 DLEQ proof (binary e, s, r)
+ */
+struct DLEQView {
+    ByteView e;
+    ByteView s;
+    ByteView r;
+};
+
+/**
+ * @brief Non-owning view of one proof inside a decoded V4 token
+ */
+struct ProofView {
+    ByteView keyset_id;                       // Binary keyset id of the enclosing group
+    amount_t amount = 0;
+    std::string_view secret;
+    ByteView C;                               // 33-byte compressed point
+    std::optional<DLEQView> dleq;
+    std::optional<std::string_view> witness;
+
+    /**
+     * @brief Copy into an owning Proof (hex id, C and DLEQ)
+     */
+    Proof to_proof() const;
+};
+
+/**
+ * @brief V3 token ("cashuA" + base64url JSON)
+ * NUTSHELL COMPATIBILITY: Matches TokenV3 in nutshell base.py
+ */
+class TokenV3 {
+public:
+    static constexpr std::string_view PREFIX = "cashuA";
+
+    struct Entry {
+        std::string mint;
+        std::vector<Proof> proofs;
+    };
+
+    std::vector<Entry> token;
+    std::optional<std::string> unit;
+    std::optional<std::string> memo;
+
+    /**
+     * @brief Total amount of all proofs
+     * @throws std::overflow_error if the sum exceeds 64 bits
+     */
+    amount_t amount() const;
+
+    /**
+     * @brief Serialize to "cashuA..." (padded base64url, as nutshell)
+     * @param include_dleq Whether to include DLEQ proofs
+     */
+    std::string serialize(bool include_dleq = false) const;
+
+    /**
+     * @brief Parse "cashuA..." token (padded or unpadded, urlsafe or standard base64)
+     * @throws std::invalid_argument if the prefix, base64 or JSON is invalid
+     */
+    static TokenV3 deserialize(std::string_view token);
+};
+
+/**
+ * @brief V4 token ("cashuB" + base64url CBOR)
+ * NUTSHELL COMPATIBILITY: Matches TokenV4 in nutshell base.py
+ *
+ * Proofs are grouped by keyset id in first-seen order; keyset ids, C and
+ * DLEQ fields are carried as bytes, so only hex keyset ids are supported.
+ */
+class TokenV4 {
+public:
+    static constexpr std::string_view PREFIX = "cashuB";
+
+    std::string mint;
+    std::string unit;
+    std::optional<std::string> memo;
+    std::vector<Proof> proofs;
+
+    /**
+     * @brief Total amount of all proofs
+     * @throws std::overflow_error if the sum exceeds 64 bits
+     */
+    amount_t amount() const;
+
+    /**
+     * @brief Append CBOR encoding to out
+     * @param out Output buffer (existing contents are kept)
+     * @param include_dleq Whether to include DLEQ proofs
+     * @throws std::invalid_argument if a keyset id, C or DLEQ field is not hex
+     */
+    void to_cbor(std::vector<uint8_t>& out, bool include_dleq = false) const;
+
+    /**
+     * @brief Append "cashuB..." (padded base64url, as nutshell) to out
+     * @param out Output buffer (existing contents are kept)
+     * @param include_dleq Whether to include DLEQ proofs
+     * @throws std::invalid_argument if a keyset id, C or DLEQ field is not hex
+     */
+    void serialize(std::string& out, bool include_dleq = false) const;
+
+    /**
+     * @brief Serialize to "cashuB..."
+     */
+    std::string serialize(bool include_dleq = false) const;
+
+    /**
+     * @brief Parse "cashuB..." token into owning form
+     * @throws std::invalid_argument if the prefix, base64 or CBOR is invalid
+     */
+    static TokenV4 deserialize(std::string_view token);
+
+    /**
+     * @brief Convert V3 token (single mint only; unit defaults to "sat")
+     * @throws std::invalid_argument if the V3 token does not have exactly one mint
+     */
+    static TokenV4 from_v3(const TokenV3& token);
+
+    /**
+     * @brief Convert to V3 token
+     */
+    TokenV3 to_v3() const;
+};
+
+/**
+ * @brief Zero-copy view of a decoded V4 token
+ *
+ * All string and byte views point into the buffer passed to parse() or
+ * parse_cbor(); the buffer must outlive the view and stay unmodified.
+ */
+class TokenV4View {
+public:
+    std::string_view mint;
+    std::string_view unit;
+    std::optional<std::string_view> memo;
+    std::vector<ProofView> proofs;  // Flattened across keyset groups, in token order
+
+    /**
+     * @brief Decode "cashuB..." token
+     * @param token Serialized token
+     * @param buffer Receives the decoded CBOR bytes (reused across calls)
+     * @return View into buffer
+     * @throws std::invalid_argument if the prefix, base64 or CBOR is invalid
+     */
+    static TokenV4View parse(std::string_view token, std::vector<uint8_t>& buffer);
+
+    /**
+     * @brief Decode raw CBOR token body
+     * @param data CBOR bytes
+     * @param size Number of bytes
+     * @return View into data
+     * @throws std::invalid_argument if the CBOR is invalid or misses required fields
+     */
+    static TokenV4View parse_cbor(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Total amount of all proofs
+     * @throws std::overflow_error if the sum exceeds 64 bits
+     */
+    amount_t amount() const;
+
+    /**
+     * @brief Copy into owning proofs
+     */
+    std::vector<Proof> to_proofs() const;
+
+    /**
+     * @brief Copy into owning token
+     */
+    TokenV4 to_token() const;
+
+    /**
+     * @brief Append proofs to a batch without hex round trips
+     *
+     * Keyset ids are resolved with KeysetInterner::global().find(), so
+     * untrusted tokens cannot grow the interner. Y is left pending; call
+     * batch.compute_pending_Y() once after appending.
+     *
+     * @param batch Destination batch
+     * @throws KeysetNotFoundError if a keyset id was never interned
+     * @throws std::invalid_argument if a C field is not 33 bytes
+     */
+    void append_to(ProofBatch& batch) const;
+};
+
+} // namespace cashu::core::base
@@ -0,0 +1,55 @@
+// Checked 64-bit amount arithmetic implementation
+
+#include "cashu/core/amount.hpp"
+
+using namespace std;
+
+namespace cashu::core {
+
+amount_t checked_sum(const amount_t* values, size_t count) {
+    constexpr size_t LANES = 4;
+    amount_t lane_sum[LANES] = {0, 0, 0, 0};
+    amount_t lane_carry[LANES] = {0, 0, 0, 0};
+
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            amount_t value = values[i + lane];
+            lane_sum[lane] += value;
+            lane_carry[lane] |= static_cast<amount_t>(lane_sum[lane] < value);
+        }
+    }
+
+    amount_t total = 0;
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        if (lane_carry[lane] != 0) {
+            throw overflow_error("Amount sum exceeds 64 bits");
+        }
+        total = checked_add(total, lane_sum[lane]);
+    }
+    for (; i < count; ++i) {
+        total = checked_add(total, values[i]);
+    }
+    return total;
+}
+
+amount_t parse_amount(const string& str) {
+    if (str.empty() || str.size() > 20) {
+        throw invalid_argument("Invalid amount: " + str);
+    }
+
+    amount_t value = 0;
+    for (char c : str) {
+        if (c < '0' || c > '9') {
+            throw invalid_argument("Invalid amount: " + str);
+        }
+        amount_t digit = static_cast<amount_t>(c - '0');
+        if (value > (UINT64_MAX - digit) / 10) {
+            throw invalid_argument("Amount exceeds 64 bits: " + str);
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+} // namespace cashu::core
@@ -4,18 +4,91 @@
 
 #include "cashu/core/base.hpp"
 #include "cashu/core/crypto/b_dhke.hpp"
+#include "cashu/core/thread_pool.hpp"
+#include <nlohmann/json.hpp>
 
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <type_traits>
 
 using namespace std;
-using namespace boost::multiprecision;
+using json = nlohmann::json;
 
 namespace cashu::core::base {
 
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // |value| for negative int operands of Amount operators (safe for INT_MIN)
+    amount_t magnitude(int value) {
+        return static_cast<amount_t>(-static_cast<int64_t>(value));
+    }
+
+    // Rough serialized size of one BlindedSignature with DLEQ, for reserve()
+    constexpr size_t SIGNATURE_JSON_ESTIMATE = 256;
+
+    // Witness "signatures" list
+    vector<string> parse_signatures(const json& signatures) {
+        if (!signatures.is_array()) {
+            throw invalid_argument("Witness signatures must be a list of strings");
+        }
+        vector<string> result;
+        result.reserve(signatures.size());
+        for (const auto& signature : signatures) {
+            if (!signature.is_string()) {
+                throw invalid_argument("Witness signatures must be a list of strings");
+            }
+            result.push_back(signature.get<string>());
+        }
+        return result;
+    }
+
+    template<typename T>
+    string serialize(const T& object) {
+        string out;
+        JsonWriter writer(out);
+        object.write_json(writer);
+        return out;
+    }
+}
+
+//=============================================================================
+// Point Functions
+//=============================================================================
+
+Point33 point_from_hex(string_view hex, const char* field) {
+    Point33 point{};
+    if (!try_point_from_hex(hex, point)) {
+        throw invalid_argument(string(field) + " must be a 33-byte compressed point hex");
+    }
+    return point;
+}
+
+bool try_point_from_hex(string_view hex, Point33& point) noexcept {
+    return crypto::secp_utils::hex_to_bytes(hex, point.data(), point.size());
+}
+
+string point_to_hex(const Point33& point) {
+    return crypto::secp_utils::bytes_to_hex(point.data(), point.size());
+}
+
+Point33 hash_to_curve_Y(string_view secret) {
+    // NUTSHELL COMPATIBILITY: Uses same method as nutshell base.py
+    // Y = hash_to_curve(secret.encode()).serialize()
+    vector<uint8_t> serialized = crypto::hash_to_curve(vector<uint8_t>(secret.begin(), secret.end())).serialize(true);
+    if (serialized.size() != 33) {
+        throw runtime_error("hash_to_curve did not return a compressed point");
+    }
+    Point33 point{};
+    copy(serialized.begin(), serialized.end(), point.begin());
+    return point;
+}
+
 //=============================================================================
 // DLEQ Implementation
 //=============================================================================
@@ -23,9 +96,14 @@ namespace cashu::core::base {
 DLEQ::DLEQ(const string& e, const string& s) : e(e), s(s) {}
 
 string DLEQ::to_json() const {
-    ostringstream oss;
-    oss << "{\"e\":\"" << e << "\",\"s\":\"" << s << "\"}";
-    return oss.str();
+    return serialize(*this);
+}
+
+void DLEQ::write_json(JsonWriter& writer) const {
+    writer.begin_object()
+        .field("e", e)
+        .field("s", s)
+        .end_object();
 }
 
 //=============================================================================
@@ -35,9 +113,15 @@ string DLEQ::to_json() const {
 DLEQWallet::DLEQWallet(const string& e, const string& s, const string& r) : e(e), s(s), r(r) {}
 
 string DLEQWallet::to_json() const {
-    ostringstream oss;
-    oss << "{\"e\":\"" << e << "\",\"s\":\"" << s << "\",\"r\":\"" << r << "\"}";
-    return oss.str();
+    return serialize(*this);
+}
+
+void DLEQWallet::write_json(JsonWriter& writer) const {
+    writer.begin_object()
+        .field("e", e)
+        .field("s", s)
+        .field("r", r)
+        .end_object();
 }
 
 //=============================================================================
@@ -68,13 +152,17 @@ ProofState::ProofState(const string& Y, ProofSpentState state, const optional<st
     : Y(Y), state(state), witness(witness) {}
 
 string ProofState::to_json() const {
-    ostringstream oss;
-    oss << "{\"Y\":\"" << Y << "\",\"state\":\"" << to_string(state) << "\"";
+    return serialize(*this);
+}
+
+void ProofState::write_json(JsonWriter& writer) const {
+    writer.begin_object()
+        .field("Y", Y)
+        .field("state", to_string(state));
     if (witness.has_value()) {
-        oss << ",\"witness\":\"" << witness.value() << "\"";
+        writer.field("witness", witness.value());
     }
-    oss << "}";
-    return oss.str();
+    writer.end_object();
 }
 
 //=============================================================================
@@ -82,30 +170,43 @@ string ProofState::to_json() const {
 //=============================================================================
 
 HTLCWitness HTLCWitness::from_witness(const string& witness) {
-    // NUTSHELL COMPATIBILITY: Simplified implementation for hybrid testing
-    // In a real implementation, this would parse JSON witness
+    // NUTSHELL COMPATIBILITY: cls(**json.loads(witness))
+    json parsed = json::parse(witness, nullptr, false);
+    if (parsed.is_discarded() || !parsed.is_object()) {
+        throw invalid_argument("Witness must be a JSON object");
+    }
     HTLCWitness result;
-    result.preimage = witness; // Simplified: treat witness as preimage
+    auto preimage = parsed.find("preimage");
+    if (preimage != parsed.end() && !preimage->is_null()) {
+        if (!preimage->is_string()) {
+            throw invalid_argument("Witness preimage must be a string");
+        }
+        result.preimage = preimage->get<string>();
+    }
+    auto signatures = parsed.find("signatures");
+    if (signatures != parsed.end() && !signatures->is_null()) {
+        result.signatures = parse_signatures(*signatures);
+    }
     return result;
 }
 
 string HTLCWitness::to_json() const {
-    ostringstream oss;
-    oss << "{";
+    return serialize(*this);
+}
+
+void HTLCWitness::write_json(JsonWriter& writer) const {
+    writer.begin_object();
     if (preimage.has_value()) {
-        oss << "\"preimage\":\"" << preimage.value() << "\"";
+        writer.field("preimage", preimage.value());
     }
     if (signatures.has_value()) {
-        if (preimage.has_value()) oss << ",";
-        oss << "\"signatures\":[";
-        for (size_t i = 0; i < signatures.value().size(); ++i) {
-            if (i > 0) oss << ",";
-            oss << "\"" << signatures.value()[i] << "\"";
+        writer.key("signatures").begin_array();
+        for (const auto& signature : signatures.value()) {
+            writer.value(signature);
         }
-        oss << "]";
+        writer.end_array();
     }
-    oss << "}";
-    return oss.str();
+    writer.end_object();
 }
 
 //=============================================================================
@@ -115,107 +216,228 @@ string HTLCWitness::to_json() const {
 P2PKWitness::P2PKWitness(const vector<string>& signatures) : signatures(signatures) {}
 
 P2PKWitness P2PKWitness::from_witness(const string& witness) {
-    // NUTSHELL COMPATIBILITY: Simplified implementation for hybrid testing
-    // In a real implementation, this would parse JSON witness
-    P2PKWitness result;
-    result.signatures = {witness}; // Simplified: treat witness as single signature
-    return result;
+    // NUTSHELL COMPATIBILITY: cls(**json.loads(witness))
+    json parsed = json::parse(witness, nullptr, false);
+    if (parsed.is_discarded() || !parsed.is_object()) {
+        throw invalid_argument("Witness must be a JSON object");
+    }
+    auto signatures = parsed.find("signatures");
+    if (signatures == parsed.end()) {
+        throw invalid_argument("Witness is missing signatures");
+    }
+    return P2PKWitness(parse_signatures(*signatures));
 }
 
 string P2PKWitness::to_json() const {
-    ostringstream oss;
-    oss << "{\"signatures\":[";
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        if (i > 0) oss << ",";
-        oss << "\"" << signatures[i] << "\"";
+    return serialize(*this);
+}
+
+void P2PKWitness::write_json(JsonWriter& writer) const {
+    writer.begin_object().key("signatures").begin_array();
+    for (const auto& signature : signatures) {
+        writer.value(signature);
     }
-    oss << "]}";
-    return oss.str();
+    writer.end_array().end_object();
 }
 
 //=============================================================================
 // Proof Implementation
 //=============================================================================
 
-Proof::Proof(const string& id, const cpp_int& amount, const string& secret, const string& C)
-    : id(id), amount(amount), secret(secret), C(C) {
-    compute_Y();
+Proof::Proof(const string& id, amount_t amount, const string& secret, const string& C)
+    : amount(amount), secret(secret), C(C) {
+    set_id(id);
+    // Y is computed on first access
 }
 
-void Proof::compute_Y() {
-    // NUTSHELL COMPATIBILITY: Uses same method as nutshell base.py
-    // Y = hash_to_curve(secret.encode()).serialize().hex()
-    if (!secret.empty()) {
-        auto point = cashu::core::crypto::hash_to_curve(secret);
-        Y = point.to_hex();
+Proof::Proof(KeysetHandle keyset, amount_t amount, const string& secret, const string& C)
+    : amount(amount), secret(secret), C(C), keyset_(keyset) {
+    if (!keyset.valid()) {
+        throw invalid_argument("Proof requires an interned keyset");
     }
 }
 
-unordered_map<string, variant<string, cpp_int, bool>> Proof::to_dict(bool include_dleq) const {
-    unordered_map<string, variant<string, cpp_int, bool>> result;
-    result["id"] = id;
-    result["amount"] = amount;
-    result["secret"] = secret;
-    result["C"] = C;
-    
-    if (include_dleq && dleq.has_value()) {
-        // NUTSHELL COMPATIBILITY: Would require JSON serialization of DLEQ
-        // For now, we'll skip this complex serialization
+void Proof::set_id(string_view id) {
+    keyset_ = KeysetInterner::global().find(id).value_or(KeysetHandle{});
+    id_ = keyset_.valid() ? string() : string(id);
+}
+
+void Proof::compute_Y() const {
+    Y_ = hash_to_curve_Y(secret);
+}
+
+string Proof::Y() const {
+    if (!Y_ && secret.empty()) {
+        return "";
     }
-    
-    if (witness.has_value()) {
-        result["witness"] = witness.value();
+    return point_to_hex(Y_bytes());
+}
+
+const array<uint8_t, 33>& Proof::Y_bytes() const {
+    if (!Y_) {
+        if (secret.empty()) {
+            throw runtime_error("Cannot compute Y of proof without secret");
+        }
+        compute_Y();
+    }
+    return *Y_;
+}
+
+void Proof::set_Y(const string& Y_hex) {
+    Y_ = point_from_hex(Y_hex, "Y");
+}
+
+void Proof::set_Y(const array<uint8_t, 33>& Y_bytes) {
+    Y_ = Y_bytes;
+}
+
+void Proof::compute_Y_batch(vector<Proof>& proofs) {
+    // Indices of proofs still needing hash_to_curve
+    vector<size_t> pending;
+    for (size_t i = 0; i < proofs.size(); ++i) {
+        if (!proofs[i].Y_ && !proofs[i].secret.empty()) {
+            pending.push_back(i);
+        }
     }
     
+    // Each chunk writes disjoint proofs
+    constexpr size_t MIN_CHUNK_SIZE = 32;
+    ThreadPool::global().parallel_for(pending.size(), MIN_CHUNK_SIZE, [&proofs, &pending](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            proofs[pending[i]].compute_Y();
+        }
+    });
+}
+
+unordered_map<string, variant<string, amount_t, bool>> Proof::to_dict(bool include_dleq) const {
+    unordered_map<string, variant<string, amount_t, bool>> result;
+    visit([&result](string_view key, const auto& value) {
+        using Value = decay_t<decltype(value)>;
+        if constexpr (is_same_v<Value, DLEQWallet>) {
+            result.emplace(string(key), value.to_json());
+        } else if constexpr (is_same_v<Value, string_view>) {
+            result.emplace(string(key), string(value));
+        } else {
+            result.emplace(string(key), value);
+        }
+    }, include_dleq ? ProofProjection::WITH_DLEQ : ProofProjection::NO_DLEQ);
     return result;
 }
 
-unordered_map<string, variant<string, cpp_int, bool>> Proof::to_dict_no_dleq() const {
+unordered_map<string, variant<string, amount_t, bool>> Proof::to_dict_no_dleq() const {
     return to_dict(false);
 }
 
-unordered_map<string, variant<string, cpp_int, bool>> Proof::to_dict_no_secret() const {
-    unordered_map<string, variant<string, cpp_int, bool>> result;
-    result["id"] = id;
-    result["amount"] = amount;
-    result["C"] = C;
+unordered_map<string, variant<string, amount_t, bool>> Proof::to_dict_no_secret() const {
+    unordered_map<string, variant<string, amount_t, bool>> result;
+    visit([&result](string_view key, const auto& value) {
+        using Value = decay_t<decltype(value)>;
+        if constexpr (is_same_v<Value, string_view>) {
+            result.emplace(string(key), string(value));
+        } else if constexpr (is_same_v<Value, amount_t>) {
+            result.emplace(string(key), value);
+        }
+    }, ProofProjection::NO_SECRET);
     return result;
 }
 
+string Proof::to_json(ProofProjection projection) const {
+    string out;
+    JsonWriter writer(out);
+    write_json(writer, projection);
+    return out;
+}
+
+void Proof::write_json(JsonWriter& writer, ProofProjection projection) const {
+    writer.begin_object();
+    visit([&writer](string_view key, const auto& value) {
+        writer.key(key);
+        if constexpr (is_same_v<decay_t<decltype(value)>, DLEQWallet>) {
+            value.write_json(writer);
+        } else {
+            writer.value(value);
+        }
+    }, projection);
+    writer.end_object();
+}
+
+void write_json_array(JsonWriter& writer, const Proof* proofs, size_t count, ProofProjection projection) {
+    writer.begin_array();
+    for (size_t i = 0; i < count; ++i) {
+        proofs[i].write_json(writer, projection);
+    }
+    writer.end_array();
+}
+
+struct Proof::ConditionCache {
+    optional<secret::Secret> secret;
+    optional<string> secret_error;  // Malformed spending-condition tag of a NUT-10 secret
+    HTLCWitness witness;
+};
+
+const Proof::ConditionCache& Proof::conditions() const {
+    if (!conditions_) {
+        auto cache = make_shared<ConditionCache>();
+        if (secret::Secret::is_well_known(secret)) {
+            try {
+                cache->secret = secret::Secret::parse(secret);
+            } catch (const exception&) {
+                // Not a NUT-10 secret; spent like a plain secret
+            }
+            if (cache->secret.has_value()) {
+                // A NUT-10 lock with a bad tag value must not be spent as a plain secret
+                try {
+                    cache->secret->decode_tags();
+                } catch (const exception& e) {
+                    cache->secret_error = e.what();
+                }
+            }
+        }
+        if (witness.has_value()) {
+            try {
+                cache->witness = HTLCWitness::from_witness(witness.value());
+            } catch (const exception&) {
+                // Malformed witness carries no signatures or preimage
+            }
+        }
+        conditions_ = move(cache);
+    }
+    return *conditions_;
+}
+
+const secret::Secret* Proof::nut10_secret() const {
+    const auto& cache = conditions();
+    return cache.secret.has_value() ? &cache.secret.value() : nullptr;
+}
+
+const string* Proof::secret_error() const {
+    const auto& cache = conditions();
+    return cache.secret_error.has_value() ? &cache.secret_error.value() : nullptr;
+}
+
+const HTLCWitness& Proof::parsed_witness() const {
+    return conditions().witness;
+}
+
 vector<string> Proof::p2pksigs() const {
     if (!witness.has_value()) {
         throw runtime_error("Witness is missing for p2pk signature");
     }
-    try {
-        P2PKWitness p2pk_witness = P2PKWitness::from_witness(witness.value());
-        return p2pk_witness.signatures;
-    } catch (const exception&) {
-        return {};
-    }
+    return parsed_witness().signatures.value_or(vector<string>{});
 }
 
 optional<string> Proof::htlcpreimage() const {
     if (!witness.has_value()) {
         throw runtime_error("Witness is missing for htlc preimage");
     }
-    try {
-        HTLCWitness htlc_witness = HTLCWitness::from_witness(witness.value());
-        return htlc_witness.preimage;
-    } catch (const exception&) {
-        return nullopt;
-    }
+    return parsed_witness().preimage;
 }
 
 optional<vector<string>> Proof::htlcsigs() const {
     if (!witness.has_value()) {
         throw runtime_error("Witness is missing for htlc signatures");
     }
-    try {
-        HTLCWitness htlc_witness = HTLCWitness::from_witness(witness.value());
-        return htlc_witness.signatures;
-    } catch (const exception&) {
-        return nullopt;
-    }
+    return parsed_witness().signatures;
 }
 
 //=============================================================================
@@ -248,7 +470,7 @@ Unit unit_from_string(const string& str) {
 // Amount Implementation
 //=============================================================================
 
-Amount::Amount(Unit unit, const cpp_int& amount) : unit(unit), amount(amount) {}
+Amount::Amount(Unit unit, amount_t amount) : unit(unit), amount(amount) {}
 
 Amount Amount::to(Unit to_unit, const optional<string>& round) const {
     // NUTSHELL COMPATIBILITY: Matches unit conversion logic in nutshell base.py
@@ -258,15 +480,14 @@ Amount Amount::to(Unit to_unit, const optional<string>& round) const {
     
     if (unit == Unit::SAT) {
         if (to_unit == Unit::MSAT) {
-            return Amount(to_unit, amount * 1000);
+            return Amount(to_unit, checked_mul(amount, 1000));
         }
     } else if (unit == Unit::MSAT) {
         if (to_unit == Unit::SAT) {
             if (round == "up") {
-                return Amount(to_unit, static_cast<int>(ceil(static_cast<double>(amount) / 1000.0)));
-            } else if (round == "down") {
-                return Amount(to_unit, static_cast<int>(floor(static_cast<double>(amount) / 1000.0)));
+                return Amount(to_unit, amount / 1000 + (amount % 1000 != 0 ? 1 : 0));
             } else {
+                // "down" and no rounding both truncate
                 return Amount(to_unit, amount / 1000);
             }
         }
@@ -286,9 +507,9 @@ string Amount::to_float_string() const {
         case Unit::MSAT:
             return msat_to_btc();
         case Unit::BTC:
-            return amount.str() + " BTC";
+            return std::to_string(amount) + " BTC";
         case Unit::AUTH:
-            return amount.str() + " auth";
+            return std::to_string(amount) + " auth";
         default:
             throw invalid_argument("Amount must be in satoshis or cents");
     }
@@ -298,9 +519,9 @@ string Amount::str() const {
     // NUTSHELL COMPATIBILITY: Matches string formatting in nutshell base.py
     switch (unit) {
         case Unit::SAT:
-            return amount.str() + " sat";
+            return std::to_string(amount) + " sat";
         case Unit::MSAT:
-            return amount.str() + " msat";
+            return std::to_string(amount) + " msat";
         case Unit::USD: {
             ostringstream oss;
             oss << "$" << fixed << setprecision(2) << (static_cast<double>(amount) / 100.0) << " USD";
@@ -317,7 +538,7 @@ string Amount::str() const {
             return oss.str();
         }
         case Unit::AUTH:
-            return amount.str() + " AUTH";
+            return std::to_string(amount) + " AUTH";
         default:
             throw invalid_argument("Invalid unit");
     }
@@ -325,17 +546,27 @@ string Amount::str() const {
 
 Amount Amount::from_float(double amount_float, Unit unit) {
     // NUTSHELL COMPATIBILITY: Matches float conversion in nutshell base.py
+    double scale;
     switch (unit) {
         case Unit::USD:
         case Unit::EUR:
-            return Amount(unit, static_cast<int>(round(amount_float * 100)));
+            scale = 100;
+            break;
         case Unit::SAT:
-            return Amount(unit, static_cast<int>(round(amount_float * 1e8)));
+            scale = 1e8;
+            break;
         case Unit::MSAT:
-            return Amount(unit, static_cast<int>(round(amount_float * 1e11)));
+            scale = 1e11;
+            break;
         default:
             throw invalid_argument("Amount must be in satoshis or cents");
     }
+    
+    double scaled = round(amount_float * scale);
+    if (!(scaled >= 0) || scaled >= 18446744073709551616.0) {
+        throw invalid_argument("Amount out of range: " + std::to_string(amount_float));
+    }
+    return Amount(unit, static_cast<amount_t>(scaled));
 }
 
 string Amount::sat_to_btc() const {
@@ -374,26 +605,31 @@ Amount Amount::operator+(const Amount& other) const {
     if (unit != other.unit) {
         throw invalid_argument("Units must be the same");
     }
-    return Amount(unit, amount + other.amount);
+    return Amount(unit, checked_add(amount, other.amount));
 }
 
 Amount Amount::operator+(int other) const {
-    return Amount(unit, amount + other);
+    return other >= 0 ? Amount(unit, checked_add(amount, static_cast<amount_t>(other)))
+                      : Amount(unit, checked_sub(amount, magnitude(other)));
 }
 
 Amount Amount::operator-(const Amount& other) const {
     if (unit != other.unit) {
         throw invalid_argument("Units must be the same");
     }
-    return Amount(unit, amount - other.amount);
+    return Amount(unit, checked_sub(amount, other.amount));
 }
 
 Amount Amount::operator-(int other) const {
-    return Amount(unit, amount - other);
+    return other >= 0 ? Amount(unit, checked_sub(amount, static_cast<amount_t>(other)))
+                      : Amount(unit, checked_add(amount, magnitude(other)));
 }
 
 Amount Amount::operator*(int other) const {
-    return Amount(unit, amount * other);
+    if (other < 0 && amount != 0) {
+        throw underflow_error("Amount underflow: " + std::to_string(amount) + " * " + std::to_string(other));
+    }
+    return Amount(unit, other < 0 ? 0 : checked_mul(amount, static_cast<amount_t>(other)));
 }
 
 bool Amount::operator==(const Amount& other) const {
@@ -404,7 +640,7 @@ bool Amount::operator==(const Amount& other) const {
 }
 
 bool Amount::operator==(int other) const {
-    return amount == other;
+    return other >= 0 && amount == static_cast<amount_t>(other);
 }
 
 bool Amount::operator<(const Amount& other) const {
@@ -415,7 +651,7 @@ bool Amount::operator<(const Amount& other) const {
 }
 
 bool Amount::operator<(int other) const {
-    return amount < other;
+    return other > 0 && amount < static_cast<amount_t>(other);
 }
 
 bool Amount::operator<=(const Amount& other) const {
@@ -426,7 +662,7 @@ bool Amount::operator<=(const Amount& other) const {
 }
 
 bool Amount::operator<=(int other) const {
-    return amount <= other;
+    return other >= 0 && amount <= static_cast<amount_t>(other);
 }
 
 bool Amount::operator>(const Amount& other) const {
@@ -437,7 +673,7 @@ bool Amount::operator>(const Amount& other) const {
 }
 
 bool Amount::operator>(int other) const {
-    return amount > other;
+    return other < 0 || amount > static_cast<amount_t>(other);
 }
 
 bool Amount::operator>=(const Amount& other) const {
@@ -448,7 +684,7 @@ bool Amount::operator>=(const Amount& other) const {
 }
 
 bool Amount::operator>=(int other) const {
-    return amount >= other;
+    return other <= 0 || amount >= static_cast<amount_t>(other);
 }
 
 //=============================================================================
@@ -513,30 +749,95 @@ MintQuoteState mint_quote_state_from_string(const string& str) {
 // BlindedMessage Implementation
 //=============================================================================
 
-BlindedMessage::BlindedMessage(const cpp_int& amount, const string& id, const string& B_)
-    : amount(amount), id(id), B_(B_) {}
+BlindedMessage::BlindedMessage(amount_t amount, const string& id, const string& B_)
+    : amount(amount), B_(B_) {
+    set_id(id);
+}
+
+BlindedMessage::BlindedMessage(amount_t amount, KeysetHandle keyset, const string& B_)
+    : amount(amount), B_(B_), keyset_(keyset) {
+    if (!keyset.valid()) {
+        throw invalid_argument("BlindedMessage requires an interned keyset");
+    }
+}
+
+void BlindedMessage::set_id(string_view id) {
+    keyset_ = KeysetInterner::global().find(id).value_or(KeysetHandle{});
+    id_ = keyset_.valid() ? string() : string(id);
+}
 
 string BlindedMessage::to_json() const {
-    ostringstream oss;
-    oss << "{\"amount\":" << amount << ",\"id\":\"" << id << "\",\"B_\":\"" << B_ << "\"}";
-    return oss.str();
+    return serialize(*this);
+}
+
+void BlindedMessage::write_json(JsonWriter& writer) const {
+    writer.begin_object()
+        .field("amount", amount)
+        .field("id", id())
+        .field("B_", B_)
+        .end_object();
+}
+
+void write_json_array(JsonWriter& writer, const BlindedMessage* messages, size_t count) {
+    writer.begin_array();
+    for (size_t i = 0; i < count; ++i) {
+        messages[i].write_json(writer);
+    }
+    writer.end_array();
 }
 
 //=============================================================================
 // BlindedSignature Implementation
 //=============================================================================
 
-BlindedSignature::BlindedSignature(const string& id, const cpp_int& amount, const string& C_, const optional<DLEQ>& dleq)
-    : id(id), amount(amount), C_(C_), dleq(dleq) {}
+BlindedSignature::BlindedSignature(const string& id, amount_t amount, const string& C_, const optional<DLEQ>& dleq)
+    : amount(amount), C_(C_), dleq(dleq) {
+    set_id(id);
+}
+
+BlindedSignature::BlindedSignature(KeysetHandle keyset, amount_t amount, const string& C_, const optional<DLEQ>& dleq)
+    : amount(amount), C_(C_), dleq(dleq), keyset_(keyset) {
+    if (!keyset.valid()) {
+        throw invalid_argument("BlindedSignature requires an interned keyset");
+    }
+}
+
+void BlindedSignature::set_id(string_view id) {
+    keyset_ = KeysetInterner::global().find(id).value_or(KeysetHandle{});
+    id_ = keyset_.valid() ? string() : string(id);
+}
 
 string BlindedSignature::to_json() const {
-    ostringstream oss;
-    oss << "{\"id\":\"" << id << "\",\"amount\":" << amount << ",\"C_\":\"" << C_ << "\"";
+    return serialize(*this);
+}
+
+void BlindedSignature::write_json(JsonWriter& writer) const {
+    writer.begin_object()
+        .field("id", id())
+        .field("amount", amount)
+        .field("C_", C_);
     if (dleq.has_value()) {
-        oss << ",\"dleq\":" << dleq.value().to_json();
+        writer.key("dleq");
+        dleq.value().write_json(writer);
     }
-    oss << "}";
-    return oss.str();
+    writer.end_object();
+}
+
+void write_json_array(JsonWriter& writer, const BlindedSignature* signatures, size_t count) {
+    writer.reserve(count * SIGNATURE_JSON_ESTIMATE);
+    writer.begin_array();
+    for (size_t i = 0; i < count; ++i) {
+        signatures[i].write_json(writer);
+    }
+    writer.end_array();
+}
+
+void write_signatures_response(string& out, const vector<BlindedSignature>& signatures) {
+    JsonWriter writer(out);
+    writer.clear();
+    writer.begin_object().key("signatures");
+    write_json_array(writer, signatures.data(), signatures.size());
+    writer.end_object();
 }
 
 //=============================================================================
@@ -544,10 +845,16 @@ string BlindedSignature::to_json() const {
 //=============================================================================
 
 string MeltQuote::to_json() const {
+    return serialize(*this);
+}
+
+void MeltQuote::write_json(JsonWriter& writer) const {
     // NUTSHELL COMPATIBILITY: Basic JSON serialization
-    ostringstream oss;
-    oss << "{\"quote\":\"" << quote << "\",\"method\":\"" << method << "\",\"state\":\"" << to_string(state) << "\"}";
-    return oss.str();
+    writer.begin_object()
+        .field("quote", quote)
+        .field("method", method)
+        .field("state", to_string(state))
+        .end_object();
 }
 
 //=============================================================================
@@ -555,10 +862,16 @@ string MeltQuote::to_json() const {
 //=============================================================================
 
 string MintQuote::to_json() const {
+    return serialize(*this);
+}
+
+void MintQuote::write_json(JsonWriter& writer) const {
     // NUTSHELL COMPATIBILITY: Basic JSON serialization
-    ostringstream oss;
-    oss << "{\"quote\":\"" << quote << "\",\"method\":\"" << method << "\",\"state\":\"" << to_string(state) << "\"}";
-    return oss.str();
+    writer.begin_object()
+        .field("quote", quote)
+        .field("method", method)
+        .field("state", to_string(state))
+        .end_object();
 }
 
 } // namespace cashu::core::base
\ No newline at end of file
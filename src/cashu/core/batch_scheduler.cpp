@@ -0,0 +1,147 @@
+// NUTSHELL COMPATIBILITY: Ledger._generate_promises and Ledger._verify_proofs in cashu/mint/ledger.py
+// Signing and verification kernels for MicroBatcher - ENHANCEMENT beyond nutshell
+
+#include "cashu/core/batch_scheduler.hpp"
+#include "cashu/core/crypto/b_dhke.hpp"
+#include "cashu/core/errors.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // Below this many items a batch runs on its own task
+    constexpr size_t MIN_CHUNK_SIZE = 8;
+
+    // Handle resolved when the item's id was set
+    template<typename Item>
+    KeysetHandle find_keyset(const Item& item) {
+        KeysetHandle handle = item.keyset_handle();
+        if (!handle.valid()) {
+            throw KeysetNotFoundError(item.id());
+        }
+        return handle;
+    }
+
+    // Keys are resolved once per batch rather than once per item
+    const KeysetPrivateKeys& keyset_keys(const KeyProvider& keys, KeysetHandle keyset) {
+        const KeysetPrivateKeys* table = keys(keyset);
+        if (table == nullptr) {
+            throw KeysetNotFoundError(KeysetInterner::global().id(keyset));
+        }
+        return *table;
+    }
+
+    const crypto::PrivateKey& amount_key(const KeysetPrivateKeys& table, amount_t amount) {
+        const crypto::PrivateKey* key = table.find(amount);
+        if (key == nullptr) {
+            throw invalid_argument("no key for amount " + to_string(amount));
+        }
+        return *key;
+    }
+
+    crypto::PublicKey to_public_key(const base::Point33& point) {
+        return crypto::PublicKey(vector<uint8_t>(point.begin(), point.end()));
+    }
+
+    // Run item(i) for every job in parallel, recording per-item failures
+    template<typename Item>
+    void for_each_job(ThreadPool& pool, size_t count, exception_ptr* errors, Item item) {
+        pool.parallel_for(count, MIN_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    item(i);
+                } catch (...) {
+                    errors[i] = current_exception();
+                }
+            }
+        }, TaskPriority::HIGH);
+    }
+}
+
+//=============================================================================
+// BatchingOptions Implementation
+//=============================================================================
+
+BatchingOptions BatchingOptions::from_settings(const settings::MintSettings& settings) {
+    BatchingOptions options;
+    options.window = chrono::microseconds(settings.mint_batch_window_us);
+    options.max_batch_size = static_cast<size_t>(settings.mint_batch_max_size);
+    return options;
+}
+
+BatchingOptions BatchingOptions::current() {
+    return from_settings(settings::current_settings());
+}
+
+//=============================================================================
+// SigningScheduler Implementation
+//=============================================================================
+
+SigningScheduler::SigningScheduler(KeyProvider keys, const BatchingOptions& options, ThreadPool& pool)
+    : batcher_([keys = move(keys), &pool](KeysetHandle keyset, const SignJob* jobs, size_t count,
+                                          base::BlindedSignature* results, exception_ptr* errors) {
+          const KeysetPrivateKeys& table = keyset_keys(keys, keyset);
+          for_each_job(pool, count, errors, [&](size_t i) {
+              const crypto::PrivateKey& a = amount_key(table, jobs[i].amount);
+              auto [C_, e, s] = crypto::step2_bob(to_public_key(jobs[i].B_), a);
+              results[i] = base::BlindedSignature(keyset, jobs[i].amount, C_.to_hex(),
+                                                  base::DLEQ(e.to_hex(), s.to_hex()));
+          });
+      }, options, pool) {}
+
+future<base::BlindedSignature> SigningScheduler::sign(KeysetHandle keyset, amount_t amount, const base::Point33& B_) {
+    return batcher_.submit(keyset, SignJob{amount, B_});
+}
+
+future<base::BlindedSignature> SigningScheduler::sign(const base::BlindedMessage& output) {
+    return sign(find_keyset(output), output.amount, base::point_from_hex(output.B_, "B_"));
+}
+
+vector<future<base::BlindedSignature>> SigningScheduler::sign(const base::BlindedMessageBatch& outputs) {
+    vector<future<base::BlindedSignature>> futures;
+    futures.reserve(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        futures.push_back(sign(outputs.keyset(i), outputs.amount(i), outputs.B_()[i]));
+    }
+    return futures;
+}
+
+//=============================================================================
+// VerificationScheduler Implementation
+//=============================================================================
+
+VerificationScheduler::VerificationScheduler(KeyProvider keys, const BatchingOptions& options, ThreadPool& pool)
+    : batcher_([keys = move(keys), &pool](KeysetHandle keyset, const VerifyJob* jobs, size_t count,
+                                          bool* results, exception_ptr* errors) {
+          const KeysetPrivateKeys& table = keyset_keys(keys, keyset);
+          for_each_job(pool, count, errors, [&](size_t i) {
+              const crypto::PrivateKey& a = amount_key(table, jobs[i].amount);
+              results[i] = crypto::verify(a, to_public_key(jobs[i].C), jobs[i].secret);
+          });
+      }, options, pool) {}
+
+future<bool> VerificationScheduler::verify(KeysetHandle keyset, amount_t amount, string secret,
+                                           const base::Point33& C) {
+    return batcher_.submit(keyset, VerifyJob{amount, move(secret), C});
+}
+
+future<bool> VerificationScheduler::verify(const base::Proof& proof) {
+    return verify(find_keyset(proof), proof.amount, proof.secret, base::point_from_hex(proof.C, "C"));
+}
+
+vector<future<bool>> VerificationScheduler::verify(const base::ProofBatch& proofs) {
+    vector<future<bool>> futures;
+    futures.reserve(proofs.size());
+    for (size_t i = 0; i < proofs.size(); ++i) {
+        futures.push_back(verify(proofs.keyset(i), proofs.amount(i), string(proofs.secret(i)), proofs.C()[i]));
+    }
+    return futures;
+}
+
+} // namespace cashu::core
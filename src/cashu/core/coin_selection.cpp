@@ -0,0 +1,327 @@
+// NUTSHELL COMPATIBILITY: WalletTransactions._select_proofs_to_send and split_wallet_state
+// in cashu/wallet/transactions.py
+// Bucketed proof selection implementation
+
+#include "cashu/core/coin_selection.hpp"
+#include "cashu/core/output_plan.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    amount_t denomination_value(size_t index) {
+        return amount_t(1) << index;
+    }
+}
+
+//=============================================================================
+// ProofSelector Implementation
+//=============================================================================
+
+ProofSelector::ProofSelector(size_t target_amount_count, size_t max_inputs)
+    : target_amount_count_(target_amount_count), max_inputs_(max_inputs) {}
+
+ProofSelector ProofSelector::from_settings(const settings::WalletSettings& settings) {
+    // NUTSHELL COMPATIBILITY: proofs_batch_size sizes state-check requests and
+    // does not limit how many proofs a send may use
+    return ProofSelector(static_cast<size_t>(max(0, settings.wallet_target_amount_count)));
+}
+
+void ProofSelector::set_input_fee_ppk(KeysetHandle keyset, uint32_t fee_ppk) {
+    keysets_[keyset_index(keyset)].fee_ppk = fee_ppk;
+    stable_sort(by_fee_.begin(), by_fee_.end(), [this](uint16_t a, uint16_t b) {
+        return keysets_[a].fee_ppk < keysets_[b].fee_ppk;
+    });
+}
+
+void ProofSelector::set_input_fee_ppk(const models::WalletKeyset& keyset) {
+    if (!keyset.id.has_value() || keyset.id->empty()) {
+        throw invalid_argument("Keyset has no id");
+    }
+    int fee_ppk = keyset.input_fee_ppk.value_or(0);
+    if (fee_ppk < 0) {
+        throw invalid_argument("input_fee_ppk must be non-negative");
+    }
+    set_input_fee_ppk(KeysetInterner::global().intern(*keyset.id), static_cast<uint32_t>(fee_ppk));
+}
+
+ProofId ProofSelector::add(base::Proof proof) {
+    if (!crypto::is_valid_denomination(proof.amount)) {
+        throw invalid_argument("Proof amount must be a power of two: " + to_string(proof.amount));
+    }
+    if (!proof.reserved) {
+        // Overflow precheck only; insert_bucket() adds the amount to the balance
+        (void)checked_add(balance_, proof.amount);
+    }
+    // The wallet's own proofs: a keyset seen for the first time is interned
+    KeysetHandle handle = proof.keyset_handle();
+    if (!handle.valid()) {
+        handle = KeysetInterner::global().intern(proof.id());
+    }
+    uint16_t keyset = keyset_index(handle);
+
+    ProofId id;
+    if (!free_.empty()) {
+        id = free_.back();
+        free_.pop_back();
+    } else {
+        if (entries_.size() > NOT_IN_BUCKET - 1) {
+            throw length_error("Too many proofs");
+        }
+        id = static_cast<ProofId>(entries_.size());
+        entries_.emplace_back();
+    }
+    Entry& entry = entries_[id];
+    entry.denomination = static_cast<uint8_t>(crypto::lowest_bit_index(proof.amount));
+    entry.keyset = keyset;
+    entry.live = true;
+    entry.position = NOT_IN_BUCKET;
+    entry.proof = move(proof);
+    if (!entry.proof.reserved) {
+        insert_bucket(id);
+    }
+    return id;
+}
+
+void ProofSelector::remove(ProofId id) {
+    if (id >= entries_.size() || !entries_[id].live) {
+        throw out_of_range("Unknown proof id: " + to_string(id));
+    }
+    if (entries_[id].position != NOT_IN_BUCKET) {
+        erase_bucket(id);
+    }
+    entries_[id].live = false;
+    entries_[id].proof = base::Proof();
+    free_.push_back(id);
+}
+
+void ProofSelector::set_reserved(ProofId id, bool reserved) {
+    if (id >= entries_.size() || !entries_[id].live) {
+        throw out_of_range("Unknown proof id: " + to_string(id));
+    }
+    Entry& entry = entries_[id];
+    bool in_bucket = entry.position != NOT_IN_BUCKET;
+    if (reserved && in_bucket) {
+        erase_bucket(id);
+    } else if (!reserved && !in_bucket) {
+        insert_bucket(id);
+    }
+    entry.proof.reserved = reserved;
+}
+
+void ProofSelector::reserve(const ProofSelection& selection) {
+    for (ProofId id : selection.proofs) {
+        set_reserved(id, true);
+    }
+}
+
+vector<base::Proof> ProofSelector::proofs(const ProofSelection& selection) const {
+    vector<base::Proof> result;
+    result.reserve(selection.proofs.size());
+    for (ProofId id : selection.proofs) {
+        result.push_back(entries_[id].proof);
+    }
+    return result;
+}
+
+size_t ProofSelector::count(amount_t denomination) const {
+    return counts_[crypto::denomination_index(denomination)];
+}
+
+amount_t ProofSelector::fee(const vector<ProofId>& ids) const {
+    uint64_t fee_ppk = 0;
+    for (ProofId id : ids) {
+        fee_ppk += keysets_[entries_[id].keyset].fee_ppk;
+    }
+    return input_fee(fee_ppk);
+}
+
+ProofSelection ProofSelector::select(amount_t amount, bool include_fees) const {
+    ProofSelection selection;
+    if (amount == 0) {
+        return selection;
+    }
+
+    // Selecting more proofs can raise the fee; retry with the higher fee
+    // until the selection covers amount plus its own fee
+    array<size_t, DENOMINATIONS> take;
+    amount_t total = 0;
+    amount_t fee = 0;
+    for (amount_t assumed_fee = 0;;) {
+        amount_t target = checked_add(amount, assumed_fee);
+        if (target > balance_) {
+            throw runtime_error("Balance too low: " + to_string(balance_) + " < " + to_string(target));
+        }
+        plan(target, take);
+        total = 0;
+        for (size_t i = 0; i < DENOMINATIONS; ++i) {
+            total += take[i] * denomination_value(i);
+        }
+        fee = include_fees ? input_fee(plan_fee_ppk(take)) : 0;
+        if (total - amount >= fee) {
+            break;
+        }
+        assumed_fee = max(assumed_fee + 1, fee);
+    }
+
+    size_t count = 0;
+    for (size_t taken : take) {
+        count += taken;
+    }
+    if (max_inputs_ != 0 && count > max_inputs_) {
+        throw runtime_error("Sending " + to_string(amount) + " needs " + to_string(count) +
+                            " proofs, more than the limit of " + to_string(max_inputs_));
+    }
+
+    // Largest denominations first; cheapest keysets first within one
+    selection.proofs.reserve(count);
+    for (size_t i = DENOMINATIONS; i-- > 0;) {
+        size_t remaining = take[i];
+        for (size_t k = 0; remaining > 0 && k < by_fee_.size(); ++k) {
+            const vector<ProofId>& bucket = keysets_[by_fee_[k]].buckets[i];
+            size_t n = min(remaining, bucket.size());
+            selection.proofs.insert(selection.proofs.end(), bucket.end() - static_cast<ptrdiff_t>(n), bucket.end());
+            remaining -= n;
+        }
+    }
+    selection.amount = total;
+    selection.fee = fee;
+    return selection;
+}
+
+vector<amount_t> ProofSelector::plan_outputs(amount_t amount) const {
+    // NUTSHELL COMPATIBILITY: nutshell lists the missing proofs in ascending
+    // order and pops the largest until they fit into amount, which keeps the
+    // longest ascending prefix that fits
+    vector<amount_t> outputs;
+    amount_t remaining = amount;
+    for (size_t i = 0; i < DENOMINATIONS; ++i) {
+        if (counts_[i] >= target_amount_count_) {
+            continue;
+        }
+        amount_t value = denomination_value(i);
+        amount_t missing = target_amount_count_ - counts_[i];
+        amount_t fits = min(missing, remaining / value);
+        outputs.insert(outputs.end(), static_cast<size_t>(fits), value);
+        remaining -= fits * value;
+        if (fits < missing) {
+            break;
+        }
+    }
+    size_t planned = outputs.size();
+    outputs.resize(planned + split_count(remaining));
+    split_into(remaining, outputs.data() + planned);
+    sort(outputs.begin(), outputs.end());
+    return outputs;
+}
+
+uint16_t ProofSelector::keyset_index(KeysetHandle handle) {
+    for (size_t i = 0; i < keysets_.size(); ++i) {
+        if (keysets_[i].handle == handle) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    if (keysets_.size() > UINT16_MAX) {
+        throw length_error("Too many keysets");
+    }
+    keysets_.emplace_back();
+    keysets_.back().handle = handle;
+    uint16_t index = static_cast<uint16_t>(keysets_.size() - 1);
+    // A new keyset has fee 0 until set_input_fee_ppk(), so it goes first
+    by_fee_.insert(by_fee_.begin(), index);
+    return index;
+}
+
+void ProofSelector::insert_bucket(ProofId id) {
+    Entry& entry = entries_[id];
+    balance_ = checked_add(balance_, entry.proof.amount);
+    vector<ProofId>& bucket = keysets_[entry.keyset].buckets[entry.denomination];
+    entry.position = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(id);
+    ++counts_[entry.denomination];
+}
+
+void ProofSelector::erase_bucket(ProofId id) {
+    Entry& entry = entries_[id];
+    vector<ProofId>& bucket = keysets_[entry.keyset].buckets[entry.denomination];
+    ProofId last = bucket.back();
+    bucket[entry.position] = last;
+    entries_[last].position = entry.position;
+    bucket.pop_back();
+    entry.position = NOT_IN_BUCKET;
+    --counts_[entry.denomination];
+    balance_ -= entry.proof.amount;
+}
+
+void ProofSelector::plan(amount_t target, array<size_t, DENOMINATIONS>& take) const {
+    take.fill(0);
+
+    // below[i]: value of all proofs smaller than 2^i (bounded by balance_)
+    array<amount_t, DENOMINATIONS> below;
+    amount_t sum = 0;
+    for (size_t i = 0; i < DENOMINATIONS; ++i) {
+        below[i] = sum;
+        sum += counts_[i] * denomination_value(i);
+    }
+
+    // Greedy from the largest denomination. Invariant: proofs of 2^i and
+    // below are worth at least remaining (holds initially as target <= balance_).
+    // When the smaller proofs can no longer cover the rest, one more proof
+    // of 2^i does, with less than 2^i change; the invariant guarantees one is left.
+    amount_t remaining = target;
+    size_t count = 0;
+    for (size_t i = DENOMINATIONS; i-- > 0 && remaining > 0;) {
+        if (counts_[i] == 0) {
+            continue;
+        }
+        amount_t value = denomination_value(i);
+        size_t n = static_cast<size_t>(min<amount_t>(counts_[i], remaining / value));
+        remaining -= n * value;
+        if (remaining > 0 && below[i] < remaining) {
+            ++n;
+            remaining = 0;
+        }
+        take[i] = n;
+        count += n;
+    }
+    if (count <= 1) {
+        return;
+    }
+
+    // A single proof with no more change than the greedy selection is better
+    amount_t greedy_total = 0;
+    for (size_t i = 0; i < DENOMINATIONS; ++i) {
+        greedy_total += take[i] * denomination_value(i);
+    }
+    for (size_t i = 0; i < DENOMINATIONS && denomination_value(i) <= greedy_total; ++i) {
+        if (counts_[i] > 0 && denomination_value(i) >= target) {
+            take.fill(0);
+            take[i] = 1;
+            return;
+        }
+    }
+}
+
+uint64_t ProofSelector::plan_fee_ppk(const array<size_t, DENOMINATIONS>& take) const {
+    uint64_t fee_ppk = 0;
+    for (size_t i = 0; i < DENOMINATIONS; ++i) {
+        size_t remaining = take[i];
+        for (size_t k = 0; remaining > 0 && k < by_fee_.size(); ++k) {
+            const Keyset& keyset = keysets_[by_fee_[k]];
+            size_t n = min(remaining, keyset.buckets[i].size());
+            fee_ppk += n * keyset.fee_ppk;
+            remaining -= n;
+        }
+    }
+    return fee_ppk;
+}
+
+} // namespace cashu::core
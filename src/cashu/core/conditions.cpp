@@ -0,0 +1,342 @@
+// NUTSHELL COMPATIBILITY: LedgerSpendingConditions in cashu/mint/conditions.py
+// Spending-condition verification for NUT-10 secrets (NUT-11 P2PK, NUT-14 HTLC)
+
+#include "cashu/core/conditions.hpp"
+#include "cashu/core/crypto/secp.hpp"
+#include <openssl/sha.h>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    using Digest = array<uint8_t, 32>;
+    using Pubkey = array<uint8_t, 33>;
+    using Signature = array<uint8_t, 64>;
+    using secret::Secret;
+    using secret::SecretKind;
+
+    // n of pubkeys must sign
+    struct Threshold {
+        vector<size_t> pubkeys;   // Indices into the pubkey table
+        size_t n_sigs = 1;
+    };
+
+    // Signatures over one digest that must meet any of the thresholds
+    struct Requirement {
+        size_t digest = 0;                // Index into digests
+        vector<size_t> signatures;        // Indices into the signature table
+        vector<Threshold> thresholds;
+        size_t first_check = 0;           // Set when checks are built
+    };
+
+    // HTLC hashlock: SHA-256(preimage) must equal hash
+    struct Hashlock {
+        vector<uint8_t> preimage;
+        Digest hash{};
+        bool hash_valid = false;
+    };
+
+    /**
+     * Collects every digest, hashlock and signature check of a transaction so
+     * each can be computed in a single pass. A method returning false has
+     * recorded the rejection in error().
+     */
+    class Batch {
+    public:
+        explicit Batch(int64_t now) : now_(now) {}
+
+        const Error& error() const { return *error_; }
+
+        bool add_hashlock(const Secret& secret, const base::HTLCWitness& witness) {
+            if (!witness.preimage.has_value()) {
+                return fail("no HTLC preimage provided");
+            }
+            const string& preimage = witness.preimage.value();
+            Hashlock lock;
+            lock.preimage.resize(preimage.size() / 2);
+            if (preimage.size() % 2 != 0 ||
+                !crypto::secp_utils::hex_to_bytes(preimage, lock.preimage.data(), lock.preimage.size())) {
+                return fail("invalid HTLC preimage");
+            }
+            lock.hash_valid = crypto::secp_utils::hex_to_bytes(secret.data, lock.hash.data(), lock.hash.size());
+            hashlocks_.push_back(move(lock));
+            return true;
+        }
+
+        // Add conditions of secret; signatures are over message, which must outlive run()
+        bool add_condition(const Secret& secret, const base::HTLCWitness& witness, string_view message) {
+            bool expired = secret.locktime.has_value() && secret.locktime.value() < now_;
+            if (expired && secret.refund.empty()) {
+                return true;  // Anyone can spend after locktime
+            }
+
+            Requirement requirement;
+            if (secret.kind == SecretKind::HTLC) {
+                if (!expired) {
+                    if (!add_hashlock(secret, witness)) {
+                        return false;
+                    }
+                    if (secret.pubkeys.empty()) {
+                        return true;
+                    }
+                    if (!add_threshold(requirement, secret.pubkeys, secret.n_sigs)) {
+                        return false;
+                    }
+                } else if (!add_threshold(requirement, secret.refund, secret.n_sigs_refund)) {
+                    return false;
+                }
+            } else {
+                if (!add_threshold(requirement, secret.signing_pubkeys(), secret.n_sigs)) {
+                    return false;
+                }
+                if (expired && !add_threshold(requirement, secret.refund, secret.n_sigs_refund)) {
+                    return false;
+                }
+            }
+
+            const auto& signatures = witness.signatures;
+            if (!signatures.has_value() || signatures->empty()) {
+                return fail("no signatures in proof.");
+            }
+            requirement.signatures.reserve(signatures->size());
+            for (size_t i = 0; i < signatures->size(); ++i) {
+                const string& signature = (*signatures)[i];
+                for (size_t j = 0; j < i; ++j) {
+                    if ((*signatures)[j] == signature) {
+                        return fail("signatures must be unique.");
+                    }
+                }
+                Signature bytes;
+                if (!crypto::secp_utils::hex_to_bytes(signature, bytes.data(), bytes.size())) {
+                    return fail("invalid signature: " + signature);
+                }
+                signatures_.push_back(bytes);
+                requirement.signatures.push_back(signatures_.size() - 1);
+            }
+            messages_.push_back(message);
+            requirement.digest = messages_.size() - 1;
+            requirements_.push_back(move(requirement));
+            return true;
+        }
+
+        bool run() {
+            // One SHA-256 pass over all messages and preimages
+            vector<Digest> digests(messages_.size());
+            for (size_t i = 0; i < messages_.size(); ++i) {
+                SHA256(reinterpret_cast<const unsigned char*>(messages_[i].data()), messages_[i].size(),
+                       digests[i].data());
+            }
+            for (const auto& lock : hashlocks_) {
+                Digest hash;
+                SHA256(lock.preimage.data(), lock.preimage.size(), hash.data());
+                if (!lock.hash_valid || hash != lock.hash) {
+                    return fail("HTLC preimage does not match.");
+                }
+            }
+
+            // One Schnorr batch over every (pubkey, signature) pair
+            vector<crypto::secp_utils::SchnorrCheck> checks;
+            for (auto& requirement : requirements_) {
+                requirement.first_check = checks.size();
+                for (const auto& threshold : requirement.thresholds) {
+                    for (size_t pubkey : threshold.pubkeys) {
+                        for (size_t signature : requirement.signatures) {
+                            checks.push_back({pubkey, digests[requirement.digest].data(),
+                                              signatures_[signature].data()});
+                        }
+                    }
+                }
+            }
+            vector<uint8_t> results(checks.size());
+            crypto::secp_utils::schnorr_verify_batch(pubkeys_.data(), pubkeys_.size(),
+                                                     checks.data(), checks.size(), results.data());
+
+            // A pubkey counts once if any signature of the input is valid for it
+            for (const auto& requirement : requirements_) {
+                const uint8_t* result = results.data() + requirement.first_check;
+                size_t signatures = requirement.signatures.size();
+                size_t primary_valid = 0;
+                bool satisfied = false;
+                for (const auto& threshold : requirement.thresholds) {
+                    size_t valid = 0;
+                    for (size_t p = 0; p < threshold.pubkeys.size(); ++p, result += signatures) {
+                        for (size_t s = 0; s < signatures; ++s) {
+                            if (result[s]) {
+                                ++valid;
+                                break;
+                            }
+                        }
+                    }
+                    if (&threshold == &requirement.thresholds.front()) {
+                        primary_valid = valid;
+                    }
+                    satisfied = satisfied || valid >= threshold.n_sigs;
+                }
+                if (!satisfied) {
+                    return fail("signature threshold not met. " + std::to_string(primary_valid) +
+                                " < " + std::to_string(requirement.thresholds.front().n_sigs) + ".");
+                }
+            }
+            return true;
+        }
+
+    private:
+        bool fail(string detail) {
+            error_.emplace(CashuErrorCode::TRANSACTION, move(detail));
+            return false;
+        }
+
+        bool add_threshold(Requirement& requirement, const vector<string>& pubkeys, size_t n_sigs) {
+            Threshold threshold;
+            threshold.n_sigs = n_sigs;
+            threshold.pubkeys.reserve(pubkeys.size());
+            for (size_t i = 0; i < pubkeys.size(); ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    if (pubkeys[j] == pubkeys[i]) {
+                        return fail("pubkeys must be unique.");
+                    }
+                }
+                size_t index = 0;
+                if (!pubkey_index(pubkeys[i], index)) {
+                    return false;
+                }
+                threshold.pubkeys.push_back(index);
+            }
+            requirement.thresholds.push_back(move(threshold));
+            return true;
+        }
+
+        // Pubkeys shared by many inputs are decoded and parsed once
+        bool pubkey_index(const string& hex, size_t& index) {
+            auto it = pubkey_ids_.find(hex);
+            if (it != pubkey_ids_.end()) {
+                index = it->second;
+                return true;
+            }
+            Pubkey bytes;
+            if (!crypto::secp_utils::hex_to_bytes(hex, bytes.data(), bytes.size())) {
+                return fail("invalid pubkey: " + hex);
+            }
+            pubkeys_.push_back(bytes);
+            pubkey_ids_.emplace(hex, pubkeys_.size() - 1);
+            index = pubkeys_.size() - 1;
+            return true;
+        }
+
+        int64_t now_;
+        vector<string_view> messages_;
+        vector<Hashlock> hashlocks_;
+        vector<Pubkey> pubkeys_;
+        unordered_map<string, size_t> pubkey_ids_;
+        vector<Signature> signatures_;
+        vector<Requirement> requirements_;
+        optional<Error> error_;
+    };
+}
+
+//=============================================================================
+// Spending Conditions
+//=============================================================================
+
+string sig_all_message(const vector<base::Proof>& proofs, const vector<base::BlindedMessage>& outputs) {
+    size_t size = 0;
+    for (const auto& proof : proofs) {
+        size += proof.secret.size();
+    }
+    for (const auto& output : outputs) {
+        size += output.B_.size();
+    }
+    string message;
+    message.reserve(size);
+    for (const auto& proof : proofs) {
+        message += proof.secret;
+    }
+    for (const auto& output : outputs) {
+        message += output.B_;
+    }
+    return message;
+}
+
+Result<void> check_spending_conditions(const vector<base::Proof>& proofs,
+                                       const vector<base::BlindedMessage>& outputs,
+                                       int64_t now) {
+    bool sig_all = false;
+    for (const auto& proof : proofs) {
+        // NUTSHELL COMPATIBILITY: int() / SigFlags() raise on a malformed tag
+        if (const string* error = proof.secret_error()) {
+            return Error(CashuErrorCode::TRANSACTION, *error);
+        }
+        const Secret* secret = proof.nut10_secret();
+        if (secret != nullptr && secret->sigflag == secret::SigFlag::SIG_ALL) {
+            sig_all = true;
+            break;
+        }
+    }
+
+    Batch batch(now);
+    string message;  // SIG_ALL message, referenced by the batch until run()
+    if (sig_all) {
+        // NUTSHELL COMPATIBILITY: all inputs must lock to the same condition
+        const Secret* first = proofs.front().nut10_secret();
+        for (const auto& proof : proofs) {
+            const Secret* secret = proof.nut10_secret();
+            if (secret == nullptr || first == nullptr || !secret->same_condition(*first)) {
+                return Error(CashuErrorCode::TRANSACTION, "not all secrets are equal.");
+            }
+        }
+        // One digest and one signature check for the whole transaction
+        message = sig_all_message(proofs, outputs);
+        if (!batch.add_condition(*first, proofs.front().parsed_witness(), message)) {
+            return batch.error();
+        }
+        bool expired = first->locktime.has_value() && first->locktime.value() < now;
+        if (first->kind == SecretKind::HTLC && !expired) {
+            for (size_t i = 1; i < proofs.size(); ++i) {
+                if (!batch.add_hashlock(*proofs[i].nut10_secret(), proofs[i].parsed_witness())) {
+                    return batch.error();
+                }
+            }
+        }
+    } else {
+        for (const auto& proof : proofs) {
+            const Secret* secret = proof.nut10_secret();
+            if (secret != nullptr && !batch.add_condition(*secret, proof.parsed_witness(), proof.secret)) {
+                return batch.error();
+            }
+        }
+    }
+    if (!batch.run()) {
+        return batch.error();
+    }
+    return {};
+}
+
+Result<void> check_spending_conditions(const vector<base::Proof>& proofs,
+                                       const vector<base::BlindedMessage>& outputs) {
+    int64_t now = chrono::duration_cast<chrono::seconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+    return check_spending_conditions(proofs, outputs, now);
+}
+
+void verify_spending_conditions(const vector<base::Proof>& proofs,
+                                const vector<base::BlindedMessage>& outputs,
+                                int64_t now) {
+    check_spending_conditions(proofs, outputs, now).value();
+}
+
+void verify_spending_conditions(const vector<base::Proof>& proofs,
+                                const vector<base::BlindedMessage>& outputs) {
+    check_spending_conditions(proofs, outputs).value();
+}
+
+} // namespace cashu::core
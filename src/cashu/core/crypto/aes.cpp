@@ -8,6 +8,8 @@
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -19,28 +21,52 @@ namespace cashu::core::crypto {
 //=============================================================================
 
 namespace {
-    vector<uint8_t> sha256(const vector<uint8_t>& data) {
-        vector<uint8_t> hash(32);
-        SHA256(data.data(), data.size(), hash.data());
-        return hash;
+    constexpr size_t KEY_CACHE_CAPACITY = 1024;
+    
+    void free_cipher_ctx(EVP_CIPHER_CTX* ctx) {
+        EVP_CIPHER_CTX_free(ctx);
+    }
+    
+    using CipherCtxPtr = unique_ptr<EVP_CIPHER_CTX, void (*)(EVP_CIPHER_CTX*)>;
+    
+    CipherCtxPtr new_cipher_ctx() {
+        CipherCtxPtr ctx(EVP_CIPHER_CTX_new(), free_cipher_ctx);
+        if (!ctx) {
+            throw runtime_error("Failed to create cipher context");
+        }
+        return ctx;
+    }
+    
+    // One-shot encrypt/decrypt reinitialize this context instead of
+    // allocating a new one per call
+    EVP_CIPHER_CTX* thread_cipher_ctx() {
+        thread_local CipherCtxPtr ctx = new_cipher_ctx();
+        return ctx.get();
+    }
+    
+    uint64_t salt_key(const uint8_t* salt) {
+        uint64_t key;
+        memcpy(&key, salt, sizeof(key));
+        return key;
     }
     
     // Base64 alphabet for URL-safe encoding
     const string base64_urlsafe_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
     
-    string encode_base64_standard(const vector<uint8_t>& data) {
+    string encode_base64_standard(const uint8_t* data, size_t length) {
         string encoded;
+        encoded.reserve((length + 2) / 3 * 4);
         const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
         
-        for (size_t i = 0; i < data.size(); i += 3) {
+        for (size_t i = 0; i < length; i += 3) {
             uint32_t val = (data[i] << 16);
-            if (i + 1 < data.size()) val |= (data[i + 1] << 8);
-            if (i + 2 < data.size()) val |= data[i + 2];
+            if (i + 1 < length) val |= (data[i + 1] << 8);
+            if (i + 2 < length) val |= data[i + 2];
             
             encoded += chars[(val >> 18) & 0x3F];
             encoded += chars[(val >> 12) & 0x3F];
-            encoded += (i + 1 < data.size()) ? chars[(val >> 6) & 0x3F] : '=';
-            encoded += (i + 2 < data.size()) ? chars[val & 0x3F] : '=';
+            encoded += (i + 1 < length) ? chars[(val >> 6) & 0x3F] : '=';
+            encoded += (i + 2 < length) ? chars[val & 0x3F] : '=';
         }
         
         return encoded;
@@ -85,200 +111,261 @@ namespace {
 // AESCipher Implementation
 //=============================================================================
 
+struct AESCipher::KeyCache {
+    mutex mtx;
+    unordered_map<uint64_t, array<uint8_t, 48>> entries;  // salt -> key || IV
+};
+
 AESCipher::AESCipher(const string& key, const string& description) 
-    : key_(key), description_(description) {
+    : key_(key), description_(description), key_cache_(make_shared<KeyCache>()) {
     if (key_.empty()) {
         throw invalid_argument("AES key cannot be empty");
     }
 }
 
-string AESCipher::encrypt(const vector<uint8_t>& message) {
-    // Generate random 8-byte salt
-    vector<uint8_t> salt = generate_random_bytes(8);
-    
-    // Derive key and IV using crypto-js compatible method
-    vector<uint8_t> key_data(key_.begin(), key_.end());
-    vector<uint8_t> key_iv = bytes_to_key(key_data, salt, 48); // 32 bytes key + 16 bytes IV
+string AESCipher::encrypt(const vector<uint8_t>& message) const {
+    // Encrypt straight into the output buffer: "Salted__" + salt + ciphertext
+    vector<uint8_t> output(encrypted_size(message.size()));
+    size_t written = encrypt_raw(thread_cipher_ctx(), message.data(), message.size(), output.data());
     
-    vector<uint8_t> aes_key(key_iv.begin(), key_iv.begin() + 32);
-    vector<uint8_t> iv(key_iv.begin() + 32, key_iv.end());
-    
-    // Apply manual PKCS7 padding (like nutshell does)
-    vector<uint8_t> padded_message = pad(message);
+    // Encode as base64-urlsafe
+    return encode_base64_urlsafe(output.data(), written);
+}
+
+string AESCipher::encrypt(const string& message) const {
+    return encrypt(vector<uint8_t>(message.begin(), message.end()));
+}
+
+string AESCipher::decrypt(const string& encrypted) const {
+    // Decode base64-urlsafe
+    vector<uint8_t> encrypted_data = decode_base64_urlsafe(encrypted);
     
-    // Encrypt with AES-256-CBC (disable automatic padding since we do it manually)
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (!ctx) {
-        throw runtime_error("Failed to create cipher context");
+    // Verify minimum length: "Salted__" (8) + salt (8) + at least 1 block (16) = 32 bytes
+    if (encrypted_data.size() < HEADER_SIZE + BLOCK_SIZE) {
+        throw invalid_argument("Encrypted data too short");
     }
     
-    if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, aes_key.data(), iv.data()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to initialize encryption");
+    // Verify "Salted__" header
+    if (memcmp(encrypted_data.data(), SALT_HEADER, 8) != 0) {
+        throw invalid_argument("Invalid encrypted data format: missing 'Salted__' header");
     }
     
-    // Disable automatic padding since we do it manually
-    if (EVP_CIPHER_CTX_set_padding(ctx, 0) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to disable automatic padding");
+    // Derive key and IV from salt (bytes 8-15)
+    array<uint8_t, 48> key_iv = cached_key_iv(encrypted_data.data() + 8);
+    
+    // Decrypt with AES-256-CBC, PKCS7 padding checked by OpenSSL
+    EVP_CIPHER_CTX* ctx = thread_cipher_ctx();
+    if (EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key_iv.data(), key_iv.data() + 32) != 1 ||
+        EVP_CIPHER_CTX_set_padding(ctx, 1) != 1) {
+        throw runtime_error("Failed to initialize decryption");
     }
     
-    vector<uint8_t> encrypted_data;
-    encrypted_data.resize(padded_message.size() + AES_BLOCK_SIZE);
+    const uint8_t* payload = encrypted_data.data() + HEADER_SIZE;
+    size_t payload_size = encrypted_data.size() - HEADER_SIZE;
     
+    string decrypted(payload_size + BLOCK_SIZE, '\0');
+    uint8_t* out = reinterpret_cast<uint8_t*>(&decrypted[0]);
     int len = 0;
     int total_len = 0;
     
-    if (EVP_EncryptUpdate(ctx, encrypted_data.data(), &len, padded_message.data(), padded_message.size()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to encrypt data");
+    if (EVP_DecryptUpdate(ctx, out, &len, payload, static_cast<int>(payload_size)) != 1) {
+        throw runtime_error("Failed to decrypt data");
     }
     total_len += len;
     
-    if (EVP_EncryptFinal_ex(ctx, encrypted_data.data() + len, &len) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to finalize encryption");
+    if (EVP_DecryptFinal_ex(ctx, out + total_len, &len) != 1) {
+        throw runtime_error("Wrong passphrase or corrupted data");
     }
     total_len += len;
     
-    EVP_CIPHER_CTX_free(ctx);
-    encrypted_data.resize(total_len);
-    
-    // Build final output: "Salted__" + salt + encrypted_data
-    vector<uint8_t> final_output;
-    final_output.reserve(8 + 8 + encrypted_data.size());
-    
-    // Add "Salted__" header
-    final_output.insert(final_output.end(), SALT_HEADER, SALT_HEADER + 8);
-    
-    // Add salt
-    final_output.insert(final_output.end(), salt.begin(), salt.end());
-    
-    // Add encrypted data
-    final_output.insert(final_output.end(), encrypted_data.begin(), encrypted_data.end());
-    
-    // Encode as base64-urlsafe
-    return encode_base64_urlsafe(final_output);
+    decrypted.resize(total_len);
+    return decrypted;
 }
 
-string AESCipher::encrypt(const string& message) {
-    vector<uint8_t> message_bytes(message.begin(), message.end());
-    return encrypt(message_bytes);
+AESCipher::EncryptStream AESCipher::encrypt_stream() const {
+    return EncryptStream(*this);
 }
 
-string AESCipher::decrypt(const string& encrypted) {
-    // Decode base64-urlsafe
-    vector<uint8_t> encrypted_data = decode_base64_urlsafe(encrypted);
-    
-    // Verify minimum length: "Salted__" (8) + salt (8) + at least 1 block (16) = 32 bytes
-    if (encrypted_data.size() < 32) {
-        throw invalid_argument("Encrypted data too short");
+AESCipher::DecryptStream AESCipher::decrypt_stream() const {
+    return DecryptStream(*this);
+}
+
+//=============================================================================
+// Streaming Implementation
+//=============================================================================
+
+AESCipher::EncryptStream::EncryptStream(const AESCipher& cipher)
+    : ctx_(new_cipher_ctx()) {
+    memcpy(header_.data(), SALT_HEADER, 8);
+    if (RAND_bytes(header_.data() + 8, 8) != 1) {
+        throw runtime_error("Failed to generate random bytes");
     }
     
-    // Verify "Salted__" header
-    if (memcmp(encrypted_data.data(), SALT_HEADER, 8) != 0) {
-        throw invalid_argument("Invalid encrypted data format: missing 'Salted__' header");
+    array<uint8_t, 48> key_iv = cipher.derive_key_iv(header_.data() + 8);
+    if (EVP_EncryptInit_ex(ctx_.get(), EVP_aes_256_cbc(), nullptr, key_iv.data(), key_iv.data() + 32) != 1 ||
+        EVP_CIPHER_CTX_set_padding(ctx_.get(), 1) != 1) {
+        throw runtime_error("Failed to initialize encryption");
+    }
+}
+
+size_t AESCipher::EncryptStream::write_header(uint8_t* out) {
+    if (header_written_) {
+        return 0;
+    }
+    memcpy(out, header_.data(), HEADER_SIZE);
+    header_written_ = true;
+    return HEADER_SIZE;
+}
+
+size_t AESCipher::EncryptStream::update(const uint8_t* in, size_t length, uint8_t* out) {
+    if (finished_) {
+        throw runtime_error("Encryption stream already finished");
     }
     
-    // Extract salt (bytes 8-15)
-    vector<uint8_t> salt(encrypted_data.begin() + 8, encrypted_data.begin() + 16);
-    
-    // Extract encrypted payload (bytes 16+)
-    vector<uint8_t> payload(encrypted_data.begin() + 16, encrypted_data.end());
-    
-    // Derive key and IV
-    vector<uint8_t> key_data(key_.begin(), key_.end());
-    vector<uint8_t> key_iv = bytes_to_key(key_data, salt, 48);
-    
-    vector<uint8_t> aes_key(key_iv.begin(), key_iv.begin() + 32);
-    vector<uint8_t> iv(key_iv.begin() + 32, key_iv.end());
-    
-    // Decrypt with AES-256-CBC
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-    if (!ctx) {
-        throw runtime_error("Failed to create cipher context");
+    size_t written = write_header(out);
+    int len = 0;
+    if (EVP_EncryptUpdate(ctx_.get(), out + written, &len, in, static_cast<int>(length)) != 1) {
+        throw runtime_error("Failed to encrypt data");
+    }
+    return written + len;
+}
+
+size_t AESCipher::EncryptStream::finish(uint8_t* out) {
+    if (finished_) {
+        throw runtime_error("Encryption stream already finished");
     }
     
-    if (EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, aes_key.data(), iv.data()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to initialize decryption");
+    size_t written = write_header(out);
+    int len = 0;
+    if (EVP_EncryptFinal_ex(ctx_.get(), out + written, &len) != 1) {
+        throw runtime_error("Failed to finalize encryption");
+    }
+    finished_ = true;
+    return written + len;
+}
+
+AESCipher::DecryptStream::DecryptStream(const AESCipher& cipher)
+    : cipher_(&cipher), ctx_(new_cipher_ctx()) {
+}
+
+size_t AESCipher::DecryptStream::update(const uint8_t* in, size_t length, uint8_t* out) {
+    if (finished_) {
+        throw runtime_error("Decryption stream already finished");
     }
     
-    // Disable automatic padding since we handle it manually
-    if (EVP_CIPHER_CTX_set_padding(ctx, 0) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
-        throw runtime_error("Failed to disable automatic padding");
+    // Collect the header, then derive the key once the salt is known
+    if (header_received_ < HEADER_SIZE) {
+        size_t take = min(length, HEADER_SIZE - header_received_);
+        memcpy(header_.data() + header_received_, in, take);
+        header_received_ += take;
+        in += take;
+        length -= take;
+        
+        if (header_received_ < HEADER_SIZE) {
+            return 0;
+        }
+        if (memcmp(header_.data(), SALT_HEADER, 8) != 0) {
+            throw invalid_argument("Invalid encrypted data format: missing 'Salted__' header");
+        }
+        
+        array<uint8_t, 48> key_iv = cipher_->cached_key_iv(header_.data() + 8);
+        if (EVP_DecryptInit_ex(ctx_.get(), EVP_aes_256_cbc(), nullptr, key_iv.data(), key_iv.data() + 32) != 1 ||
+            EVP_CIPHER_CTX_set_padding(ctx_.get(), 1) != 1) {
+            throw runtime_error("Failed to initialize decryption");
+        }
     }
     
-    vector<uint8_t> decrypted_data;
-    decrypted_data.resize(payload.size() + AES_BLOCK_SIZE);
+    if (length == 0) {
+        return 0;
+    }
     
     int len = 0;
-    int total_len = 0;
-    
-    if (EVP_DecryptUpdate(ctx, decrypted_data.data(), &len, payload.data(), payload.size()) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
+    if (EVP_DecryptUpdate(ctx_.get(), out, &len, in, static_cast<int>(length)) != 1) {
         throw runtime_error("Failed to decrypt data");
     }
-    total_len += len;
+    payload_received_ += length;
+    return len;
+}
+
+size_t AESCipher::DecryptStream::finish(uint8_t* out) {
+    if (finished_) {
+        throw runtime_error("Decryption stream already finished");
+    }
+    if (header_received_ < HEADER_SIZE || payload_received_ < BLOCK_SIZE) {
+        throw invalid_argument("Encrypted data too short");
+    }
     
-    if (EVP_DecryptFinal_ex(ctx, decrypted_data.data() + len, &len) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
+    int len = 0;
+    if (EVP_DecryptFinal_ex(ctx_.get(), out, &len) != 1) {
         throw runtime_error("Wrong passphrase or corrupted data");
     }
-    total_len += len;
-    
-    EVP_CIPHER_CTX_free(ctx);
-    decrypted_data.resize(total_len);
-    
-    // Remove PKCS7 padding
-    vector<uint8_t> unpadded_data = unpad(decrypted_data);
-    
-    // Convert to string
-    return string(unpadded_data.begin(), unpadded_data.end());
+    finished_ = true;
+    return len;
 }
 
 //=============================================================================
 // Private Helper Methods
 //=============================================================================
 
-vector<uint8_t> AESCipher::pad(const vector<uint8_t>& data) {
-    // PKCS7 padding
-    size_t padding_length = BLOCK_SIZE - (data.size() % BLOCK_SIZE);
-    
-    vector<uint8_t> padded = data;
-    padded.resize(data.size() + padding_length);
+array<uint8_t, 48> AESCipher::derive_key_iv(const uint8_t* salt) const {
+    vector<uint8_t> key_data(key_.begin(), key_.end());
+    vector<uint8_t> key_iv = bytes_to_key(key_data, vector<uint8_t>(salt, salt + 8), 48);
     
-    // Fill padding bytes with padding length value
-    for (size_t i = data.size(); i < padded.size(); ++i) {
-        padded[i] = static_cast<uint8_t>(padding_length);
+    array<uint8_t, 48> result;
+    copy(key_iv.begin(), key_iv.end(), result.begin());
+    return result;
+}
+
+array<uint8_t, 48> AESCipher::cached_key_iv(const uint8_t* salt) const {
+    uint64_t cache_key = salt_key(salt);
+    {
+        lock_guard<mutex> lock(key_cache_->mtx);
+        auto it = key_cache_->entries.find(cache_key);
+        if (it != key_cache_->entries.end()) {
+            return it->second;
+        }
     }
     
-    return padded;
+    array<uint8_t, 48> result = derive_key_iv(salt);
+    
+    lock_guard<mutex> lock(key_cache_->mtx);
+    if (key_cache_->entries.size() >= KEY_CACHE_CAPACITY) {
+        key_cache_->entries.clear();  // Bound memory
+    }
+    key_cache_->entries.emplace(cache_key, result);
+    return result;
 }
 
-vector<uint8_t> AESCipher::unpad(const vector<uint8_t>& data) {
-    if (data.empty()) {
-        throw runtime_error("Cannot unpad empty data");
+size_t AESCipher::encrypt_raw(EVP_CIPHER_CTX* ctx, const uint8_t* message, size_t length, uint8_t* out) const {
+    // "Salted__" + random 8-byte salt
+    memcpy(out, SALT_HEADER, 8);
+    if (RAND_bytes(out + 8, 8) != 1) {
+        throw runtime_error("Failed to generate random bytes");
     }
     
-    // Get padding length from last byte
-    uint8_t padding_length = data.back();
+    // Derive key and IV using crypto-js compatible method
+    array<uint8_t, 48> key_iv = derive_key_iv(out + 8);  // 32 bytes key + 16 bytes IV
     
-    // Validate padding length
-    if (padding_length == 0 || padding_length > BLOCK_SIZE || padding_length > data.size()) {
-        throw runtime_error("Invalid padding");
+    // Encrypt with AES-256-CBC; OpenSSL PKCS7 padding matches nutshell's manual padding
+    if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, key_iv.data(), key_iv.data() + 32) != 1 ||
+        EVP_CIPHER_CTX_set_padding(ctx, 1) != 1) {
+        throw runtime_error("Failed to initialize encryption");
     }
     
-    // Verify all padding bytes have correct value
-    for (size_t i = data.size() - padding_length; i < data.size(); ++i) {
-        if (data[i] != padding_length) {
-            throw runtime_error("Invalid padding bytes");
-        }
+    int len = 0;
+    size_t total_len = HEADER_SIZE;
+    
+    if (EVP_EncryptUpdate(ctx, out + total_len, &len, message, static_cast<int>(length)) != 1) {
+        throw runtime_error("Failed to encrypt data");
     }
+    total_len += len;
     
-    // Return data without padding
-    return vector<uint8_t>(data.begin(), data.end() - padding_length);
+    if (EVP_EncryptFinal_ex(ctx, out + total_len, &len) != 1) {
+        throw runtime_error("Failed to finalize encryption");
+    }
+    total_len += len;
+    
+    return total_len;
 }
 
 vector<uint8_t> AESCipher::bytes_to_key(const vector<uint8_t>& password, 
@@ -288,21 +375,21 @@ vector<uint8_t> AESCipher::bytes_to_key(const vector<uint8_t>& password,
         throw invalid_argument("Salt must be exactly 8 bytes");
     }
     
-    // Combine password and salt
-    vector<uint8_t> data = password;
+    // Hash input buffer laid out as: previous key (32) + password + salt
+    vector<uint8_t> data(SHA256_DIGEST_LENGTH);
+    data.insert(data.end(), password.begin(), password.end());
     data.insert(data.end(), salt.begin(), salt.end());
     
-    // First iteration: key = SHA256(password + salt)
-    vector<uint8_t> key = sha256(data);
-    vector<uint8_t> final_key = key;
+    vector<uint8_t> final_key;
+    final_key.reserve(output + SHA256_DIGEST_LENGTH);
     
-    // Continue hashing until we have enough key material
+    // First iteration: key = SHA256(password + salt)
+    // Next iterations: key = SHA256(key + password + salt)
+    size_t offset = SHA256_DIGEST_LENGTH;
     while (final_key.size() < output) {
-        // Next iteration: key = SHA256(key + password + salt)
-        vector<uint8_t> next_input = key;
-        next_input.insert(next_input.end(), data.begin(), data.end());
-        key = sha256(next_input);
-        final_key.insert(final_key.end(), key.begin(), key.end());
+        SHA256(data.data() + offset, data.size() - offset, data.data());
+        final_key.insert(final_key.end(), data.begin(), data.begin() + SHA256_DIGEST_LENGTH);
+        offset = 0;
     }
     
     // Return exactly 'output' bytes
@@ -320,9 +407,9 @@ vector<uint8_t> AESCipher::generate_random_bytes(size_t count) {
     return random_bytes;
 }
 
-string AESCipher::encode_base64_urlsafe(const vector<uint8_t>& data) {
+string AESCipher::encode_base64_urlsafe(const uint8_t* data, size_t length) {
     // First encode as standard base64
-    string base64 = encode_base64_standard(data);
+    string base64 = encode_base64_standard(data, length);
     
     // Convert to URL-safe: replace + with -, / with _
     for (char& c : base64) {
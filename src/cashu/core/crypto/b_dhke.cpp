@@ -64,17 +64,18 @@ PublicKey hash_to_curve(const vector<uint8_t>& message) {
         vector<uint8_t> hash_input = concat_vectors(msg_to_hash, counter_bytes);
         vector<uint8_t> hash_output = sha256(hash_input);
         
-        try {
-            // Try to create point with 0x02 prefix (compressed format)
-            vector<uint8_t> point_data(33);
-            point_data[0] = 0x02;  // Compressed point prefix
-            copy(hash_output.begin(), hash_output.end(), point_data.begin() + 1);
-            
-            return PublicKey(point_data, false);  // Standard compressed format
-        } catch (const exception&) {
-            // Point doesn't lie on curve, try next counter
-            counter++;
+        // Try to create point with 0x02 prefix (compressed format); about
+        // half of the candidates are not on the curve, so check without throwing
+        vector<uint8_t> point_data(33);
+        point_data[0] = 0x02;  // Compressed point prefix
+        copy(hash_output.begin(), hash_output.end(), point_data.begin() + 1);
+        
+        Result<PublicKey> point = PublicKey::parse(point_data);
+        if (point) {
+            return std::move(*point);
         }
+        // Point doesn't lie on curve, try next counter
+        counter++;
     }
     
     throw runtime_error("No valid point found after 2^16 iterations");
@@ -118,6 +119,17 @@ tuple<PublicKey, PrivateKey, PrivateKey> step2_bob(
     return make_tuple(C_, e, s);
 }
 
+Result<tuple<PublicKey, PrivateKey, PrivateKey>> try_step2_bob(
+    const vector<uint8_t>& B_,
+    const PrivateKey& a
+) {
+    Result<PublicKey> point = PublicKey::parse(B_);
+    if (!point) {
+        return Error(CashuErrorCode::GENERIC, "invalid B_: " + string(point.error().detail()));
+    }
+    return step2_bob(*point, a);
+}
+
 PublicKey step3_alice(
     const PublicKey& C_,
     const PrivateKey& r,
@@ -151,6 +163,21 @@ bool verify(
     return valid;
 }
 
+Result<void> try_verify(
+    const PrivateKey& a,
+    const vector<uint8_t>& C,
+    const string& secret_msg
+) {
+    Result<PublicKey> point = PublicKey::parse(C);
+    if (!point) {
+        return Error(CashuErrorCode::INVALID_PROOFS, "invalid C: " + string(point.error().detail()));
+    }
+    if (!verify(a, *point, secret_msg)) {
+        return CashuErrorCode::INVALID_PROOFS;
+    }
+    return {};
+}
+
 //=============================================================================
 // DLEQ Proof Implementation
 //=============================================================================
@@ -284,17 +311,17 @@ PublicKey hash_to_curve_deprecated(const vector<uint8_t>& message) {
     while (true) {
         vector<uint8_t> hash_output = sha256(msg_to_hash);
         
-        try {
-            // Try to create point with 0x02 prefix
-            vector<uint8_t> point_data(33);
-            point_data[0] = 0x02;
-            copy(hash_output.begin(), hash_output.end(), point_data.begin() + 1);
-            
-            return PublicKey(point_data, false);
-        } catch (const exception&) {
-            // Point doesn't lie on curve, hash again
-            msg_to_hash = hash_output;
+        // Try to create point with 0x02 prefix
+        vector<uint8_t> point_data(33);
+        point_data[0] = 0x02;
+        copy(hash_output.begin(), hash_output.end(), point_data.begin() + 1);
+        
+        Result<PublicKey> point = PublicKey::parse(point_data);
+        if (point) {
+            return std::move(*point);
         }
+        // Point doesn't lie on curve, hash again
+        msg_to_hash = hash_output;
     }
 }
 
@@ -1,11 +1,10 @@
 #include "cashu/core/crypto/bip39.hpp"
 #include <openssl/sha.h>
 #include <openssl/rand.h>
-#include <fstream>
-#include <sstream>
+#include <openssl/evp.h>
+#include <cctype>
 #include <stdexcept>
 #include <algorithm>
-#include <filesystem>
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -13,104 +12,142 @@ using namespace boost::multiprecision;
 namespace cashu::core::crypto {
 
 //=============================================================================
-// Private Helper Functions
+// Embedded Wordlist
 //=============================================================================
 
-string BIP39::get_wordlist_path() {
-    // Try compile-time path first (set by CMake)
-    #ifdef BIP39_WORDLIST_PATH
-        return string(BIP39_WORDLIST_PATH) + "/english.txt";
-    #else
-        // Fallback to relative path from build directory
-        return "../resources/bip39/english.txt";
-    #endif
-}
-
-vector<bool> BIP39::calculate_checksum(const vector<uint8_t>& entropy) {
-    // Calculate SHA256 hash of entropy
-    vector<uint8_t> hash(32);
-    SHA256(entropy.data(), entropy.size(), hash.data());
+namespace {
+    constexpr size_t WORDLIST_SIZE = 2048;
     
-    // Calculate number of checksum bits (entropy_length_in_bits / 32)
-    int checksum_bits = (entropy.size() * 8) / 32;
+    constexpr array<string_view, WORDLIST_SIZE> ENGLISH_WORDLIST = {
+#include "bip39_english.inc"
+    };
     
-    // Extract checksum bits from the first byte(s) of hash
-    vector<bool> checksum;
-    for (int i = 0; i < checksum_bits; ++i) {
-        int byte_index = i / 8;
-        int bit_index = 7 - (i % 8); // MSB first
-        bool bit = (hash[byte_index] >> bit_index) & 1;
-        checksum.push_back(bit);
+    // Pack the first 4 letters into 5-bit groups ('a' = 1, missing = 0).
+    // Order of keys matches alphabetical order of the words.
+    constexpr uint32_t prefix_key(string_view word) {
+        uint32_t key = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            uint32_t letter = i < word.size() ? (static_cast<uint32_t>(word[i] - 'a' + 1) & 0x1F) : 0;
+            key = (key << 5) | letter;
+        }
+        return key;
     }
     
-    return checksum;
-}
-
-vector<bool> BIP39::bytes_to_bits(const vector<uint8_t>& bytes) {
-    vector<bool> bits;
-    for (uint8_t byte : bytes) {
-        for (int i = 7; i >= 0; --i) { // MSB first
-            bits.push_back((byte >> i) & 1);
+    constexpr array<uint32_t, WORDLIST_SIZE> build_prefix_index() {
+        array<uint32_t, WORDLIST_SIZE> index{};
+        for (size_t i = 0; i < WORDLIST_SIZE; ++i) {
+            index[i] = prefix_key(ENGLISH_WORDLIST[i]);
         }
+        return index;
     }
-    return bits;
-}
-
-vector<uint8_t> BIP39::bits_to_bytes(const vector<bool>& bits) {
-    if (bits.size() % 8 != 0) {
-        throw invalid_argument("Bit array length must be multiple of 8");
-    }
     
-    vector<uint8_t> bytes;
-    for (size_t i = 0; i < bits.size(); i += 8) {
-        uint8_t byte = 0;
-        for (int j = 0; j < 8; ++j) {
-            if (bits[i + j]) {
-                byte |= (1 << (7 - j)); // MSB first
+    constexpr array<uint32_t, WORDLIST_SIZE> PREFIX_INDEX = build_prefix_index();
+    
+    constexpr bool prefix_index_strictly_sorted() {
+        for (size_t i = 1; i < WORDLIST_SIZE; ++i) {
+            if (PREFIX_INDEX[i - 1] >= PREFIX_INDEX[i]) {
+                return false;
             }
         }
-        bytes.push_back(byte);
-    }
-    return bytes;
-}
-
-int BIP39::find_word_index(const string& word, const vector<string>& wordlist) {
-    auto it = find(wordlist.begin(), wordlist.end(), word);
-    if (it == wordlist.end()) {
-        return -1;
+        return true;
     }
-    return distance(wordlist.begin(), it);
+    
+    static_assert(prefix_index_strictly_sorted(),
+                  "BIP39 wordlist must be sorted with unique 4-letter prefixes");
 }
 
 //=============================================================================
-// Public API Implementation
+// Private Helper Functions
 //=============================================================================
 
-vector<string> BIP39::load_english_wordlist() {
-    string path = get_wordlist_path();
-    ifstream file(path);
+uint8_t BIP39::checksum_byte(const uint8_t* entropy, size_t length) {
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    SHA256(entropy, length, hash);
+    return hash[0];
+}
+
+MnemonicStatus BIP39::decode_mnemonic(string_view mnemonic, uint8_t* entropy,
+                                      size_t& entropy_length, string_view& bad_word) {
+    // Tokenize on whitespace into word indices
+    uint16_t indices[MAX_WORDS];
+    size_t word_count = 0;
+    size_t pos = 0;
+    while (pos < mnemonic.size()) {
+        while (pos < mnemonic.size() && isspace(static_cast<unsigned char>(mnemonic[pos]))) ++pos;
+        size_t start = pos;
+        while (pos < mnemonic.size() && !isspace(static_cast<unsigned char>(mnemonic[pos]))) ++pos;
+        if (pos == start) break;
+        
+        if (word_count == MAX_WORDS) {
+            return MnemonicStatus::INVALID_LENGTH;
+        }
+        string_view word = mnemonic.substr(start, pos - start);
+        int index = find_word_index(word);
+        if (index == -1) {
+            bad_word = word;
+            return MnemonicStatus::UNKNOWN_WORD;
+        }
+        indices[word_count++] = static_cast<uint16_t>(index);
+    }
     
-    if (!file.is_open()) {
-        throw runtime_error("Cannot open BIP39 wordlist file: " + path);
+    // Validate word count
+    if (word_count % 3 != 0 || word_count < 12) {
+        return MnemonicStatus::INVALID_LENGTH;
     }
     
-    vector<string> wordlist;
-    string word;
+    // 11 bits per word, 1 checksum bit per 32 entropy bits
+    size_t length = word_count * 4 / 3;
+    size_t checksum_bits = length / 4;
     
-    while (getline(file, word)) {
-        // Remove any trailing whitespace/newlines
-        word.erase(word.find_last_not_of(" \t\r\n") + 1);
-        if (!word.empty()) {
-            wordlist.push_back(word);
+    // Shift word indices into an accumulator and emit whole entropy bytes.
+    // At most 7 + 11 bits are pending, so 64 bits never overflow.
+    uint64_t acc = 0;
+    unsigned bits = 0;
+    size_t out = 0;
+    for (size_t i = 0; i < word_count; ++i) {
+        acc = (acc << 11) | indices[i];
+        bits += 11;
+        while (bits >= 8 && out < length) {
+            bits -= 8;
+            entropy[out++] = static_cast<uint8_t>(acc >> bits);
         }
     }
     
-    if (wordlist.size() != 2048) {
-        throw runtime_error("Invalid BIP39 wordlist: expected 2048 words, got " + 
-                          to_string(wordlist.size()));
+    // Remaining low bits are the provided checksum
+    uint64_t provided = acc & ((uint64_t(1) << checksum_bits) - 1);
+    uint64_t expected = checksum_byte(entropy, length) >> (8 - checksum_bits);
+    if (provided != expected) {
+        return MnemonicStatus::CHECKSUM_MISMATCH;
+    }
+    
+    entropy_length = length;
+    return MnemonicStatus::VALID;
+}
+
+int BIP39::find_word_index(string_view word) {
+    uint32_t key = prefix_key(word);
+    auto it = lower_bound(PREFIX_INDEX.begin(), PREFIX_INDEX.end(), key);
+    if (it == PREFIX_INDEX.end() || *it != key) {
+        return -1;
     }
     
-    return wordlist;
+    int index = static_cast<int>(distance(PREFIX_INDEX.begin(), it));
+    return ENGLISH_WORDLIST[index] == word ? index : -1;
+}
+
+string_view BIP39::word_at(size_t index) {
+    if (index >= WORDLIST_SIZE) {
+        throw out_of_range("BIP39 word index out of range: " + to_string(index));
+    }
+    return ENGLISH_WORDLIST[index];
+}
+
+//=============================================================================
+// Public API Implementation
+//=============================================================================
+
+vector<string> BIP39::load_english_wordlist() {
+    return vector<string>(ENGLISH_WORDLIST.begin(), ENGLISH_WORDLIST.end());
 }
 
 string BIP39::entropy_to_mnemonic(const vector<uint8_t>& entropy) {
@@ -119,103 +156,88 @@ string BIP39::entropy_to_mnemonic(const vector<uint8_t>& entropy) {
         throw invalid_argument("Entropy must be 16, 20, 24, 28, or 32 bytes");
     }
     
-    // Load wordlist
-    vector<string> wordlist = load_english_wordlist();
+    // Shift entropy bytes then checksum bits into an accumulator and take
+    // 11-bit word indices off the top (MSB first)
+    size_t checksum_bits = entropy.size() / 4;
+    uint16_t indices[MAX_WORDS];
+    size_t word_count = 0;
+    uint64_t acc = 0;
+    unsigned bits = 0;
     
-    // Convert entropy to bits
-    vector<bool> entropy_bits = bytes_to_bits(entropy);
+    auto emit_words = [&]() {
+        while (bits >= 11) {
+            bits -= 11;
+            indices[word_count++] = static_cast<uint16_t>((acc >> bits) & 0x7FF);
+        }
+    };
     
-    // Calculate and append checksum
-    vector<bool> checksum = calculate_checksum(entropy);
-    entropy_bits.insert(entropy_bits.end(), checksum.begin(), checksum.end());
+    for (uint8_t byte : entropy) {
+        acc = (acc << 8) | byte;
+        bits += 8;
+        emit_words();
+    }
+    acc = (acc << checksum_bits) | (checksum_byte(entropy.data(), entropy.size()) >> (8 - checksum_bits));
+    bits += static_cast<unsigned>(checksum_bits);
+    emit_words();
     
-    // Split into 11-bit groups and convert to words
-    vector<string> words;
-    for (size_t i = 0; i < entropy_bits.size(); i += 11) {
-        // Extract 11 bits
-        int word_index = 0;
-        for (int j = 0; j < 11 && (i + j) < entropy_bits.size(); ++j) {
-            if (entropy_bits[i + j]) {
-                word_index |= (1 << (10 - j)); // MSB first
-            }
-        }
-        
-        if (word_index >= 2048) {
-            throw runtime_error("Invalid word index: " + to_string(word_index));
-        }
-        
-        words.push_back(wordlist[word_index]);
+    // Join words with spaces into a single allocation
+    size_t total_length = word_count - 1;
+    for (size_t i = 0; i < word_count; ++i) {
+        total_length += ENGLISH_WORDLIST[indices[i]].size();
     }
     
-    // Join words with spaces
-    ostringstream oss;
-    for (size_t i = 0; i < words.size(); ++i) {
-        if (i > 0) oss << " ";
-        oss << words[i];
+    string mnemonic;
+    mnemonic.reserve(total_length);
+    for (size_t i = 0; i < word_count; ++i) {
+        if (i > 0) mnemonic.push_back(' ');
+        mnemonic.append(ENGLISH_WORDLIST[indices[i]]);
     }
     
-    return oss.str();
+    return mnemonic;
 }
 
 vector<uint8_t> BIP39::mnemonic_to_entropy(const string& mnemonic) {
-    // Load wordlist
-    vector<string> wordlist = load_english_wordlist();
+    uint8_t entropy[MAX_ENTROPY_BYTES];
+    size_t entropy_length = 0;
+    string_view bad_word;
     
-    // Split mnemonic into words
-    istringstream iss(mnemonic);
-    vector<string> words;
-    string word;
-    while (iss >> word) {
-        words.push_back(word);
-    }
-    
-    // Validate word count
-    if (words.size() % 3 != 0 || words.size() < 12 || words.size() > 24) {
-        throw invalid_argument("Invalid mnemonic length: must be 12, 15, 18, 21, or 24 words");
+    switch (decode_mnemonic(mnemonic, entropy, entropy_length, bad_word)) {
+        case MnemonicStatus::VALID:
+            return vector<uint8_t>(entropy, entropy + entropy_length);
+        case MnemonicStatus::INVALID_LENGTH:
+            throw invalid_argument("Invalid mnemonic length: must be 12, 15, 18, 21, or 24 words");
+        case MnemonicStatus::UNKNOWN_WORD:
+            throw invalid_argument("Invalid word in mnemonic: " + string(bad_word));
+        case MnemonicStatus::CHECKSUM_MISMATCH:
+            break;
     }
+    throw invalid_argument("Invalid mnemonic: checksum mismatch");
+}
+
+bool BIP39::validate_mnemonic(const string& mnemonic) {
+    uint8_t entropy[MAX_ENTROPY_BYTES];
+    size_t entropy_length = 0;
+    string_view bad_word;
+    return decode_mnemonic(mnemonic, entropy, entropy_length, bad_word) == MnemonicStatus::VALID;
+}
+
+size_t BIP39::validate_mnemonics(const string_view* mnemonics, size_t count,
+                                 MnemonicStatus* statuses, uint8_t* entropy_out) {
+    size_t valid = 0;
+    uint8_t scratch[MAX_ENTROPY_BYTES];
     
-    // Convert words to bit array
-    vector<bool> bits;
-    for (const string& w : words) {
-        int index = find_word_index(w, wordlist);
-        if (index == -1) {
-            throw invalid_argument("Invalid word in mnemonic: " + w);
-        }
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* entropy = entropy_out ? entropy_out + i * MAX_ENTROPY_BYTES : scratch;
+        size_t entropy_length = 0;
+        string_view bad_word;
         
-        // Convert index to 11 bits (MSB first)
-        for (int i = 10; i >= 0; --i) {
-            bits.push_back((index >> i) & 1);
+        statuses[i] = decode_mnemonic(mnemonics[i], entropy, entropy_length, bad_word);
+        if (statuses[i] == MnemonicStatus::VALID) {
+            ++valid;
         }
     }
     
-    // Calculate entropy and checksum lengths
-    int total_bits = bits.size();
-    int checksum_bits = total_bits / 33; // 1 checksum bit per 32 entropy bits
-    int entropy_bits = total_bits - checksum_bits;
-    
-    // Extract entropy and checksum
-    vector<bool> entropy_bit_array(bits.begin(), bits.begin() + entropy_bits);
-    vector<bool> provided_checksum(bits.begin() + entropy_bits, bits.end());
-    
-    // Convert entropy bits to bytes
-    vector<uint8_t> entropy = bits_to_bytes(entropy_bit_array);
-    
-    // Validate checksum
-    vector<bool> calculated_checksum = calculate_checksum(entropy);
-    if (provided_checksum != calculated_checksum) {
-        throw invalid_argument("Invalid mnemonic: checksum mismatch");
-    }
-    
-    return entropy;
-}
-
-bool BIP39::validate_mnemonic(const string& mnemonic) {
-    try {
-        mnemonic_to_entropy(mnemonic);
-        return true;
-    } catch (const exception&) {
-        return false;
-    }
+    return valid;
 }
 
 string BIP39::generate_mnemonic(int entropy_bits) {
@@ -236,4 +258,17 @@ string BIP39::generate_mnemonic(int entropy_bits) {
     return entropy_to_mnemonic(entropy);
 }
 
+vector<uint8_t> BIP39::mnemonic_to_seed(const string& mnemonic, const string& passphrase) {
+    string salt = "mnemonic" + passphrase;
+    vector<uint8_t> seed(64);
+    
+    if (PKCS5_PBKDF2_HMAC(mnemonic.data(), static_cast<int>(mnemonic.size()),
+                          reinterpret_cast<const unsigned char*>(salt.data()), static_cast<int>(salt.size()),
+                          2048, EVP_sha512(), static_cast<int>(seed.size()), seed.data()) != 1) {
+        throw runtime_error("Failed to derive BIP39 seed");
+    }
+    
+    return seed;
+}
+
 } // namespace cashu::core::crypto
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Dense power-of-two denomination table helpers
+
+#include "cashu/core/crypto/denominations.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace cashu::core::crypto {
+
+bool is_valid_denomination(const cpp_int& amount) {
+    if (amount <= 0 || msb(amount) >= MAX_DENOMINATIONS) {
+        return false;
+    }
+    return is_valid_denomination(static_cast<uint64_t>(amount));
+}
+
+size_t denomination_index(uint64_t amount) {
+    if (!is_valid_denomination(amount)) {
+        throw invalid_argument("Amount must be a power of 2: " + to_string(amount));
+    }
+    return lowest_bit_index(amount);
+}
+
+size_t denomination_index(const cpp_int& amount) {
+    if (!is_valid_denomination(amount)) {
+        throw invalid_argument("Amount must be a power of 2 below 2^64: " + amount.str());
+    }
+    return lowest_bit_index(static_cast<uint64_t>(amount));
+}
+
+} // namespace cashu::core::crypto
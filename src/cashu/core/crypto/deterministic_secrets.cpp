@@ -0,0 +1,272 @@
+// NUT-13 deterministic secret engine implementation
+
+#include "cashu/core/crypto/deterministic_secrets.hpp"
+#include "cashu/core/crypto/b_dhke.hpp"
+#include "cashu/core/crypto/bip39.hpp"
+#include "cashu/core/thread_pool.hpp"
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core::crypto {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    constexpr uint32_t HARDENED = 0x80000000;
+    constexpr uint32_t NUT13_PURPOSE = 129372;
+    constexpr uint32_t NUT13_COIN_TYPE = 0;
+    constexpr size_t MIN_CHUNK_SIZE = 16;
+
+    bool try_hex_decode(const string& hex, vector<uint8_t>& out) {
+        if (hex.empty() || hex.size() % 2 != 0) {
+            return false;
+        }
+        out.resize(hex.size() / 2);
+        return secp_utils::hex_to_bytes(hex, out.data(), out.size());
+    }
+
+    int base64_value(char c) {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        return -1;
+    }
+
+    vector<uint8_t> base64_decode(const string& encoded) {
+        if (encoded.empty() || encoded.size() % 4 != 0) {
+            throw invalid_argument("Invalid base64 length");
+        }
+        vector<uint8_t> out;
+        uint32_t buffer = 0;
+        int bits = 0;
+        size_t padding = 0;
+        for (char c : encoded) {
+            if (c == '=') {
+                ++padding;
+                continue;
+            }
+            int value = base64_value(c);
+            if (value < 0 || padding > 0) {
+                throw invalid_argument("Invalid base64 character");
+            }
+            buffer = (buffer << 6) | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out.push_back(static_cast<uint8_t>((buffer >> bits) & 0xFF));
+            }
+        }
+        if (padding > 2) {
+            throw invalid_argument("Invalid base64 padding");
+        }
+        return out;
+    }
+
+    void check_range(uint32_t from, uint32_t count) {
+        if (from >= HARDENED || count > HARDENED - from) {
+            throw invalid_argument("Derivation counter must be below 2^31");
+        }
+    }
+
+    /**
+     * @brief Run fn(chunk_from, chunk_count) over [0, count) in parallel chunks
+     */
+    template<typename Fn>
+    void for_each_chunk(size_t count, Fn fn) {
+        // Propagates derivation exceptions
+        ThreadPool::global().parallel_for(count, MIN_CHUNK_SIZE, [&fn](size_t begin, size_t end) {
+            fn(begin, end - begin);
+        });
+    }
+}
+
+//=============================================================================
+// DeterministicSecretEngine Implementation
+//=============================================================================
+
+DeterministicSecretEngine::DeterministicSecretEngine(const string& mnemonic, const string& passphrase)
+    : bip32_(make_unique<BIP32Helper>(BIP32Helper::from_seed(BIP39::mnemonic_to_seed(mnemonic, passphrase)))) {
+}
+
+uint32_t DeterministicSecretEngine::keyset_id_to_int(const string& keyset_id) {
+    vector<uint8_t> id_bytes;
+    if (!try_hex_decode(keyset_id, id_bytes)) {
+        id_bytes = base64_decode(keyset_id);
+    }
+
+    // Big-endian bytes reduced with a running remainder; fits in 64 bits
+    uint64_t value = 0;
+    for (uint8_t byte : id_bytes) {
+        value = (value * 256 + byte) % (HARDENED - 1);
+    }
+    return static_cast<uint32_t>(value);
+}
+
+string DeterministicSecretEngine::derivation_path(const string& keyset_id, uint32_t counter) {
+    return "m/" + to_string(NUT13_PURPOSE) + "'/" + to_string(NUT13_COIN_TYPE) + "'/" +
+           to_string(keyset_id_to_int(keyset_id)) + "'/" + to_string(counter) + "'";
+}
+
+BIP32Node DeterministicSecretEngine::keyset_node(uint32_t keyset_id_int) const {
+    {
+        lock_guard<mutex> lock(node_cache_mutex_);
+        auto it = node_cache_.find(keyset_id_int);
+        if (it != node_cache_.end()) {
+            return it->second;
+        }
+    }
+
+    BIP32Node node = bip32_->get_node_from_path(
+        "m/" + to_string(NUT13_PURPOSE) + "'/" + to_string(NUT13_COIN_TYPE) + "'/" + to_string(keyset_id_int) + "'");
+
+    lock_guard<mutex> lock(node_cache_mutex_);
+    return node_cache_.emplace(keyset_id_int, node).first->second;
+}
+
+DeterministicSecret DeterministicSecretEngine::derive_from_node(const BIP32Node& node, uint32_t keyset_id_int, uint32_t counter) {
+    // m/129372'/0'/{keyset_id_int}'/{counter}'
+    BIP32Node counter_node = BIP32Helper::derive_child(node, counter | HARDENED);
+
+    // Both leaves are non-hardened children of the counter node: share its pubkey
+    counter_node.public_key = counter_node.key.pubkey();
+    BIP32Node secret_node = BIP32Helper::derive_child(counter_node, 0);
+    BIP32Node r_node = BIP32Helper::derive_child(counter_node, 1);
+
+    return DeterministicSecret{
+        secp_utils::bytes_to_hex(secret_node.key.serialize()),
+        r_node.key,
+        "m/" + to_string(NUT13_PURPOSE) + "'/" + to_string(NUT13_COIN_TYPE) + "'/" +
+            to_string(keyset_id_int) + "'/" + to_string(counter) + "'",
+        counter
+    };
+}
+
+DeterministicSecret DeterministicSecretEngine::derive(const string& keyset_id, uint32_t counter) const {
+    check_range(counter, 1);
+    uint32_t keyset_id_int = keyset_id_to_int(keyset_id);
+    return derive_from_node(keyset_node(keyset_id_int), keyset_id_int, counter);
+}
+
+vector<DeterministicSecret> DeterministicSecretEngine::derive_range(const string& keyset_id, uint32_t from, uint32_t count) const {
+    check_range(from, count);
+    uint32_t keyset_id_int = keyset_id_to_int(keyset_id);
+    BIP32Node node = keyset_node(keyset_id_int);
+
+    vector<optional<DeterministicSecret>> slots(count);
+    for_each_chunk(count, [&](size_t begin, size_t length) {
+        for (size_t i = begin; i < begin + length; ++i) {
+            slots[i] = derive_from_node(node, keyset_id_int, from + static_cast<uint32_t>(i));
+        }
+    });
+
+    vector<DeterministicSecret> result;
+    result.reserve(count);
+    for (auto& slot : slots) {
+        result.push_back(std::move(*slot));
+    }
+    return result;
+}
+
+vector<BlindedDeterministicSecret> DeterministicSecretEngine::blind_range(const string& keyset_id, uint32_t from, uint32_t count) const {
+    check_range(from, count);
+    uint32_t keyset_id_int = keyset_id_to_int(keyset_id);
+    BIP32Node node = keyset_node(keyset_id_int);
+
+    vector<optional<BlindedDeterministicSecret>> slots(count);
+    for_each_chunk(count, [&](size_t begin, size_t length) {
+        for (size_t i = begin; i < begin + length; ++i) {
+            DeterministicSecret secret = derive_from_node(node, keyset_id_int, from + static_cast<uint32_t>(i));
+            auto [B_, r] = step1_alice(secret.secret, secret.r);
+            slots[i] = BlindedDeterministicSecret{std::move(secret), B_};
+        }
+    });
+
+    vector<BlindedDeterministicSecret> result;
+    result.reserve(count);
+    for (auto& slot : slots) {
+        result.push_back(std::move(*slot));
+    }
+    return result;
+}
+
+RestoreResult DeterministicSecretEngine::restore(const string& keyset_id,
+                                                 const RestoreCheck& check,
+                                                 uint32_t window_size,
+                                                 uint32_t gap_limit,
+                                                 uint32_t parallel_windows) const {
+    if (window_size == 0 || gap_limit == 0) {
+        throw invalid_argument("Restore window size and gap limit must be positive");
+    }
+    parallel_windows = max<uint32_t>(1, parallel_windows);
+
+    // Derive the keyset node once before fanning out
+    keyset_node(keyset_id_to_int(keyset_id));
+
+    RestoreResult result;
+    deque<future<vector<BlindedDeterministicSecret>>> pending;
+    // Pool tasks capture this; wait for windows still in flight on every exit
+    struct DrainGuard {
+        deque<future<vector<BlindedDeterministicSecret>>>& pending;
+        ~DrainGuard() {
+            for (auto& f : pending) {
+                try {
+                    ThreadPool::global().wait(f);
+                } catch (...) {
+                    // Windows past the gap limit or after an error are discarded
+                }
+            }
+        }
+    } drain{pending};
+    uint32_t next_window_start = 0;
+    uint32_t empty_windows = 0;
+
+    auto schedule_window = [&]() {
+        if (next_window_start >= HARDENED) {
+            return;
+        }
+        uint32_t from = next_window_start;
+        uint32_t count = min(window_size, HARDENED - from);
+        next_window_start = from + count;
+        pending.push_back(ThreadPool::global().submit([this, keyset_id, from, count]() {
+            return blind_range(keyset_id, from, count);
+        }));
+    };
+
+    for (uint32_t i = 0; i < parallel_windows; ++i) {
+        schedule_window();
+    }
+
+    while (!pending.empty() && empty_windows < gap_limit) {
+        vector<BlindedDeterministicSecret> window = ThreadPool::global().wait(pending.front());
+        pending.pop_front();
+        schedule_window();  // Keep parallel_windows in flight while the mint checks this one
+
+        vector<bool> signed_flags = check(window);
+        if (signed_flags.size() != window.size()) {
+            throw runtime_error("Restore check returned " + to_string(signed_flags.size()) +
+                                " flags for " + to_string(window.size()) + " outputs");
+        }
+
+        bool any_signed = false;
+        for (size_t i = 0; i < window.size(); ++i) {
+            if (signed_flags[i]) {
+                any_signed = true;
+                result.next_counter = window[i].secret.counter + 1;
+                result.found.push_back(std::move(window[i]));
+            }
+        }
+        empty_windows = any_signed ? 0 : empty_windows + 1;
+    }
+
+    return result;
+}
+
+} // namespace cashu::core::crypto
@@ -120,13 +120,28 @@ BIP32Helper::BIP32Helper(const string& mnemonic, const string& passphrase) {
     // In nutshell, they don't use PBKDF2, just the raw mnemonic bytes
     (void)passphrase; // Suppress unused parameter warning
     
+    // Store master chain code
+    master_chain_code_ = master_node().chain_code;
+}
+
+BIP32Helper BIP32Helper::from_seed(const vector<uint8_t>& seed) {
+    BIP32Helper helper;
+    helper.seed_ = seed;
+    helper.master_chain_code_ = helper.master_node().chain_code;
+    return helper;
+}
+
+BIP32Node BIP32Helper::master_node() const {
     // Derive master private key and chain code from seed using HMAC-SHA512
     string seed_str = "Bitcoin seed";
     vector<uint8_t> seed_bytes(seed_str.begin(), seed_str.end());
     vector<uint8_t> master_result = hmac_sha512(seed_bytes, seed_);
     
-    // Store master chain code (last 32 bytes of HMAC result)
-    master_chain_code_.assign(master_result.begin() + 32, master_result.end());
+    // Master private key is first 32 bytes, master chain code is last 32 bytes
+    vector<uint8_t> master_key_bytes(master_result.begin(), master_result.begin() + 32);
+    vector<uint8_t> master_chain_code(master_result.begin() + 32, master_result.end());
+    
+    return BIP32Node(PrivateKey(master_key_bytes), master_chain_code);
 }
 
 vector<uint32_t> BIP32Helper::parse_path(const string& path) {
@@ -163,7 +178,8 @@ vector<uint32_t> BIP32Helper::parse_path(const string& path) {
 pair<PrivateKey, vector<uint8_t>> BIP32Helper::derive_child_key_with_chain_code(
     const PrivateKey& parent_key, 
     const vector<uint8_t>& parent_chain_code, 
-    uint32_t index
+    uint32_t index,
+    const PublicKey* parent_pubkey
 ) {
     // BIP32 standard derivation
     vector<uint8_t> parent_bytes = parent_key.serialize();
@@ -179,8 +195,9 @@ pair<PrivateKey, vector<uint8_t>> BIP32Helper::derive_child_key_with_chain_code(
         hmac_input.insert(hmac_input.end(), parent_bytes.begin(), parent_bytes.end());
     } else {
         // Non-hardened derivation: HMAC(chain_code, parent_public_key || index)
-        PublicKey parent_pubkey = parent_key.pubkey();
-        vector<uint8_t> pubkey_bytes = parent_pubkey.serialize(true); // Compressed
+        vector<uint8_t> pubkey_bytes = parent_pubkey
+            ? parent_pubkey->serialize(true)
+            : parent_key.pubkey().serialize(true); // Compressed
         hmac_input.insert(hmac_input.end(), pubkey_bytes.begin(), pubkey_bytes.end());
     }
     
@@ -209,28 +226,26 @@ pair<PrivateKey, vector<uint8_t>> BIP32Helper::derive_child_key_with_chain_code(
 }
 
 PrivateKey BIP32Helper::get_privkey_from_path(const string& path) {
+    return get_node_from_path(path).key;
+}
+
+BIP32Node BIP32Helper::get_node_from_path(const string& path) {
     vector<uint32_t> indices = parse_path(path);
     
-    // Derive master private key from seed using HMAC-SHA512
-    string seed_str = "Bitcoin seed";
-    vector<uint8_t> seed_bytes(seed_str.begin(), seed_str.end());
-    vector<uint8_t> master_result = hmac_sha512(seed_bytes, seed_);
-    
-    // Master private key is first 32 bytes
-    vector<uint8_t> master_key_bytes(master_result.begin(), master_result.begin() + 32);
-    // Master chain code is last 32 bytes
-    vector<uint8_t> current_chain_code(master_result.begin() + 32, master_result.end());
-    
-    PrivateKey current_key(master_key_bytes);
+    BIP32Node current = master_node();
     
     // Derive each level, propagating the chain code
     for (uint32_t index : indices) {
-        auto result = derive_child_key_with_chain_code(current_key, current_chain_code, index);
-        current_key = result.first;
-        current_chain_code = result.second;
+        current = derive_child(current, index);
     }
     
-    return current_key;
+    return current;
+}
+
+BIP32Node BIP32Helper::derive_child(const BIP32Node& parent, uint32_t index) {
+    const PublicKey* parent_pubkey = parent.public_key ? &*parent.public_key : nullptr;
+    auto result = derive_child_key_with_chain_code(parent.key, parent.chain_code, index, parent_pubkey);
+    return BIP32Node(result.first, result.second);
 }
 
 bool BIP32Helper::is_valid_path(const string& path) {
@@ -247,29 +262,31 @@ bool BIP32Helper::is_valid_path(const string& path) {
 // Key Derivation Functions
 //=============================================================================
 
-unordered_map<cpp_int, PrivateKey> derive_keys(
+DenominationTable<PrivateKey> derive_keys(
     const string& mnemonic,
     const string& derivation_path,
     const vector<cpp_int>& amounts
 ) {
     BIP32Helper bip32(mnemonic);
-    unordered_map<cpp_int, PrivateKey> result;
+    DenominationTable<PrivateKey> result;
     
+    // Derive the keyset parent once, then one hardened child per amount:
+    // equivalent to get_privkey_from_path(derivation_path + "/{i}'")
+    BIP32Node parent = bip32.get_node_from_path(derivation_path);
     for (size_t i = 0; i < amounts.size(); ++i) {
-        string full_path = derivation_path + "/" + to_string(i) + "'";
-        PrivateKey key = bip32.get_privkey_from_path(full_path);
-        result[amounts[i]] = key;
+        BIP32Node child = BIP32Helper::derive_child(parent, static_cast<uint32_t>(i) | 0x80000000);
+        result.insert(amounts[i], child.key);
     }
     
     return result;
 }
 
-unordered_map<cpp_int, PrivateKey> derive_keys_deprecated_pre_0_15(
+DenominationTable<PrivateKey> derive_keys_deprecated_pre_0_15(
     const string& seed,
     const vector<cpp_int>& amounts,
     const string& derivation_path
 ) {
-    unordered_map<cpp_int, PrivateKey> result;
+    DenominationTable<PrivateKey> result;
     
     // NUTSHELL COMPATIBILITY: Hash combination is seed + derivation_path + str(i)
     // This matches: hashlib.sha256((seed + derivation_path + str(i)).encode("utf-8")).digest()[:32]
@@ -279,17 +296,17 @@ unordered_map<cpp_int, PrivateKey> derive_keys_deprecated_pre_0_15(
         
         // Take first 32 bytes as private key
         vector<uint8_t> key_bytes(hash.begin(), hash.begin() + 32);
-        result[amounts[i]] = PrivateKey(key_bytes);
+        result.insert(amounts[i], PrivateKey(key_bytes));
     }
     
     return result;
 }
 
-unordered_map<cpp_int, PrivateKey> derive_keys_backwards_compatible_insecure_pre_0_12(
+DenominationTable<PrivateKey> derive_keys_backwards_compatible_insecure_pre_0_12(
     const string& seed,
     const string& derivation_path
 ) {
-    unordered_map<cpp_int, PrivateKey> result;
+    DenominationTable<PrivateKey> result;
     
     // NUTSHELL COMPATIBILITY: Replicate the double-encoding bug exactly
     // This matches: hashlib.sha256((seed + derivation_path + str(i)).encode("utf-8")).hexdigest().encode("utf-8")[:32]
@@ -301,9 +318,9 @@ unordered_map<cpp_int, PrivateKey> derive_keys_backwards_compatible_insecure_pre
     // Fixed amounts for pre-0.12: powers of 2 up to max_order (default 64)
     // nutshell: amounts = [2**i for i in range(settings.max_order)]
     // Assuming max_order = 6 (like default): [1, 2, 4, 8, 16, 32]
-    vector<cpp_int> fixed_amounts = {1, 2, 4, 8, 16, 32};
+    const uint64_t fixed_amounts[] = {1, 2, 4, 8, 16, 32};
     
-    for (size_t i = 0; i < fixed_amounts.size(); ++i) {
+    for (size_t i = 0; i < size(fixed_amounts); ++i) {
         string combined = seed + derivation_path + to_string(i);
         
         // Step 1: SHA256 hash to get bytes
@@ -324,7 +341,7 @@ unordered_map<cpp_int, PrivateKey> derive_keys_backwards_compatible_insecure_pre
             key_bytes.resize(32, 0);
         }
         
-        result[fixed_amounts[i]] = PrivateKey(key_bytes);
+        result.insert(fixed_amounts[i], PrivateKey(key_bytes));
     }
     
     return result;
@@ -337,30 +354,26 @@ PublicKey derive_pubkey(const string& seed) {
     return private_key.pubkey();
 }
 
-unordered_map<cpp_int, PublicKey> derive_pubkeys(
-    const unordered_map<cpp_int, PrivateKey>& keys,
+DenominationTable<PublicKey> derive_pubkeys(
+    const DenominationTable<PrivateKey>& keys,
     const vector<cpp_int>& amounts
 ) {
-    unordered_map<cpp_int, PublicKey> result;
+    DenominationTable<PublicKey> result;
     
-    for (cpp_int amount : amounts) {
-        auto it = keys.find(amount);
-        if (it != keys.end()) {
-            result[amount] = it->second.pubkey();
+    for (const cpp_int& amount : amounts) {
+        if (keys.contains(amount)) {
+            result.insert(amount, keys.at(amount).pubkey());
         }
     }
     
     return result;
 }
 
-string derive_keyset_id(const unordered_map<cpp_int, PublicKey>& keys) {
-    // Sort keys by amount
-    vector<pair<cpp_int, PublicKey>> sorted_keys(keys.begin(), keys.end());
-    sort(sorted_keys.begin(), sorted_keys.end());
-    
-    // Concatenate serialized public keys
+string derive_keyset_id(const DenominationTable<PublicKey>& keys) {
+    // Concatenate serialized public keys (table iterates in ascending amount order)
     vector<uint8_t> pubkeys_concat;
-    for (const auto& [amount, pubkey] : sorted_keys) {
+    pubkeys_concat.reserve(keys.size() * 33);
+    for (const auto& [amount, pubkey] : keys) {
         vector<uint8_t> serialized = pubkey.serialize(true); // Compressed
         pubkeys_concat.insert(pubkeys_concat.end(), serialized.begin(), serialized.end());
     }
@@ -373,14 +386,10 @@ string derive_keyset_id(const unordered_map<cpp_int, PublicKey>& keys) {
     return "00" + hex_hash.substr(0, 14);
 }
 
-string derive_keyset_id_deprecated(const unordered_map<cpp_int, PublicKey>& keys) {
-    // Sort keys by amount
-    vector<pair<cpp_int, PublicKey>> sorted_keys(keys.begin(), keys.end());
-    sort(sorted_keys.begin(), sorted_keys.end());
-    
-    // Concatenate hex-encoded public keys
+string derive_keyset_id_deprecated(const DenominationTable<PublicKey>& keys) {
+    // Concatenate hex-encoded public keys (table iterates in ascending amount order)
     string pubkeys_concat;
-    for (const auto& [amount, pubkey] : sorted_keys) {
+    for (const auto& [amount, pubkey] : keys) {
         vector<uint8_t> serialized = pubkey.serialize(true); // Compressed
         pubkeys_concat += bytes_to_hex(serialized);
     }
@@ -432,7 +441,7 @@ VersionTuple parse_version(const string& version_str) {
     return VersionTuple(major, minor, patch);
 }
 
-unordered_map<cpp_int, PrivateKey> derive_keys_version_aware(
+DenominationTable<PrivateKey> derive_keys_version_aware(
     const string& seed_or_mnemonic,
     const string& derivation_path,
     const vector<cpp_int>& amounts,
@@ -456,7 +465,7 @@ unordered_map<cpp_int, PrivateKey> derive_keys_version_aware(
 }
 
 string derive_keyset_id_version_aware(
-    const unordered_map<cpp_int, PublicKey>& keys,
+    const DenominationTable<PublicKey>& keys,
     const string& version
 ) {
     VersionTuple version_tuple = parse_version(version);
@@ -0,0 +1,326 @@
+// Binary keyset cache file implementation
+
+#include "cashu/core/crypto/keyset_cache.hpp"
+#include "cashu/core/crypto/keys.hpp"
+#include "cashu/core/keyset_interner.hpp"
+#include "cashu/core/settings.hpp"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core::crypto {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    const char CACHE_MAGIC[8] = {'C', 'A', 'S', 'H', 'U', 'K', 'S', '\0'};
+    const char MAC_KEY_LABEL[] = "keyset cache mac";
+
+    void hmac_sha256(const void* key, size_t key_len, const uint8_t* data, size_t data_len,
+                     uint8_t* out) {
+        unsigned int len = 32;
+        HMAC(EVP_sha256(), key, static_cast<int>(key_len), data, data_len, out, &len);
+    }
+
+    void put_u16(vector<uint8_t>& out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value & 0xFF));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void put_u32(vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void put_u64(vector<uint8_t>& out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out.push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    uint64_t get_le(const uint8_t* data, size_t bytes) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    bool is_hex_keyset_id(const string& id) {
+        return id.size() == 16 && id.compare(0, 2, "00") == 0;
+    }
+}
+
+//=============================================================================
+// KeysetCache Implementation
+//=============================================================================
+
+KeysetCache::KeysetCache(const string& path, const string& seed)
+    : path_(path), cipher_(seed, "keyset cache") {
+    // Separate key for the MAC, so it never doubles as the AES passphrase
+    hmac_sha256(seed.data(), seed.size(),
+                reinterpret_cast<const uint8_t*>(MAC_KEY_LABEL), sizeof(MAC_KEY_LABEL) - 1,
+                mac_key_);
+}
+
+KeysetCache::~KeysetCache() {
+    close();
+}
+
+void KeysetCache::close() {
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+    offsets_.clear();
+}
+
+bool KeysetCache::load() {
+    close();
+
+    int fd = ::open(path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+    size_ = st.st_size;
+
+    // Validate header
+    if (memcmp(data_, CACHE_MAGIC, 8) != 0 ||
+        get_le(data_ + 8, 4) != FORMAT_VERSION) {
+        close();
+        return false;
+    }
+    uint32_t keyset_count = static_cast<uint32_t>(get_le(data_ + 12, 4));
+
+    // Authenticate all records at once; get() then trusts their contents
+    uint8_t mac[32];
+    hmac_sha256(mac_key_, sizeof(mac_key_), data_ + HEADER_SIZE, size_ - HEADER_SIZE, mac);
+    if (CRYPTO_memcmp(mac, data_ + 16, 32) != 0) {
+        close();
+        return false;
+    }
+
+    if (!index_records(keyset_count)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool KeysetCache::index_records(uint32_t keyset_count) {
+    size_t offset = HEADER_SIZE;
+    for (uint32_t i = 0; i < keyset_count; ++i) {
+        size_t record_start = offset;
+
+        if (offset + 2 > size_) return false;
+        size_t id_length = get_le(data_ + offset, 2);
+        offset += 2;
+
+        if (offset + id_length + 8 + 4 > size_) return false;
+        string id(reinterpret_cast<const char*>(data_ + offset), id_length);
+        offset += id_length;
+
+        uint64_t amount_mask = get_le(data_ + offset, 8);
+        offset += 8;
+
+        size_t ciphertext_len = get_le(data_ + offset, 4);
+        offset += 4 + ciphertext_len;
+
+        offset += popcount(amount_mask) * 33;
+        if (offset > size_) return false;
+
+        offsets_[id] = record_start;
+    }
+    return offset == size_;
+}
+
+bool KeysetCache::contains(const string& keyset_id) const {
+    return offsets_.count(keyset_id) != 0;
+}
+
+optional<CachedKeyset> KeysetCache::get(const string& keyset_id) const {
+    auto it = offsets_.find(keyset_id);
+    if (it == offsets_.end()) {
+        return nullopt;
+    }
+
+    // Record bounds were checked by index_records()
+    const uint8_t* p = data_ + it->second;
+    size_t id_length = get_le(p, 2);
+    p += 2 + id_length;
+    uint64_t amount_mask = get_le(p, 8);
+    p += 8;
+    size_t ciphertext_len = get_le(p, 4);
+    p += 4;
+    string ciphertext(reinterpret_cast<const char*>(p), ciphertext_len);
+    p += ciphertext_len;
+
+    size_t key_count = popcount(amount_mask);
+
+    try {
+        CachedKeyset keyset;
+        keyset.id = keyset_id;
+
+        // Public keys are stored in ascending amount order
+        uint64_t mask = amount_mask;
+        for (size_t i = 0; i < key_count; ++i, mask &= mask - 1) {
+            uint64_t amount = uint64_t(1) << lowest_bit_index(mask);
+            keyset.public_keys.insert(amount, PublicKey(vector<uint8_t>(p, p + 33)));
+            p += 33;
+        }
+
+        // Reject the record unless the public keys hash to the keyset id
+        string derived_id = is_hex_keyset_id(keyset_id)
+            ? derive_keyset_id(keyset.public_keys)
+            : derive_keyset_id_deprecated(keyset.public_keys);
+        if (derived_id != keyset_id) {
+            return nullopt;
+        }
+
+        string scalars = cipher_.decrypt(ciphertext);
+        if (scalars.size() != key_count * 32) {
+            return nullopt;
+        }
+
+        mask = amount_mask;
+        for (size_t i = 0; i < key_count; ++i, mask &= mask - 1) {
+            uint64_t amount = uint64_t(1) << lowest_bit_index(mask);
+            const uint8_t* scalar = reinterpret_cast<const uint8_t*>(scalars.data()) + i * 32;
+            keyset.private_keys.insert(amount, PrivateKey(vector<uint8_t>(scalar, scalar + 32)));
+        }
+
+        return keyset;
+    } catch (const exception&) {
+        // Invalid point or scalar written by a faulty mint
+        return nullopt;
+    }
+}
+
+void KeysetCache::write(const vector<CachedKeyset>& keysets) const {
+    vector<uint8_t> records;
+
+    for (const auto& keyset : keysets) {
+        if (keyset.private_keys.mask() != keyset.public_keys.mask()) {
+            throw invalid_argument("Keyset " + keyset.id + " has mismatched private and public keys");
+        }
+        if (keyset.id.size() > 0xFFFF) {
+            throw invalid_argument("Keyset id too long");
+        }
+
+        vector<uint8_t> scalars;
+        scalars.reserve(keyset.private_keys.size() * 32);
+        for (const auto& [amount, key] : keyset.private_keys) {
+            vector<uint8_t> serialized = key.serialize();
+            scalars.insert(scalars.end(), serialized.begin(), serialized.end());
+        }
+        string ciphertext = cipher_.encrypt(scalars);
+
+        put_u16(records, static_cast<uint16_t>(keyset.id.size()));
+        records.insert(records.end(), keyset.id.begin(), keyset.id.end());
+        put_u64(records, keyset.public_keys.mask());
+        put_u32(records, static_cast<uint32_t>(ciphertext.size()));
+        records.insert(records.end(), ciphertext.begin(), ciphertext.end());
+        for (const auto& [amount, pubkey] : keyset.public_keys) {
+            vector<uint8_t> serialized = pubkey.serialize(true);
+            records.insert(records.end(), serialized.begin(), serialized.end());
+        }
+    }
+
+    vector<uint8_t> header(CACHE_MAGIC, CACHE_MAGIC + 8);
+    put_u32(header, FORMAT_VERSION);
+    put_u32(header, static_cast<uint32_t>(keysets.size()));
+    header.resize(HEADER_SIZE);
+    hmac_sha256(mac_key_, sizeof(mac_key_), records.data(), records.size(), header.data() + 16);
+
+    string tmp_path = path_ + ".tmp";
+    {
+        ofstream file(tmp_path, ios::binary | ios::trunc);
+        if (!file) {
+            throw runtime_error("Cannot open keyset cache file: " + tmp_path);
+        }
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(records.data()), records.size());
+        if (!file) {
+            throw runtime_error("Failed to write keyset cache file: " + tmp_path);
+        }
+    }
+    if (rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        throw runtime_error("Failed to replace keyset cache file: " + path_);
+    }
+}
+
+//=============================================================================
+// Keyset Loading
+//=============================================================================
+
+vector<CachedKeyset> load_keysets(const vector<KeysetSource>& sources, const string& seed) {
+    const auto& cache_path = settings::current_settings().mint_keyset_cache_path;
+    optional<KeysetCache> cache;
+    if (cache_path && !cache_path->empty() && !seed.empty()) {
+        cache.emplace(*cache_path, seed);
+        cache->load();
+    }
+
+    vector<CachedKeyset> keysets;
+    keysets.reserve(sources.size());
+    bool derived = false;
+
+    for (const auto& source : sources) {
+        optional<CachedKeyset> cached = cache ? cache->get(source.id) : nullopt;
+        if (cached) {
+            keysets.push_back(std::move(*cached));
+        } else {
+            CachedKeyset keyset;
+            keyset.private_keys = derive_keys_version_aware(
+                seed, source.derivation_path, source.amounts, source.version);
+            for (const auto& [amount, key] : keyset.private_keys) {
+                keyset.public_keys.insert(amount, key.pubkey());
+            }
+            keyset.id = derive_keyset_id_version_aware(keyset.public_keys, source.version);
+            if (!source.id.empty() && keyset.id != source.id) {
+                throw invalid_argument("Derived keyset id " + keyset.id +
+                                       " does not match keyset " + source.id);
+            }
+            keysets.push_back(std::move(keyset));
+            derived = true;
+        }
+        KeysetInterner::global().intern(keysets.back().id);
+    }
+
+    if (cache && derived) {
+        try {
+            cache->write(keysets);
+        } catch (const runtime_error&) {
+            // The cache only saves derivation time; the keysets are already loaded
+        }
+    }
+    return keysets;
+}
+
+} // namespace cashu::core::crypto
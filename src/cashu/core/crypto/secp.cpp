@@ -2,9 +2,12 @@
 // Complete secp256k1 implementation providing C++ interface compatible with nutshell
 
 #include "cashu/core/crypto/secp.hpp"
+#include "cashu/core/thread_pool.hpp"
 #include <boost/multiprecision/cpp_int.hpp>
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
+#include <secp256k1_extrakeys.h>
+#include <secp256k1_schnorrsig.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 #include <stdexcept>
@@ -72,12 +75,46 @@ namespace secp_utils {
         return result;
     }
     
+    bool hex_to_bytes(string_view hex, uint8_t* out, size_t size) noexcept {
+        auto digit = [](char c) -> int {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        };
+        
+        if (hex.size() != 2 * size) {
+            return false;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            int high = digit(hex[2 * i]);
+            int low = digit(hex[2 * i + 1]);
+            if (high < 0 || low < 0) {
+                return false;
+            }
+            out[i] = static_cast<uint8_t>((high << 4) | low);
+        }
+        return true;
+    }
+    
+    bool is_valid_point(const uint8_t* data, size_t size) {
+        secp256k1_pubkey pubkey;
+        return secp256k1_ec_pubkey_parse(get_secp_context(), &pubkey, data, size) == 1;
+    }
+    
     string bytes_to_hex(const vector<uint8_t>& bytes) {
-        ostringstream oss;
-        for (uint8_t byte : bytes) {
-            oss << setfill('0') << setw(2) << std::hex << static_cast<int>(byte);
+        return bytes_to_hex(bytes.data(), bytes.size());
+    }
+    
+    string bytes_to_hex(const uint8_t* data, size_t size) {
+        static const char* digits = "0123456789abcdef";
+        string hex;
+        hex.reserve(size * 2);
+        for (size_t i = 0; i < size; ++i) {
+            hex.push_back(digits[data[i] >> 4]);
+            hex.push_back(digits[data[i] & 0x0F]);
         }
-        return oss.str();
+        return hex;
     }
     
     bool is_valid_private_key(const cpp_int& value) {
@@ -101,6 +138,39 @@ namespace secp_utils {
         
         return PrivateKey(random_bytes);
     }
+    
+    void schnorr_verify_batch(const array<uint8_t, 33>* pubkeys, size_t pubkey_count,
+                              const SchnorrCheck* checks, size_t count, uint8_t* results) {
+        secp256k1_context* ctx = get_secp_context();
+        
+        // Parse every pubkey once; invalid keys fail all their checks
+        vector<secp256k1_xonly_pubkey> xonly(pubkey_count);
+        vector<uint8_t> valid(pubkey_count, 0);
+        for (size_t i = 0; i < pubkey_count; ++i) {
+            secp256k1_pubkey pubkey;
+            if (secp256k1_ec_pubkey_parse(ctx, &pubkey, pubkeys[i].data(), pubkeys[i].size()) &&
+                secp256k1_xonly_pubkey_from_pubkey(ctx, &xonly[i], nullptr, &pubkey)) {
+                valid[i] = 1;
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (checks[i].pubkey >= pubkey_count) {
+                throw out_of_range("Schnorr check references unknown pubkey");
+            }
+        }
+        
+        auto verify_chunk = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const SchnorrCheck& check = checks[i];
+                results[i] = valid[check.pubkey] &&
+                    secp256k1_schnorrsig_verify(ctx, check.sig64, check.msg32, 32, &xonly[check.pubkey]) == 1;
+            }
+        };
+        
+        // Each chunk writes disjoint results; the context is only read
+        constexpr size_t MIN_CHUNK_SIZE = 16;
+        ThreadPool::global().parallel_for(count, MIN_CHUNK_SIZE, verify_chunk);
+    }
 }
 
 //=============================================================================
@@ -256,6 +326,25 @@ PublicKey::PublicKey(const string& hex_string) {
     init_from_data(data, false);
 }
 
+Result<PublicKey> PublicKey::parse(const vector<uint8_t>& point_data) {
+    bool compressed = point_data.size() == 33 && (point_data[0] == 0x02 || point_data[0] == 0x03);
+    bool uncompressed = point_data.size() == 65 && point_data[0] == 0x04;
+    if (!compressed && !uncompressed) {
+        return Error(CashuErrorCode::GENERIC, "Invalid public key format");
+    }
+    if (!secp_utils::is_valid_point(point_data.data(), point_data.size())) {
+        return Error(CashuErrorCode::GENERIC, "Invalid public key point");
+    }
+    PublicKey key;
+    key.point_data_ = point_data;
+    key.is_compressed_ = compressed;
+    return key;
+}
+
+Result<PublicKey> PublicKey::parse(const string& hex_string) {
+    return parse(secp_utils::hex_to_bytes(hex_string));
+}
+
 void PublicKey::init_from_data(const vector<uint8_t>& data, bool raw) {
     if (raw) {
         // Raw format: 64 bytes of uncompressed point data (x, y coordinates)
@@ -59,8 +59,8 @@ TransactionError::TransactionError(const optional<string>& detail, const optiona
     : CashuError(detail.value_or(DEFAULT_DETAIL), code.value_or(DEFAULT_CODE)) {
 }
 
-TokenAlreadySpentError::TokenAlreadySpentError()
-    : TransactionError(DEFAULT_DETAIL, DEFAULT_CODE) {
+TokenAlreadySpentError::TokenAlreadySpentError(const optional<string>& detail)
+    : TransactionError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 TransactionNotBalancedError::TransactionNotBalancedError(const string& detail)
@@ -71,8 +71,8 @@ SecretTooLongError::SecretTooLongError(const string& detail)
     : TransactionError(detail, DEFAULT_CODE) {
 }
 
-NoSecretInProofsError::NoSecretInProofsError()
-    : TransactionError(DEFAULT_DETAIL, DEFAULT_CODE) {
+NoSecretInProofsError::NoSecretInProofsError(const optional<string>& detail)
+    : TransactionError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 TransactionUnitError::TransactionUnitError(const string& detail)
@@ -136,68 +136,68 @@ LightningError::LightningError(const optional<string>& detail, const optional<in
     : CashuError(detail.value_or(DEFAULT_DETAIL), code.value_or(DEFAULT_CODE)) {
 }
 
-QuoteNotPaidError::QuoteNotPaidError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+QuoteNotPaidError::QuoteNotPaidError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 LightningPaymentFailedError::LightningPaymentFailedError(const optional<string>& detail)
     : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-QuoteSignatureInvalidError::QuoteSignatureInvalidError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+QuoteSignatureInvalidError::QuoteSignatureInvalidError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-QuoteRequiresPubkeyError::QuoteRequiresPubkeyError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+QuoteRequiresPubkeyError::QuoteRequiresPubkeyError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-TokensAlreadyIssuedError::TokensAlreadyIssuedError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+TokensAlreadyIssuedError::TokensAlreadyIssuedError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-MintingDisabledError::MintingDisabledError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+MintingDisabledError::MintingDisabledError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-QuotePendingError::QuotePendingError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+QuotePendingError::QuotePendingError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-InvoiceAlreadyPaidError::InvoiceAlreadyPaidError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+InvoiceAlreadyPaidError::InvoiceAlreadyPaidError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-QuoteExpiredError::QuoteExpiredError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+QuoteExpiredError::QuoteExpiredError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 //=============================================================================
 // Authentication Errors (30000-31999) - NUT-21/NUT-22
 //=============================================================================
 
-ClearAuthRequiredError::ClearAuthRequiredError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+ClearAuthRequiredError::ClearAuthRequiredError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-ClearAuthFailedError::ClearAuthFailedError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+ClearAuthFailedError::ClearAuthFailedError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-BlindAuthRequiredError::BlindAuthRequiredError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+BlindAuthRequiredError::BlindAuthRequiredError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-BlindAuthFailedError::BlindAuthFailedError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+BlindAuthFailedError::BlindAuthFailedError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 BlindAuthAmountExceededError::BlindAuthAmountExceededError(const optional<string>& detail)
     : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
-BlindAuthRateLimitExceededError::BlindAuthRateLimitExceededError()
-    : CashuError(DEFAULT_DETAIL, DEFAULT_CODE) {
+BlindAuthRateLimitExceededError::BlindAuthRateLimitExceededError(const optional<string>& detail)
+    : CashuError(detail.value_or(DEFAULT_DETAIL), DEFAULT_CODE) {
 }
 
 //=============================================================================
@@ -221,13 +221,13 @@ unique_ptr<CashuError> create_error_from_code(int code, const string& detail) {
             case TransactionError::DEFAULT_CODE:
                 return make_unique<TransactionError>(detail.empty() ? nullopt : optional<string>(detail));
             case TokenAlreadySpentError::DEFAULT_CODE:
-                return make_unique<TokenAlreadySpentError>();
+                return make_unique<TokenAlreadySpentError>(detail.empty() ? nullopt : optional<string>(detail));
             case TransactionNotBalancedError::DEFAULT_CODE:
                 return make_unique<TransactionNotBalancedError>(detail.empty() ? "transaction not balanced" : detail);
             case SecretTooLongError::DEFAULT_CODE:
                 return make_unique<SecretTooLongError>(detail.empty() ? SecretTooLongError::DEFAULT_DETAIL : detail);
             case NoSecretInProofsError::DEFAULT_CODE:
-                return make_unique<NoSecretInProofsError>();
+                return make_unique<NoSecretInProofsError>(detail.empty() ? nullopt : optional<string>(detail));
             case TransactionUnitError::DEFAULT_CODE:
                 return make_unique<TransactionUnitError>(detail.empty() ? "transaction unit error" : detail);
             case TransactionAmountExceedsLimitError::DEFAULT_CODE:
@@ -269,23 +269,23 @@ unique_ptr<CashuError> create_error_from_code(int code, const string& detail) {
             case LightningError::DEFAULT_CODE:
                 return make_unique<LightningError>(detail.empty() ? nullopt : optional<string>(detail));
             case QuoteNotPaidError::DEFAULT_CODE:
-                return make_unique<QuoteNotPaidError>();
+                return make_unique<QuoteNotPaidError>(detail.empty() ? nullopt : optional<string>(detail));
             case LightningPaymentFailedError::DEFAULT_CODE:
                 return make_unique<LightningPaymentFailedError>(detail.empty() ? nullopt : optional<string>(detail));
             case QuoteSignatureInvalidError::DEFAULT_CODE:
-                return make_unique<QuoteSignatureInvalidError>();
+                return make_unique<QuoteSignatureInvalidError>(detail.empty() ? nullopt : optional<string>(detail));
             case QuoteRequiresPubkeyError::DEFAULT_CODE:
-                return make_unique<QuoteRequiresPubkeyError>();
+                return make_unique<QuoteRequiresPubkeyError>(detail.empty() ? nullopt : optional<string>(detail));
             case TokensAlreadyIssuedError::DEFAULT_CODE:
-                return make_unique<TokensAlreadyIssuedError>();
+                return make_unique<TokensAlreadyIssuedError>(detail.empty() ? nullopt : optional<string>(detail));
             case MintingDisabledError::DEFAULT_CODE:
-                return make_unique<MintingDisabledError>();
+                return make_unique<MintingDisabledError>(detail.empty() ? nullopt : optional<string>(detail));
             case QuotePendingError::DEFAULT_CODE:
-                return make_unique<QuotePendingError>();
+                return make_unique<QuotePendingError>(detail.empty() ? nullopt : optional<string>(detail));
             case InvoiceAlreadyPaidError::DEFAULT_CODE:
-                return make_unique<InvoiceAlreadyPaidError>();
+                return make_unique<InvoiceAlreadyPaidError>(detail.empty() ? nullopt : optional<string>(detail));
             case QuoteExpiredError::DEFAULT_CODE:
-                return make_unique<QuoteExpiredError>();
+                return make_unique<QuoteExpiredError>(detail.empty() ? nullopt : optional<string>(detail));
             default:
                 return make_unique<LightningError>(detail.empty() ? "unknown lightning error" : detail, code);
         }
@@ -295,17 +295,17 @@ unique_ptr<CashuError> create_error_from_code(int code, const string& detail) {
     if ((code >= 30000 && code < 32000)) {
         switch (code) {
             case ClearAuthRequiredError::DEFAULT_CODE:
-                return make_unique<ClearAuthRequiredError>();
+                return make_unique<ClearAuthRequiredError>(detail.empty() ? nullopt : optional<string>(detail));
             case ClearAuthFailedError::DEFAULT_CODE:
-                return make_unique<ClearAuthFailedError>();
+                return make_unique<ClearAuthFailedError>(detail.empty() ? nullopt : optional<string>(detail));
             case BlindAuthRequiredError::DEFAULT_CODE:
-                return make_unique<BlindAuthRequiredError>();
+                return make_unique<BlindAuthRequiredError>(detail.empty() ? nullopt : optional<string>(detail));
             case BlindAuthFailedError::DEFAULT_CODE:
-                return make_unique<BlindAuthFailedError>();
+                return make_unique<BlindAuthFailedError>(detail.empty() ? nullopt : optional<string>(detail));
             case BlindAuthAmountExceededError::DEFAULT_CODE:
                 return make_unique<BlindAuthAmountExceededError>(detail.empty() ? nullopt : optional<string>(detail));
             case BlindAuthRateLimitExceededError::DEFAULT_CODE:
-                return make_unique<BlindAuthRateLimitExceededError>();
+                return make_unique<BlindAuthRateLimitExceededError>(detail.empty() ? nullopt : optional<string>(detail));
             default:
                 return make_unique<CashuError>(detail.empty() ? "unknown auth error" : detail, code);
         }
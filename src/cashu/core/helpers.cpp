@@ -3,16 +3,15 @@
 // 100% compatible with nutshell NUT-08 Lightning fee reserve and blank outputs
 
 #include "cashu/core/helpers.hpp"
+#include "cashu/core/output_plan.hpp"
 #include <map>
 #include <set>
 #include <algorithm>
 #include <numeric>
 #include <sstream>
-#include <cmath>
 #include <cassert>
 
 using namespace std;
-using namespace boost::multiprecision;
 
 namespace cashu::core::helpers {
 
@@ -26,13 +25,13 @@ string amount_summary(const vector<Proof>& proofs, Unit unit) {
     //                           for amount in {p.amount for p in proofs}]
     
     // Count proofs by amount: {amount: count}
-    map<cpp_int, int> amount_counts;
+    map<amount_t, int> amount_counts;
     for (const auto& proof : proofs) {
         amount_counts[proof.amount]++;
     }
     
     // Create sorted list of (amount, count) pairs
-    vector<pair<cpp_int, int>> amounts_we_have;
+    vector<pair<amount_t, int>> amounts_we_have;
     for (const auto& [amount, count] : amount_counts) {
         amounts_we_have.emplace_back(amount, count);
     }
@@ -61,21 +60,19 @@ string amount_summary(const vector<Proof>& proofs, Unit unit) {
     return result.str();
 }
 
-cpp_int sum_proofs(const vector<Proof>& proofs) {
+amount_t sum_proofs(const vector<Proof>& proofs) {
     // NUTSHELL COMPATIBILITY: Matches nutshell helpers.py exactly
     // Python: return sum([p.amount for p in proofs])
-    return accumulate(proofs.begin(), proofs.end(), cpp_int(0),
-                     [](const cpp_int& sum, const Proof& p) { return sum + p.amount; });
+    return sum_amounts(proofs);
 }
 
-cpp_int sum_promises(const vector<BlindedSignature>& promises) {
+amount_t sum_promises(const vector<BlindedSignature>& promises) {
     // NUTSHELL COMPATIBILITY: Matches nutshell helpers.py exactly
     // Python: return sum([p.amount for p in promises])
-    return accumulate(promises.begin(), promises.end(), cpp_int(0),
-                     [](const cpp_int& sum, const BlindedSignature& p) { return sum + p.amount; });
+    return sum_amounts(promises);
 }
 
-cpp_int fee_reserve(const cpp_int& amount_msat) {
+amount_t fee_reserve(amount_t amount_msat) {
     // NUTSHELL COMPATIBILITY: Matches nutshell helpers.py exactly
     // Python: return max(
     //     int(settings.lightning_reserve_fee_min),
@@ -85,14 +82,11 @@ cpp_int fee_reserve(const cpp_int& amount_msat) {
     // Default values from nutshell settings
     // settings.lightning_reserve_fee_min: int = Field(default=2000)  # 2000 msat = 2 sats minimum
     // settings.lightning_fee_percent: float = Field(default=1.0)    # 1% default fee
-    const cpp_int lightning_reserve_fee_min = 2000; // 2000 msat = 2 sats minimum
-    const double lightning_fee_percent = 1.0;       // 1% default fee
+    const amount_t lightning_reserve_fee_min = 2000; // 2000 msat = 2 sats minimum
+    const uint32_t lightning_fee_basis_points = 100; // 1% default fee
     
-    // Calculate percentage fee: amount_msat * lightning_fee_percent / 100.0
-    cpp_int calculated_fee = amount_msat * cpp_int(static_cast<int>(lightning_fee_percent * 100)) / 10000;
-    
-    // Return maximum of minimum fee or calculated fee
-    return max(lightning_reserve_fee_min, calculated_fee);
+    // Integer percentage (see output_plan.hpp); no floating point, no overflow
+    return lightning_fee_reserve(amount_msat, lightning_reserve_fee_min, lightning_fee_basis_points);
 }
 
 int calculate_number_of_blank_outputs(int fee_reserve_sat) {
@@ -110,14 +104,10 @@ int calculate_number_of_blank_outputs(int fee_reserve_sat) {
     
     assert(fee_reserve_sat >= 0); // "Fee reserve can't be negative."
     
-    if (fee_reserve_sat == 0) {
-        return 0;
-    }
-    
     // NUT-08: Formula ensures any overpaid amount can be represented as sum of powers of 2
     // Example: For 1000 sat reserve → ceil(log2(1000)) = ceil(9.96) = 10 blank outputs
-    // This allows representation of any amount 0-1023 using powers of 2
-    return max(static_cast<int>(ceil(log2(fee_reserve_sat))), 1);
+    // Computed from the bit width of fee_reserve_sat - 1 (see output_plan.hpp)
+    return static_cast<int>(blank_output_count(static_cast<amount_t>(fee_reserve_sat)));
 }
 
 } // namespace cashu::core::helpers
\ No newline at end of file
@@ -0,0 +1,171 @@
+// Append-only JSON writer implementation
+
+#include "cashu/core/json_writer.hpp"
+#include <charconv>
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // Escape sequence for bytes that cannot appear raw inside a JSON string;
+    // nullptr for bytes that are copied as-is (including UTF-8 continuation bytes)
+    const char* escape_for(unsigned char c) {
+        switch (c) {
+            case '"': return "\\\"";
+            case '\\': return "\\\\";
+            case '\b': return "\\b";
+            case '\f': return "\\f";
+            case '\n': return "\\n";
+            case '\r': return "\\r";
+            case '\t': return "\\t";
+            default: return nullptr;
+        }
+    }
+}
+
+//=============================================================================
+// JsonWriter Implementation
+//=============================================================================
+
+void JsonWriter::clear() noexcept {
+    out_.clear();
+    has_member_ = 0;
+    depth_ = 0;
+    after_key_ = false;
+}
+
+void JsonWriter::prefix() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (depth_ == 0) {
+        return;
+    }
+    uint64_t bit = uint64_t(1) << (depth_ - 1);
+    if (has_member_ & bit) {
+        out_.push_back(',');
+    }
+    has_member_ |= bit;
+}
+
+void JsonWriter::push() {
+    if (depth_ == MAX_DEPTH) {
+        throw length_error("JSON nesting exceeds " + to_string(MAX_DEPTH) + " levels");
+    }
+    ++depth_;
+    has_member_ &= ~(uint64_t(1) << (depth_ - 1));
+}
+
+void JsonWriter::pop() {
+    if (depth_ == 0) {
+        throw logic_error("JSON end without matching begin");
+    }
+    --depth_;
+}
+
+JsonWriter& JsonWriter::begin_object() {
+    prefix();
+    push();
+    out_.push_back('{');
+    return *this;
+}
+
+JsonWriter& JsonWriter::end_object() {
+    pop();
+    out_.push_back('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::begin_array() {
+    prefix();
+    push();
+    out_.push_back('[');
+    return *this;
+}
+
+JsonWriter& JsonWriter::end_array() {
+    pop();
+    out_.push_back(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(string_view name) {
+    prefix();
+    append_escaped(out_, name);
+    out_.push_back(':');
+    after_key_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(string_view str) {
+    prefix();
+    append_escaped(out_, str);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(uint64_t number) {
+    prefix();
+    char digits[20];
+    auto result = to_chars(digits, digits + sizeof(digits), number);
+    out_.append(digits, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int64_t number) {
+    prefix();
+    char digits[20];
+    auto result = to_chars(digits, digits + sizeof(digits), number);
+    out_.append(digits, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    prefix();
+    out_.append(flag ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    prefix();
+    out_.append("null");
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(string_view json) {
+    prefix();
+    out_.append(json.data(), json.size());
+    return *this;
+}
+
+void JsonWriter::append_escaped(string& out, string_view str) {
+    static const char* digits = "0123456789abcdef";
+
+    out.push_back('"');
+    // Copy clean runs in one append; hex ids and points never need escaping
+    size_t run_start = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(str.data() + run_start, i - run_start);
+        run_start = i + 1;
+        if (const char* escape = escape_for(c)) {
+            out.append(escape);
+        } else {
+            char unicode[6] = {'\\', 'u', '0', '0', digits[c >> 4], digits[c & 0x0F]};
+            out.append(unicode, sizeof(unicode));
+        }
+    }
+    out.append(str.data() + run_start, str.size() - run_start);
+    out.push_back('"');
+}
+
+} // namespace cashu::core
@@ -0,0 +1,80 @@
+// Keyset ID interner implementation
+
+#include "cashu/core/keyset_interner.hpp"
+#include <mutex>
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core {
+
+KeysetInterner::~KeysetInterner() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(memory_order_relaxed);
+    }
+}
+
+KeysetInterner& KeysetInterner::global() {
+    static KeysetInterner interner;
+    return interner;
+}
+
+KeysetHandle KeysetInterner::intern(string_view id) {
+    if (id.empty()) {
+        throw invalid_argument("Keyset id cannot be empty");
+    }
+
+    // Fast path: already interned
+    {
+        shared_lock<shared_mutex> lock(mutex_);
+        auto it = lookup_.find(id);
+        if (it != lookup_.end()) {
+            return KeysetHandle{it->second};
+        }
+    }
+
+    unique_lock<shared_mutex> lock(mutex_);
+    auto it = lookup_.find(id);
+    if (it != lookup_.end()) {
+        return KeysetHandle{it->second};
+    }
+
+    size_t index = size_.load(memory_order_relaxed);
+    if (index >= CAPACITY) {
+        throw length_error("Keyset interner is full");
+    }
+
+    size_t chunk_index = index / CHUNK_SIZE;
+    string* chunk = chunks_[chunk_index].load(memory_order_relaxed);
+    if (!chunk) {
+        chunk = new string[CHUNK_SIZE];
+        chunks_[chunk_index].store(chunk, memory_order_release);
+    }
+
+    string& stored = chunk[index % CHUNK_SIZE];
+    stored.assign(id.data(), id.size());
+    lookup_.emplace(string_view(stored), static_cast<uint16_t>(index));
+
+    // Publish after the string is fully written so lock-free id() readers see it
+    size_.store(index + 1, memory_order_release);
+    return KeysetHandle{static_cast<uint16_t>(index)};
+}
+
+optional<KeysetHandle> KeysetInterner::find(string_view id) const {
+    shared_lock<shared_mutex> lock(mutex_);
+    auto it = lookup_.find(id);
+    if (it == lookup_.end()) {
+        return nullopt;
+    }
+    return KeysetHandle{it->second};
+}
+
+const string& KeysetInterner::id(KeysetHandle handle) const {
+    if (handle.value >= size_.load(memory_order_acquire)) {
+        throw out_of_range("Unknown keyset handle: " + to_string(handle.value));
+    }
+    const string* chunk = chunks_[handle.value / CHUNK_SIZE].load(memory_order_acquire);
+    return chunk[handle.value % CHUNK_SIZE];
+}
+
+} // namespace cashu::core
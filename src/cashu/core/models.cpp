@@ -4,7 +4,6 @@
 #include <iomanip>
 
 using namespace std;
-using namespace boost::multiprecision;
 
 namespace cashu::core::models {
 
@@ -117,453 +116,206 @@ timestamp_t now() {
 // JSON Serialization Implementations
 //=============================================================================
 
+// All models serialize through their schema::fields() list: optionals are
+// omitted when empty, 64-bit amounts are decimal strings, timestamps are
+// Unix seconds.
+
 // DBVersion
 json DBVersion::to_json() const {
-    return json{
-        {"db", db},
-        {"version", version}
-    };
+    return schema::to_json(*this);
 }
 
 DBVersion DBVersion::from_json(const json& j) {
-    DBVersion dbv;
-    dbv.db = j.at("db").get<string>();
-    dbv.version = j.at("version").get<int>();
-    return dbv;
+    return schema::from_json<DBVersion>(j);
 }
 
 // MintKeyset
 json MintKeyset::to_json() const {
-    json j = {
-        {"id", id},
-        {"valid_from", timestamp_to_unix(valid_from)},
-        {"valid_to", timestamp_to_unix(valid_to)},
-        {"first_seen", timestamp_to_unix(first_seen)},
-        {"active", active},
-        {"unit", unit},
-        {"amounts", amounts},
-        {"balance", balance.str()},
-        {"fees_paid", fees_paid.str()}
-    };
-    
-    if (derivation_path) j["derivation_path"] = *derivation_path;
-    if (seed) j["seed"] = *seed;
-    if (encrypted_seed) j["encrypted_seed"] = *encrypted_seed;
-    if (seed_encryption_method) j["seed_encryption_method"] = *seed_encryption_method;
-    if (version) j["version"] = *version;
-    if (input_fee_ppk) j["input_fee_ppk"] = *input_fee_ppk;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 MintKeyset MintKeyset::from_json(const json& j) {
-    MintKeyset ks;
-    ks.id = j.at("id").get<string>();
-    ks.valid_from = unix_to_timestamp(j.at("valid_from").get<int64_t>());
-    ks.valid_to = unix_to_timestamp(j.at("valid_to").get<int64_t>());
-    ks.first_seen = unix_to_timestamp(j.at("first_seen").get<int64_t>());
-    ks.active = j.at("active").get<bool>();
-    ks.unit = j.at("unit").get<string>();
-    ks.amounts = j.at("amounts").get<string>();
-    ks.balance = cpp_int(j.at("balance").get<string>());
-    ks.fees_paid = cpp_int(j.at("fees_paid").get<string>());
-    
-    if (j.contains("derivation_path") && !j["derivation_path"].is_null())
-        ks.derivation_path = j["derivation_path"].get<string>();
-    if (j.contains("seed") && !j["seed"].is_null())
-        ks.seed = j["seed"].get<string>();
-    if (j.contains("encrypted_seed") && !j["encrypted_seed"].is_null())
-        ks.encrypted_seed = j["encrypted_seed"].get<string>();
-    if (j.contains("seed_encryption_method") && !j["seed_encryption_method"].is_null())
-        ks.seed_encryption_method = j["seed_encryption_method"].get<string>();
-    if (j.contains("version") && !j["version"].is_null())
-        ks.version = j["version"].get<string>();
-    if (j.contains("input_fee_ppk") && !j["input_fee_ppk"].is_null())
-        ks.input_fee_ppk = j["input_fee_ppk"].get<int>();
-    
-    return ks;
+    return schema::from_json<MintKeyset>(j);
 }
 
 // MintPubkey
 json MintPubkey::to_json() const {
-    return json{
-        {"id", id},
-        {"amount", amount.str()},
-        {"pubkey", pubkey}
-    };
+    return schema::to_json(*this);
 }
 
 MintPubkey MintPubkey::from_json(const json& j) {
-    MintPubkey mp;
-    mp.id = j.at("id").get<string>();
-    mp.amount = cpp_int(j.at("amount").get<string>());
-    mp.pubkey = j.at("pubkey").get<string>();
-    return mp;
+    return schema::from_json<MintPubkey>(j);
 }
 
 // Promise
 json Promise::to_json() const {
-    json j = {
-        {"amount", amount.str()},
-        {"b_", b_},
-        {"c_", c_}
-    };
-    
-    if (id) j["id"] = *id;
-    if (dleq_e) j["dleq_e"] = *dleq_e;
-    if (dleq_s) j["dleq_s"] = *dleq_s;
-    if (created) j["created"] = timestamp_to_unix(*created);
-    if (mint_quote) j["mint_quote"] = *mint_quote;
-    if (swap_id) j["swap_id"] = *swap_id;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 Promise Promise::from_json(const json& j) {
-    Promise p;
-    p.amount = cpp_int(j.at("amount").get<string>());
-    p.b_ = j.at("b_").get<string>();
-    p.c_ = j.at("c_").get<string>();
-    
-    if (j.contains("id") && !j["id"].is_null())
-        p.id = j["id"].get<string>();
-    if (j.contains("dleq_e") && !j["dleq_e"].is_null())
-        p.dleq_e = j["dleq_e"].get<string>();
-    if (j.contains("dleq_s") && !j["dleq_s"].is_null())
-        p.dleq_s = j["dleq_s"].get<string>();
-    if (j.contains("created") && !j["created"].is_null())
-        p.created = unix_to_timestamp(j["created"].get<int64_t>());
-    if (j.contains("mint_quote") && !j["mint_quote"].is_null())
-        p.mint_quote = j["mint_quote"].get<string>();
-    if (j.contains("swap_id") && !j["swap_id"].is_null())
-        p.swap_id = j["swap_id"].get<string>();
-    
-    return p;
+    return schema::from_json<Promise>(j);
 }
 
 // ProofUsed
 json ProofUsed::to_json() const {
-    json j = {
-        {"amount", amount.str()},
-        {"c", c},
-        {"secret", secret}
-    };
-    
-    if (id) j["id"] = *id;
-    if (y) j["y"] = *y;
-    if (witness) j["witness"] = *witness;
-    if (created) j["created"] = timestamp_to_unix(*created);
-    if (melt_quote) j["melt_quote"] = *melt_quote;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 ProofUsed ProofUsed::from_json(const json& j) {
-    ProofUsed pu;
-    pu.amount = cpp_int(j.at("amount").get<string>());
-    pu.c = j.at("c").get<string>();
-    pu.secret = j.at("secret").get<string>();
-    
-    if (j.contains("id") && !j["id"].is_null())
-        pu.id = j["id"].get<string>();
-    if (j.contains("y") && !j["y"].is_null())
-        pu.y = j["y"].get<string>();
-    if (j.contains("witness") && !j["witness"].is_null())
-        pu.witness = j["witness"].get<string>();
-    if (j.contains("created") && !j["created"].is_null())
-        pu.created = unix_to_timestamp(j["created"].get<int64_t>());
-    if (j.contains("melt_quote") && !j["melt_quote"].is_null())
-        pu.melt_quote = j["melt_quote"].get<string>();
-    
-    return pu;
+    return schema::from_json<ProofUsed>(j);
 }
 
 // ProofPending
 json ProofPending::to_json() const {
-    json j = {
-        {"amount", amount.str()},
-        {"c", c},
-        {"secret", secret},
-        {"created", timestamp_to_unix(created)}
-    };
-    
-    if (id) j["id"] = *id;
-    if (y) j["y"] = *y;
-    if (witness) j["witness"] = *witness;
-    if (melt_quote) j["melt_quote"] = *melt_quote;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 ProofPending ProofPending::from_json(const json& j) {
-    ProofPending pp;
-    pp.amount = cpp_int(j.at("amount").get<string>());
-    pp.c = j.at("c").get<string>();
-    pp.secret = j.at("secret").get<string>();
-    pp.created = unix_to_timestamp(j.at("created").get<int64_t>());
-    
-    if (j.contains("id") && !j["id"].is_null())
-        pp.id = j["id"].get<string>();
-    if (j.contains("y") && !j["y"].is_null())
-        pp.y = j["y"].get<string>();
-    if (j.contains("witness") && !j["witness"].is_null())
-        pp.witness = j["witness"].get<string>();
-    if (j.contains("melt_quote") && !j["melt_quote"].is_null())
-        pp.melt_quote = j["melt_quote"].get<string>();
-    
-    return pp;
+    return schema::from_json<ProofPending>(j);
 }
 
 // MintQuote
 json MintQuote::to_json() const {
-    json j = {
-        {"quote", quote},
-        {"method", method},
-        {"request", request},
-        {"checking_id", checking_id},
-        {"unit", unit},
-        {"amount", amount.str()},
-        {"paid", paid},
-        {"issued", issued}
-    };
-    
-    if (created_time) j["created_time"] = timestamp_to_unix(*created_time);
-    if (paid_time) j["paid_time"] = timestamp_to_unix(*paid_time);
-    if (state) j["state"] = *state;
-    if (pubkey) j["pubkey"] = *pubkey;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 MintQuote MintQuote::from_json(const json& j) {
-    MintQuote mq;
-    mq.quote = j.at("quote").get<string>();
-    mq.method = j.at("method").get<string>();
-    mq.request = j.at("request").get<string>();
-    mq.checking_id = j.at("checking_id").get<string>();
-    mq.unit = j.at("unit").get<string>();
-    mq.amount = cpp_int(j.at("amount").get<string>());
-    mq.paid = j.at("paid").get<bool>();
-    mq.issued = j.at("issued").get<bool>();
-    
-    if (j.contains("created_time") && !j["created_time"].is_null())
-        mq.created_time = unix_to_timestamp(j["created_time"].get<int64_t>());
-    if (j.contains("paid_time") && !j["paid_time"].is_null())
-        mq.paid_time = unix_to_timestamp(j["paid_time"].get<int64_t>());
-    if (j.contains("state") && !j["state"].is_null())
-        mq.state = j["state"].get<string>();
-    if (j.contains("pubkey") && !j["pubkey"].is_null())
-        mq.pubkey = j["pubkey"].get<string>();
-    
-    return mq;
+    return schema::from_json<MintQuote>(j);
 }
 
 // MeltQuote
 json MeltQuote::to_json() const {
-    json j = {
-        {"quote", quote},
-        {"method", method},
-        {"request", request},
-        {"checking_id", checking_id},
-        {"unit", unit},
-        {"amount", amount.str()},
-        {"paid", paid}
-    };
-    
-    if (fee_reserve) j["fee_reserve"] = fee_reserve->str();
-    if (created_time) j["created_time"] = timestamp_to_unix(*created_time);
-    if (paid_time) j["paid_time"] = timestamp_to_unix(*paid_time);
-    if (fee_paid) j["fee_paid"] = fee_paid->str();
-    if (proof) j["proof"] = *proof;
-    if (state) j["state"] = *state;
-    if (payment_preimage) j["payment_preimage"] = *payment_preimage;
-    if (change) j["change"] = *change;
-    if (expiry) j["expiry"] = timestamp_to_unix(*expiry);
-    if (outputs) j["outputs"] = *outputs;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 MeltQuote MeltQuote::from_json(const json& j) {
-    MeltQuote mq;
-    mq.quote = j.at("quote").get<string>();
-    mq.method = j.at("method").get<string>();
-    mq.request = j.at("request").get<string>();
-    mq.checking_id = j.at("checking_id").get<string>();
-    mq.unit = j.at("unit").get<string>();
-    mq.amount = cpp_int(j.at("amount").get<string>());
-    mq.paid = j.at("paid").get<bool>();
-    
-    if (j.contains("fee_reserve") && !j["fee_reserve"].is_null())
-        mq.fee_reserve = cpp_int(j["fee_reserve"].get<string>());
-    if (j.contains("created_time") && !j["created_time"].is_null())
-        mq.created_time = unix_to_timestamp(j["created_time"].get<int64_t>());
-    if (j.contains("paid_time") && !j["paid_time"].is_null())
-        mq.paid_time = unix_to_timestamp(j["paid_time"].get<int64_t>());
-    if (j.contains("fee_paid") && !j["fee_paid"].is_null())
-        mq.fee_paid = cpp_int(j["fee_paid"].get<string>());
-    if (j.contains("proof") && !j["proof"].is_null())
-        mq.proof = j["proof"].get<string>();
-    if (j.contains("state") && !j["state"].is_null())
-        mq.state = j["state"].get<string>();
-    if (j.contains("payment_preimage") && !j["payment_preimage"].is_null())
-        mq.payment_preimage = j["payment_preimage"].get<string>();
-    if (j.contains("change") && !j["change"].is_null())
-        mq.change = j["change"].get<string>();
-    if (j.contains("expiry") && !j["expiry"].is_null())
-        mq.expiry = unix_to_timestamp(j["expiry"].get<int64_t>());
-    if (j.contains("outputs") && !j["outputs"].is_null())
-        mq.outputs = j["outputs"].get<string>();
-    
-    return mq;
+    return schema::from_json<MeltQuote>(j);
 }
 
 // BalanceLog
 json BalanceLog::to_json() const {
-    return json{
-        {"unit", unit},
-        {"keyset_balance", keyset_balance},
-        {"keyset_fees_paid", keyset_fees_paid},
-        {"backend_balance", backend_balance},
-        {"time", timestamp_to_unix(time)}
-    };
+    return schema::to_json(*this);
 }
 
 BalanceLog BalanceLog::from_json(const json& j) {
-    BalanceLog bl;
-    bl.unit = j.at("unit").get<string>();
-    bl.keyset_balance = j.at("keyset_balance").get<int>();
-    bl.keyset_fees_paid = j.at("keyset_fees_paid").get<int>();
-    bl.backend_balance = j.at("backend_balance").get<int>();
-    bl.time = unix_to_timestamp(j.at("time").get<int64_t>());
-    return bl;
+    return schema::from_json<BalanceLog>(j);
 }
 
 // WalletProof
 json WalletProof::to_json() const {
-    json j = {
-        {"amount", amount.str()},
-        {"C", C},
-        {"secret", secret}
-    };
-    
-    if (id) j["id"] = *id;
-    if (reserved) j["reserved"] = *reserved;
-    if (send_id) j["send_id"] = *send_id;
-    if (time_created) j["time_created"] = timestamp_to_unix(*time_created);
-    if (time_reserved) j["time_reserved"] = timestamp_to_unix(*time_reserved);
-    if (derivation_path) j["derivation_path"] = *derivation_path;
-    if (dleq) j["dleq"] = *dleq;
-    if (mint_id) j["mint_id"] = *mint_id;
-    if (melt_id) j["melt_id"] = *melt_id;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 WalletProof WalletProof::from_json(const json& j) {
-    WalletProof wp;
-    wp.amount = cpp_int(j.at("amount").get<string>());
-    wp.C = j.at("C").get<string>();
-    wp.secret = j.at("secret").get<string>();
-    
-    if (j.contains("id") && !j["id"].is_null())
-        wp.id = j["id"].get<string>();
-    if (j.contains("reserved") && !j["reserved"].is_null())
-        wp.reserved = j["reserved"].get<bool>();
-    if (j.contains("send_id") && !j["send_id"].is_null())
-        wp.send_id = j["send_id"].get<string>();
-    if (j.contains("time_created") && !j["time_created"].is_null())
-        wp.time_created = unix_to_timestamp(j["time_created"].get<int64_t>());
-    if (j.contains("time_reserved") && !j["time_reserved"].is_null())
-        wp.time_reserved = unix_to_timestamp(j["time_reserved"].get<int64_t>());
-    if (j.contains("derivation_path") && !j["derivation_path"].is_null())
-        wp.derivation_path = j["derivation_path"].get<string>();
-    if (j.contains("dleq") && !j["dleq"].is_null())
-        wp.dleq = j["dleq"].get<string>();
-    if (j.contains("mint_id") && !j["mint_id"].is_null())
-        wp.mint_id = j["mint_id"].get<string>();
-    if (j.contains("melt_id") && !j["melt_id"].is_null())
-        wp.melt_id = j["melt_id"].get<string>();
-    
-    return wp;
+    return schema::from_json<WalletProof>(j);
 }
 
-// Balance
-json Balance::to_json() const {
-    return json{
-        {"keyset", keyset},
-        {"balance", balance.str()}
-    };
+// WalletProofUsed
+json WalletProofUsed::to_json() const {
+    return schema::to_json(*this);
 }
 
-Balance Balance::from_json(const json& j) {
-    Balance b;
-    b.keyset = j.at("keyset").get<string>();
-    b.balance = cpp_int(j.at("balance").get<string>());
-    return b;
+WalletProofUsed WalletProofUsed::from_json(const json& j) {
+    return schema::from_json<WalletProofUsed>(j);
 }
 
-// Implement remaining serialization methods for other structs...
-// (Similar patterns for WalletProofUsed, WalletKeyset, Invoice, Seed, etc.)
-// For brevity, I'll implement a few more key ones:
+// WalletKeyset
+json WalletKeyset::to_json() const {
+    return schema::to_json(*this);
+}
+
+WalletKeyset WalletKeyset::from_json(const json& j) {
+    return schema::from_json<WalletKeyset>(j);
+}
 
 // Invoice
 json Invoice::to_json() const {
-    json j = {
-        {"amount", amount},
-        {"bolt11", bolt11},
-        {"paid", paid},
-        {"time_created", timestamp_to_unix(time_created)},
-        {"time_paid", timestamp_to_unix(time_paid)}
-    };
-    
-    if (id) j["id"] = *id;
-    if (payment_hash) j["payment_hash"] = *payment_hash;
-    if (preimage) j["preimage"] = *preimage;
-    if (out) j["out"] = *out;
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 Invoice Invoice::from_json(const json& j) {
-    Invoice inv;
-    inv.amount = j.at("amount").get<int>();
-    inv.bolt11 = j.at("bolt11").get<string>();
-    inv.paid = j.at("paid").get<bool>();
-    inv.time_created = unix_to_timestamp(j.at("time_created").get<int64_t>());
-    inv.time_paid = unix_to_timestamp(j.at("time_paid").get<int64_t>());
-    
-    if (j.contains("id") && !j["id"].is_null())
-        inv.id = j["id"].get<string>();
-    if (j.contains("payment_hash") && !j["payment_hash"].is_null())
-        inv.payment_hash = j["payment_hash"].get<string>();
-    if (j.contains("preimage") && !j["preimage"].is_null())
-        inv.preimage = j["preimage"].get<string>();
-    if (j.contains("out") && !j["out"].is_null())
-        inv.out = j["out"].get<bool>();
-    
-    return inv;
+    return schema::from_json<Invoice>(j);
+}
+
+// Seed
+json Seed::to_json() const {
+    return schema::to_json(*this);
+}
+
+Seed Seed::from_json(const json& j) {
+    return schema::from_json<Seed>(j);
+}
+
+// WalletMintQuote
+json WalletMintQuote::to_json() const {
+    return schema::to_json(*this);
+}
+
+WalletMintQuote WalletMintQuote::from_json(const json& j) {
+    return schema::from_json<WalletMintQuote>(j);
+}
+
+// WalletMeltQuote
+json WalletMeltQuote::to_json() const {
+    return schema::to_json(*this);
+}
+
+WalletMeltQuote WalletMeltQuote::from_json(const json& j) {
+    return schema::from_json<WalletMeltQuote>(j);
+}
+
+// NostrState
+json NostrState::to_json() const {
+    return schema::to_json(*this);
+}
+
+NostrState NostrState::from_json(const json& j) {
+    return schema::from_json<NostrState>(j);
+}
+
+// Mint
+json Mint::to_json() const {
+    return schema::to_json(*this);
+}
+
+Mint Mint::from_json(const json& j) {
+    return schema::from_json<Mint>(j);
 }
 
 // User
 json User::to_json() const {
-    json j = {
-        {"id", id}
-    };
-    
-    if (last_access) j["last_access"] = timestamp_to_unix(*last_access);
-    
-    return j;
+    return schema::to_json(*this);
 }
 
 User User::from_json(const json& j) {
-    User u;
-    u.id = j.at("id").get<string>();
-    
-    if (j.contains("last_access") && !j["last_access"].is_null())
-        u.last_access = unix_to_timestamp(j["last_access"].get<int64_t>());
-    
-    return u;
+    return schema::from_json<User>(j);
+}
+
+// Balance
+json Balance::to_json() const {
+    return schema::to_json(*this);
+}
+
+Balance Balance::from_json(const json& j) {
+    return schema::from_json<Balance>(j);
+}
+
+// BalanceIssued
+json BalanceIssued::to_json() const {
+    return schema::to_json(*this);
+}
+
+BalanceIssued BalanceIssued::from_json(const json& j) {
+    return schema::from_json<BalanceIssued>(j);
+}
+
+// BalanceRedeemed
+json BalanceRedeemed::to_json() const {
+    return schema::to_json(*this);
+}
+
+BalanceRedeemed BalanceRedeemed::from_json(const json& j) {
+    return schema::from_json<BalanceRedeemed>(j);
 }
 
-} // namespace cashu::core::models
\ No newline at end of file
+} // namespace cashu::core::models
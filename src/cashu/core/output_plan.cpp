@@ -0,0 +1,85 @@
+// NUTSHELL COMPATIBILITY: cashu/core/split.py, cashu/core/helpers.py
+// Integer output planning implementation
+
+#include "cashu/core/output_plan.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Amount Planning
+//=============================================================================
+
+vector<amount_t> amount_split(amount_t amount) {
+    vector<amount_t> result(split_count(amount));
+    split_into(amount, result.data());
+    return result;
+}
+
+amount_t lightning_fee_reserve(amount_t amount_msat, amount_t fee_min_msat, uint32_t fee_basis_points) {
+    // floor(amount * bp / 10000) == (amount / 10000) * bp + (amount % 10000) * bp / 10000
+    // The second product is below 10000 * 2^32, so neither term can overflow
+    // unless the result itself does
+    amount_t whole = checked_mul(amount_msat / 10000, fee_basis_points);
+    amount_t rest = (amount_msat % 10000) * fee_basis_points / 10000;
+    amount_t percent_fee = checked_add(whole, rest);
+    return percent_fee > fee_min_msat ? percent_fee : fee_min_msat;
+}
+
+//=============================================================================
+// InputFeeTable Implementation
+//=============================================================================
+
+void InputFeeTable::set(KeysetHandle keyset, uint32_t fee_ppk) {
+    if (!keyset.valid()) {
+        throw invalid_argument("Invalid keyset handle");
+    }
+    if (keyset.value >= fee_ppk_.size()) {
+        fee_ppk_.resize(static_cast<size_t>(keyset.value) + 1, 0);
+    }
+    fee_ppk_[keyset.value] = fee_ppk;
+}
+
+uint64_t InputFeeTable::fee_ppk(const vector<KeysetHandle>& keysets) const noexcept {
+    uint64_t sum = 0;
+    for (KeysetHandle keyset : keysets) {
+        sum += get(keyset);
+    }
+    return sum;
+}
+
+//=============================================================================
+// OutputPlan Implementation
+//=============================================================================
+
+void OutputPlan::plan(const amount_t* amounts, size_t count) {
+    // Size everything with popcount first so the outputs are written in one pass
+    offsets_.resize(count + 1);
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        offsets_[i] = total;
+        total += split_count(amounts[i]);
+    }
+    offsets_[count] = total;
+
+    outputs_.resize(total);
+    amount_t* out = outputs_.data();
+    for (size_t i = 0; i < count; ++i) {
+        out = split_into(amounts[i], out);
+    }
+}
+
+void OutputPlan::plan_blank(const amount_t* fee_reserves, size_t count) {
+    offsets_.resize(count + 1);
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        offsets_[i] = total;
+        total += blank_output_count(fee_reserves[i]);
+    }
+    offsets_[count] = total;
+    outputs_.assign(total, 1);
+}
+
+} // namespace cashu::core
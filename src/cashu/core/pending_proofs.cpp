@@ -0,0 +1,240 @@
+// NUTSHELL COMPATIBILITY: db_write._set_proofs_pending / _unset_proofs_pending
+// Striped pending-proof manager implementation
+
+#include "cashu/core/pending_proofs.hpp"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+
+namespace cashu::core {
+
+using base::Point33;
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    constexpr const char* PROOFS_PENDING_DETAIL = "proofs are pending.";
+
+    constexpr const char* NO_PROOFS_DETAIL = "no proofs provided.";
+
+    Point33 pending_Y(const models::ProofPending& proof) {
+        return proof.y.has_value() ? base::point_from_hex(*proof.y, "y") : base::hash_to_curve_Y(proof.secret);
+    }
+}
+
+//=============================================================================
+// Internal Structures
+//=============================================================================
+
+// Pending Ys of one stripe, with the quote holding each
+struct alignas(64) PendingProofs::Stripe {
+    mutable mutex lock;
+    unordered_map<Point33, string, PointHash> quotes;
+};
+
+// Inputs of the quotes of one stripe
+struct alignas(64) PendingProofs::QuoteStripe {
+    // A claimed quote is reserving until all of its Ys are pending; until
+    // then it holds no inputs for release() and inputs_of()
+    struct Entry {
+        vector<Point33> inputs;
+        bool reserving = true;
+    };
+
+    mutable mutex lock;
+    unordered_map<string, Entry> inputs;
+};
+
+//=============================================================================
+// PendingProofs Implementation
+//=============================================================================
+
+PendingProofs::PendingProofs(size_t stripes) {
+    size_t count = next_power_of_two(max<size_t>(1, stripes));
+    stripes_.reset(new Stripe[count]);
+    stripe_mask_ = count - 1;
+    quote_stripes_.reset(new QuoteStripe[count]);
+    quote_stripe_mask_ = count - 1;
+}
+
+PendingProofs::~PendingProofs() = default;
+
+PendingProofs::Stripe& PendingProofs::stripe(const Point33& Y) const noexcept {
+    // Word 0 already selects the bucket within a stripe
+    return stripes_[hasher_.word(Y, 1) & stripe_mask_];
+}
+
+PendingProofs::QuoteStripe& PendingProofs::quote_stripe(const string& quote) const noexcept {
+    return quote_stripes_[hash<string>()(quote) & quote_stripe_mask_];
+}
+
+Result<void> PendingProofs::try_mark_pending(const string& quote, const Point33* Ys, size_t count) {
+    if (count == 0) {
+        return Error(CashuErrorCode::TRANSACTION, NO_PROOFS_DETAIL);
+    }
+
+    // Claim the quote first; quote and Y stripes are never locked together
+    QuoteStripe& owner = quote_stripe(quote);
+    {
+        lock_guard<mutex> guard(owner.lock);
+        if (!owner.inputs.try_emplace(quote).second) {
+            return CashuErrorCode::QUOTE_PENDING;
+        }
+    }
+
+    // Lock every stripe of the set in ascending order, which cannot deadlock
+    vector<Stripe*> locked;
+    locked.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        locked.push_back(&stripe(Ys[i]));
+    }
+    sort(locked.begin(), locked.end());
+    locked.erase(unique(locked.begin(), locked.end()), locked.end());
+    vector<unique_lock<mutex>> guards;
+    guards.reserve(locked.size());
+    for (Stripe* s : locked) {
+        guards.emplace_back(s->lock);
+    }
+
+    optional<Error> conflict;
+    for (size_t i = 0; i < count; ++i) {
+        auto inserted = stripe(Ys[i]).quotes.emplace(Ys[i], quote);
+        if (inserted.second) {
+            continue;
+        }
+        // Still holding every stripe, so undoing is invisible to other melts
+        bool duplicate = inserted.first->second == quote;
+        for (size_t j = 0; j < i; ++j) {
+            auto& quotes = stripe(Ys[j]).quotes;
+            auto it = quotes.find(Ys[j]);
+            if (it != quotes.end() && it->second == quote) {
+                quotes.erase(it);
+            }
+        }
+        conflict = duplicate ? Error(CashuErrorCode::TRANSACTION_DUPLICATE_INPUTS)
+                             : Error(CashuErrorCode::TRANSACTION, PROOFS_PENDING_DETAIL);
+        break;
+    }
+    guards.clear();
+
+    // Publish the inputs only once every Y is pending (or drop the claim)
+    lock_guard<mutex> guard(owner.lock);
+    if (conflict) {
+        owner.inputs.erase(quote);
+        return *conflict;
+    }
+    QuoteStripe::Entry& entry = owner.inputs.at(quote);
+    entry.inputs.assign(Ys, Ys + count);
+    entry.reserving = false;
+    return {};
+}
+
+Result<void> PendingProofs::try_mark_pending(const string& quote, const base::ProofBatch& proofs) {
+    if (proofs.has_pending_Y()) {
+        throw logic_error("ProofBatch has rows without Y; call compute_pending_Y() first");
+    }
+    return try_mark_pending(quote, proofs.Y().data(), proofs.size());
+}
+
+void PendingProofs::mark_pending(const string& quote, const base::ProofBatch& proofs) {
+    try_mark_pending(quote, proofs).value();
+}
+
+size_t PendingProofs::release(const string& quote) {
+    vector<Point33> inputs;
+    {
+        QuoteStripe& owner = quote_stripe(quote);
+        lock_guard<mutex> guard(owner.lock);
+        auto it = owner.inputs.find(quote);
+        if (it == owner.inputs.end() || it->second.reserving) {
+            return 0;
+        }
+        inputs = move(it->second.inputs);
+        owner.inputs.erase(it);
+    }
+
+    // Releasing needs no all-or-nothing view, so stripes are locked one at a time
+    size_t released = 0;
+    for (const Point33& Y : inputs) {
+        Stripe& s = stripe(Y);
+        lock_guard<mutex> guard(s.lock);
+        auto it = s.quotes.find(Y);
+        if (it != s.quotes.end() && it->second == quote) {
+            s.quotes.erase(it);
+            ++released;
+        }
+    }
+    return released;
+}
+
+bool PendingProofs::is_pending(const Point33& Y) const {
+    Stripe& s = stripe(Y);
+    lock_guard<mutex> guard(s.lock);
+    return s.quotes.count(Y) != 0;
+}
+
+optional<string> PendingProofs::quote_of(const Point33& Y) const {
+    Stripe& s = stripe(Y);
+    lock_guard<mutex> guard(s.lock);
+    auto it = s.quotes.find(Y);
+    if (it == s.quotes.end()) {
+        return nullopt;
+    }
+    return it->second;
+}
+
+vector<Point33> PendingProofs::inputs_of(const string& quote) const {
+    QuoteStripe& owner = quote_stripe(quote);
+    lock_guard<mutex> guard(owner.lock);
+    auto it = owner.inputs.find(quote);
+    if (it == owner.inputs.end() || it->second.reserving) {
+        return {};
+    }
+    return it->second.inputs;
+}
+
+models::ProofSpentState PendingProofs::state(const Point33& Y, const SpentIndex& spent) const {
+    if (spent.contains(Y)) {
+        return models::ProofSpentState::spent;
+    }
+    return is_pending(Y) ? models::ProofSpentState::pending : models::ProofSpentState::unspent;
+}
+
+size_t PendingProofs::load(const vector<models::ProofPending>& proofs) {
+    // Group by quote, keeping the first-seen order of quotes
+    vector<string> order;
+    unordered_map<string, vector<Point33>> groups;
+    for (const auto& proof : proofs) {
+        string quote = proof.melt_quote.value_or("");
+        auto inserted = groups.try_emplace(quote);
+        if (inserted.second) {
+            order.push_back(quote);
+        }
+        inserted.first->second.push_back(pending_Y(proof));
+    }
+
+    size_t restored = 0;
+    for (const string& quote : order) {
+        const vector<Point33>& inputs = groups[quote];
+        try_mark_pending(quote, inputs).value();
+        restored += inputs.size();
+    }
+    return restored;
+}
+
+size_t PendingProofs::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i <= stripe_mask_; ++i) {
+        lock_guard<mutex> guard(stripes_[i].lock);
+        total += stripes_[i].quotes.size();
+    }
+    return total;
+}
+
+} // namespace cashu::core
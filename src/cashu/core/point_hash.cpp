@@ -0,0 +1,23 @@
+// Seeded hashing of binary Y implementation
+
+#include "cashu/core/point_hash.hpp"
+#include <random>
+
+using namespace std;
+
+namespace cashu::core {
+
+size_t next_power_of_two(size_t value) noexcept {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+PointHash::PointHash() {
+    random_device device;
+    seed_ = (uint64_t(device()) << 32) ^ device();
+}
+
+} // namespace cashu::core
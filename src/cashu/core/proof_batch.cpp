@@ -0,0 +1,246 @@
+// Struct-of-arrays proof container implementation
+
+#include "cashu/core/proof_batch.hpp"
+#include "cashu/core/errors.hpp"
+#include "cashu/core/thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+namespace cashu::core::base {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    constexpr size_t MIN_CHUNK_SIZE = 32;
+
+    // Index of a row whose point repeats an earlier one (in sorted order), or nullopt
+    optional<size_t> find_duplicate_point(const vector<Point33>& points) {
+        vector<uint32_t> order(points.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&points](uint32_t a, uint32_t b) {
+            return memcmp(points[a].data(), points[b].data(), 33) < 0;
+        });
+
+        for (size_t k = 1; k < order.size(); ++k) {
+            if (points[order[k - 1]] == points[order[k]]) {
+                return order[k];
+            }
+        }
+        return nullopt;
+    }
+}
+
+//=============================================================================
+// ProofBatch Implementation
+//=============================================================================
+
+ProofBatch ProofBatch::from_proofs(const vector<Proof>& proofs) {
+    ProofBatch batch;
+    size_t secret_bytes = 0;
+    for (const auto& proof : proofs) {
+        secret_bytes += proof.secret.size();
+    }
+    batch.reserve(proofs.size(), secret_bytes);
+
+    for (const auto& proof : proofs) {
+        batch.push_columns(proof);
+        if (proof.has_Y()) {
+            batch.Y_.push_back(proof.Y_bytes());
+        } else {
+            batch.Y_.emplace_back();
+            batch.pending_Y_.push_back(static_cast<uint32_t>(batch.size() - 1));
+        }
+    }
+
+    batch.compute_pending_Y();
+    return batch;
+}
+
+void ProofBatch::compute_pending_Y() {
+    // Hash the pending Ys in parallel chunks writing disjoint rows
+    auto hash_chunk = [this](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            size_t i = pending_Y_[k];
+            Y_[i] = hash_to_curve_Y(this->secret(i));
+        }
+    };
+
+    ThreadPool::global().parallel_for(pending_Y_.size(), MIN_CHUNK_SIZE, hash_chunk);
+    pending_Y_.clear();
+}
+
+vector<Proof> ProofBatch::to_proofs() const {
+    if (has_pending_Y()) {
+        throw logic_error("Proof batch has rows without Y; call compute_pending_Y() first");
+    }
+    vector<Proof> proofs;
+    proofs.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        Proof proof(keysets_[i], amounts_[i], string(secret(i)), point_to_hex(C_[i]));
+        proof.set_Y(Y_[i]);
+        proof.witness = witnesses_[i];
+        proof.dleq = dleqs_[i];
+        proofs.push_back(std::move(proof));
+    }
+    return proofs;
+}
+
+void ProofBatch::reserve(size_t count, size_t secret_bytes) {
+    keysets_.reserve(count);
+    amounts_.reserve(count);
+    C_.reserve(count);
+    Y_.reserve(count);
+    secret_offsets_.reserve(count + 1);
+    secret_arena_.reserve(secret_bytes != 0 ? secret_bytes : count * 64);
+    witnesses_.reserve(count);
+    dleqs_.reserve(count);
+    pending_Y_.reserve(count);
+}
+
+void ProofBatch::clear() noexcept {
+    keysets_.clear();
+    amounts_.clear();
+    C_.clear();
+    Y_.clear();
+    secret_arena_.clear();
+    secret_offsets_.resize(1);
+    witnesses_.clear();
+    dleqs_.clear();
+    pending_Y_.clear();
+}
+
+void ProofBatch::push_back(const Proof& proof) {
+    Point33 Y = proof.Y_bytes();  // Computes Y if not cached
+    push_columns(proof);
+    Y_.push_back(Y);
+}
+
+void ProofBatch::push_columns(const Proof& proof) {
+    // Validate before touching any column so a failed push leaves the batch intact
+    Point33 C = point_from_hex(proof.C, "C");
+    if (secret_arena_.size() + proof.secret.size() > numeric_limits<uint32_t>::max()) {
+        throw length_error("Proof batch secret arena exceeds 4 GiB");
+    }
+    KeysetHandle keyset = proof.keyset_handle();
+    if (!keyset.valid()) {
+        throw KeysetNotFoundError(proof.id());
+    }
+
+    keysets_.push_back(keyset);
+    amounts_.push_back(proof.amount);
+    C_.push_back(C);
+    secret_arena_.append(proof.secret);
+    secret_offsets_.push_back(static_cast<uint32_t>(secret_arena_.size()));
+    witnesses_.push_back(proof.witness);
+    dleqs_.push_back(proof.dleq);
+}
+
+void ProofBatch::push_back_unhashed(KeysetHandle keyset, amount_t amount, string_view secret, const Point33& C,
+                                    optional<string> witness, optional<DLEQWallet> dleq) {
+    if (secret_arena_.size() + secret.size() > numeric_limits<uint32_t>::max()) {
+        throw length_error("Proof batch secret arena exceeds 4 GiB");
+    }
+
+    keysets_.push_back(keyset);
+    amounts_.push_back(amount);
+    C_.push_back(C);
+    Y_.emplace_back();
+    secret_arena_.append(secret.data(), secret.size());
+    secret_offsets_.push_back(static_cast<uint32_t>(secret_arena_.size()));
+    witnesses_.push_back(std::move(witness));
+    dleqs_.push_back(std::move(dleq));
+    pending_Y_.push_back(static_cast<uint32_t>(size() - 1));
+}
+
+amount_t ProofBatch::total_amount() const {
+    return checked_sum(amounts_.data(), amounts_.size());
+}
+
+vector<pair<KeysetHandle, amount_t>> ProofBatch::amounts_by_keyset() const {
+    // Requests carry few keysets: a linear scan over handles beats hashing
+    vector<pair<KeysetHandle, amount_t>> totals;
+    for (size_t i = 0; i < size(); ++i) {
+        auto it = find_if(totals.begin(), totals.end(),
+                          [&](const auto& entry) { return entry.first == keysets_[i]; });
+        if (it == totals.end()) {
+            totals.emplace_back(keysets_[i], amounts_[i]);
+        } else {
+            it->second = checked_add(it->second, amounts_[i]);
+        }
+    }
+    return totals;
+}
+
+optional<size_t> ProofBatch::find_duplicate_Y() const {
+    if (has_pending_Y()) {
+        throw logic_error("Proof batch has rows without Y; call compute_pending_Y() first");
+    }
+    return find_duplicate_point(Y_);
+}
+
+//=============================================================================
+// BlindedMessageBatch Implementation
+//=============================================================================
+
+BlindedMessageBatch BlindedMessageBatch::from_messages(const vector<BlindedMessage>& messages) {
+    BlindedMessageBatch batch;
+    batch.reserve(messages.size());
+    for (const auto& message : messages) {
+        batch.push_back(message);
+    }
+    return batch;
+}
+
+vector<BlindedMessage> BlindedMessageBatch::to_messages() const {
+    vector<BlindedMessage> messages;
+    messages.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        messages.emplace_back(amounts_[i], keysets_[i], point_to_hex(B_points_[i]));
+    }
+    return messages;
+}
+
+void BlindedMessageBatch::reserve(size_t count) {
+    keysets_.reserve(count);
+    amounts_.reserve(count);
+    B_points_.reserve(count);
+}
+
+void BlindedMessageBatch::clear() noexcept {
+    keysets_.clear();
+    amounts_.clear();
+    B_points_.clear();
+}
+
+void BlindedMessageBatch::push_back(const BlindedMessage& message) {
+    // Validate before touching any column so a failed push leaves the batch intact
+    Point33 B_ = point_from_hex(message.B_, "B_");
+    KeysetHandle keyset = message.keyset_handle();
+    if (!keyset.valid()) {
+        throw KeysetNotFoundError(message.id());
+    }
+    push_back(keyset, message.amount, B_);
+}
+
+void BlindedMessageBatch::push_back(KeysetHandle keyset, amount_t amount, const Point33& B_) {
+    keysets_.push_back(keyset);
+    amounts_.push_back(amount);
+    B_points_.push_back(B_);
+}
+
+amount_t BlindedMessageBatch::total_amount() const {
+    return checked_sum(amounts_.data(), amounts_.size());
+}
+
+optional<size_t> BlindedMessageBatch::find_duplicate_B_() const {
+    return find_duplicate_point(B_points_);
+}
+
+} // namespace cashu::core::base
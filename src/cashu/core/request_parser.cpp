@@ -0,0 +1,508 @@
+// Streaming request parser implementation
+
+#include "cashu/core/request_parser.hpp"
+#include "cashu/core/errors.hpp"
+#include <nlohmann/json.hpp>
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace cashu::core {
+
+using base::DLEQWallet;
+using base::Point33;
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // Per-proof allowance for id, amount, C, DLEQ, witness and JSON syntax
+    constexpr size_t PROOF_OVERHEAD_BYTES = 2048;
+    // Per-output allowance for id, amount, B_ and JSON syntax
+    constexpr size_t OUTPUT_BYTES = 256;
+    // Allowance for quote, signature and the enclosing object
+    constexpr size_t ENVELOPE_BYTES = 4096;
+    // Worst-case JSON escaping of one secret byte ("\u00XX")
+    constexpr size_t ESCAPED_BYTE_SIZE = 6;
+
+    size_t non_negative(int value) {
+        return value > 0 ? static_cast<size_t>(value) : 0;
+    }
+
+    enum class Scope : uint8_t {
+        START,
+        ROOT,
+        INPUTS,
+        INPUT,
+        DLEQ,
+        OUTPUTS,
+        OUTPUT,
+        END
+    };
+
+    enum class Field : uint8_t {
+        NONE,
+        UNKNOWN,
+        INPUTS,
+        OUTPUTS,
+        QUOTE,
+        SIGNATURE,
+        ID,
+        AMOUNT,
+        SECRET,
+        C,
+        WITNESS,
+        DLEQ,
+        B_,
+        E,
+        S,
+        R
+    };
+
+    constexpr uint32_t bit(Field field) {
+        return uint32_t(1) << static_cast<uint8_t>(field);
+    }
+
+    constexpr uint32_t INPUT_REQUIRED = bit(Field::ID) | bit(Field::AMOUNT) | bit(Field::SECRET) | bit(Field::C);
+    constexpr uint32_t OUTPUT_REQUIRED = bit(Field::ID) | bit(Field::AMOUNT) | bit(Field::B_);
+    constexpr uint32_t DLEQ_REQUIRED = bit(Field::E) | bit(Field::S) | bit(Field::R);
+
+    /**
+     * @brief SAX handler filling a ParsedRequest row by row
+     *
+     * Every callback either consumes its token or records an error and
+     * returns false, which stops sax_parse immediately without unwinding.
+     */
+    class RequestHandler : public json::json_sax_t {
+    public:
+        RequestHandler(RequestKind kind, const RequestLimits& limits, ParsedRequest& out)
+            : kind_(kind), limits_(limits), out_(out) {}
+
+        Result<void> finish() {
+            if (error_) {
+                return std::move(*error_);
+            }
+            uint32_t required = 0;
+            switch (kind_) {
+                case RequestKind::SWAP: required = bit(Field::INPUTS) | bit(Field::OUTPUTS); break;
+                case RequestKind::MELT: required = bit(Field::QUOTE) | bit(Field::INPUTS); break;
+                case RequestKind::MINT: required = bit(Field::QUOTE) | bit(Field::OUTPUTS); break;
+            }
+            if (scope_ != Scope::END) {
+                return Error(CashuErrorCode::GENERIC, "Request body must be a JSON object");
+            }
+            if (!require(root_seen_, required, "request")) {
+                return std::move(*error_);
+            }
+            return {};
+        }
+
+        bool null() override {
+            if (skip_value()) return true;
+            switch (field_) {
+                case Field::WITNESS: row_.witness.reset(); break;
+                case Field::DLEQ: row_.has_dleq = false; break;
+                case Field::SIGNATURE: out_.signature.reset(); break;
+                case Field::OUTPUTS:
+                    if (kind_ != RequestKind::MELT) return unexpected("null");
+                    break;
+                default: return unexpected("null");
+            }
+            field_ = Field::NONE;
+            return true;
+        }
+
+        bool boolean(bool) override {
+            if (skip_value()) return true;
+            return unexpected("boolean");
+        }
+
+        bool number_integer(number_integer_t) override {
+            // nlohmann reports non-negative integers through number_unsigned
+            if (skip_value()) return true;
+            if (field_ == Field::AMOUNT) {
+                return fail(Error(CashuErrorCode::GENERIC, "amount must not be negative"));
+            }
+            return unexpected("number");
+        }
+
+        bool number_unsigned(number_unsigned_t value) override {
+            if (skip_value()) return true;
+            if (field_ != Field::AMOUNT) return unexpected("number");
+            row_.amount = value;
+            field_ = Field::NONE;
+            return true;
+        }
+
+        bool number_float(number_float_t, const string_t&) override {
+            if (skip_value()) return true;
+            if (field_ == Field::AMOUNT) {
+                return fail(Error(CashuErrorCode::GENERIC, "amount must be an integer"));
+            }
+            return unexpected("number");
+        }
+
+        bool string(string_t& value) override {
+            if (skip_value()) return true;
+            switch (field_) {
+                case Field::QUOTE: out_.quote = std::move(value); break;
+                case Field::SIGNATURE: out_.signature = std::move(value); break;
+                case Field::ID: {
+                    auto handle = KeysetInterner::global().find(value);
+                    if (!handle) {
+                        return fail(Error(CashuErrorCode::KEYSET_NOT_FOUND,
+                                          std::string(KeysetNotFoundError::DEFAULT_DETAIL) + ": " + value));
+                    }
+                    row_.keyset = *handle;
+                    break;
+                }
+                case Field::SECRET:
+                    if (value.size() > limits_.max_secret_length) {
+                        return fail(Error(CashuErrorCode::SECRET_TOO_LONG,
+                                          "secret too long (" + to_string(value.size()) + " > " +
+                                          to_string(limits_.max_secret_length) + ")"));
+                    }
+                    row_.secret.assign(value);
+                    break;
+                case Field::C:
+                    if (!base::try_point_from_hex(value, row_.point)) return bad_point("C");
+                    break;
+                case Field::B_:
+                    if (!base::try_point_from_hex(value, row_.point)) return bad_point("B_");
+                    break;
+                case Field::WITNESS: row_.witness = std::move(value); break;
+                case Field::E: row_.dleq.e.assign(value); break;
+                case Field::S: row_.dleq.s.assign(value); break;
+                case Field::R: row_.dleq.r.assign(value); break;
+                default: return unexpected("string");
+            }
+            field_ = Field::NONE;
+            return true;
+        }
+
+        bool binary(binary_t&) override {
+            return unexpected("binary");
+        }
+
+        bool start_object(size_t) override {
+            if (skip_depth_ > 0) {
+                ++skip_depth_;
+                return true;
+            }
+            switch (scope_) {
+                case Scope::START:
+                    scope_ = Scope::ROOT;
+                    return true;
+                case Scope::INPUTS:
+                    if (out_.inputs.size() >= limits_.max_inputs) {
+                        return fail(Error(CashuErrorCode::TRANSACTION,
+                                          "too many inputs (max " + to_string(limits_.max_inputs) + ")"));
+                    }
+                    row_.reset();
+                    scope_ = Scope::INPUT;
+                    return true;
+                case Scope::OUTPUTS:
+                    if (out_.outputs.size() >= limits_.max_outputs) {
+                        return fail(Error(CashuErrorCode::TRANSACTION,
+                                          "too many outputs (max " + to_string(limits_.max_outputs) + ")"));
+                    }
+                    row_.reset();
+                    scope_ = Scope::OUTPUT;
+                    return true;
+                case Scope::INPUT:
+                    if (field_ == Field::DLEQ) {
+                        dleq_seen_ = 0;
+                        scope_ = Scope::DLEQ;
+                        field_ = Field::NONE;
+                        return true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return begin_skip("object");
+        }
+
+        bool key(string_t& name) override {
+            if (skip_depth_ > 0) return true;
+            uint32_t* seen = nullptr;
+            switch (scope_) {
+                case Scope::ROOT:
+                    field_ = root_field(name);
+                    seen = &root_seen_;
+                    break;
+                case Scope::INPUT:
+                    field_ = input_field(name);
+                    seen = &row_.seen;
+                    break;
+                case Scope::OUTPUT:
+                    field_ = output_field(name);
+                    seen = &row_.seen;
+                    break;
+                case Scope::DLEQ:
+                    field_ = dleq_field(name);
+                    seen = &dleq_seen_;
+                    break;
+                default:
+                    return fail(Error(CashuErrorCode::GENERIC, "Unexpected JSON key outside an object"));
+            }
+            if (field_ != Field::UNKNOWN) {
+                if (*seen & bit(field_)) {
+                    return fail(Error(CashuErrorCode::GENERIC, "Duplicate field: " + name));
+                }
+                *seen |= bit(field_);
+            }
+            return true;
+        }
+
+        bool end_object() override {
+            if (skip_depth_ > 0) {
+                end_skip();
+                return true;
+            }
+            switch (scope_) {
+                case Scope::ROOT:
+                    scope_ = Scope::END;
+                    break;
+                case Scope::INPUT:
+                    if (!require(row_.seen, INPUT_REQUIRED, "proof")) return false;
+                    out_.inputs.push_back_unhashed(
+                        row_.keyset, row_.amount, row_.secret, row_.point, std::move(row_.witness),
+                        row_.has_dleq ? optional<DLEQWallet>(row_.dleq) : nullopt);
+                    scope_ = Scope::INPUTS;
+                    break;
+                case Scope::OUTPUT:
+                    if (!require(row_.seen, OUTPUT_REQUIRED, "output")) return false;
+                    out_.outputs.push_back(row_.keyset, row_.amount, row_.point);
+                    scope_ = Scope::OUTPUTS;
+                    break;
+                case Scope::DLEQ:
+                    if (!require(dleq_seen_, DLEQ_REQUIRED, "dleq")) return false;
+                    row_.has_dleq = true;
+                    scope_ = Scope::INPUT;
+                    break;
+                default:
+                    return fail(Error(CashuErrorCode::GENERIC, "Unbalanced JSON object"));
+            }
+            return true;
+        }
+
+        bool start_array(size_t) override {
+            if (skip_depth_ > 0) {
+                ++skip_depth_;
+                return true;
+            }
+            if (scope_ == Scope::ROOT && field_ == Field::INPUTS) {
+                scope_ = Scope::INPUTS;
+                field_ = Field::NONE;
+                return true;
+            }
+            if (scope_ == Scope::ROOT && field_ == Field::OUTPUTS) {
+                scope_ = Scope::OUTPUTS;
+                field_ = Field::NONE;
+                return true;
+            }
+            return begin_skip("array");
+        }
+
+        bool end_array() override {
+            if (skip_depth_ > 0) {
+                end_skip();
+                return true;
+            }
+            if (scope_ != Scope::INPUTS && scope_ != Scope::OUTPUTS) {
+                return fail(Error(CashuErrorCode::GENERIC, "Unbalanced JSON array"));
+            }
+            scope_ = Scope::ROOT;
+            return true;
+        }
+
+        bool parse_error(size_t position, const std::string&, const json::exception& ex) override {
+            return fail(Error(CashuErrorCode::GENERIC,
+                              "Malformed request JSON at byte " + to_string(position) + ": " + ex.what()));
+        }
+
+    private:
+        struct Row {
+            uint32_t seen = 0;
+            KeysetHandle keyset;
+            amount_t amount = 0;
+            std::string secret;
+            Point33 point{};
+            optional<std::string> witness;
+            DLEQWallet dleq;
+            bool has_dleq = false;
+
+            // Keeps string capacity so steady-state parsing does not allocate per row
+            void reset() {
+                seen = 0;
+                witness.reset();
+                has_dleq = false;
+            }
+        };
+
+        RequestKind kind_;
+        const RequestLimits& limits_;
+        ParsedRequest& out_;
+        Scope scope_ = Scope::START;
+        Field field_ = Field::NONE;
+        size_t skip_depth_ = 0;
+        uint32_t root_seen_ = 0;
+        uint32_t dleq_seen_ = 0;
+        Row row_;
+        optional<Error> error_;
+
+        bool fail(Error error) {
+            error_ = std::move(error);
+            return false;
+        }
+
+        // True if the current scalar belongs to a skipped member
+        bool skip_value() {
+            if (skip_depth_ > 0) return true;
+            if (field_ == Field::UNKNOWN) {
+                field_ = Field::NONE;
+                return true;
+            }
+            return false;
+        }
+
+        bool begin_skip(const char* type) {
+            if (field_ != Field::UNKNOWN) return unexpected(type);
+            skip_depth_ = 1;
+            return true;
+        }
+
+        void end_skip() {
+            if (--skip_depth_ == 0) {
+                field_ = Field::NONE;
+            }
+        }
+
+        bool unexpected(const char* type) {
+            return fail(Error(CashuErrorCode::GENERIC, std::string("Unexpected JSON ") + type + " in request"));
+        }
+
+        bool bad_point(const char* field) {
+            return fail(Error(CashuErrorCode::GENERIC, std::string(field) + " must be a 33-byte compressed point hex"));
+        }
+
+        bool require(uint32_t seen, uint32_t required, const char* what) {
+            if ((seen & required) != required) {
+                return fail(Error(CashuErrorCode::GENERIC, std::string("Missing required field in ") + what));
+            }
+            return true;
+        }
+
+        Field root_field(const std::string& name) const {
+            if (name == "inputs" && kind_ != RequestKind::MINT) return Field::INPUTS;
+            if (name == "outputs") return Field::OUTPUTS;
+            if (name == "quote" && kind_ != RequestKind::SWAP) return Field::QUOTE;
+            if (name == "signature" && kind_ == RequestKind::MINT) return Field::SIGNATURE;
+            return Field::UNKNOWN;
+        }
+
+        static Field input_field(const std::string& name) {
+            if (name == "id") return Field::ID;
+            if (name == "amount") return Field::AMOUNT;
+            if (name == "secret") return Field::SECRET;
+            if (name == "C") return Field::C;
+            if (name == "witness") return Field::WITNESS;
+            if (name == "dleq") return Field::DLEQ;
+            return Field::UNKNOWN;
+        }
+
+        static Field output_field(const std::string& name) {
+            if (name == "id") return Field::ID;
+            if (name == "amount") return Field::AMOUNT;
+            if (name == "B_") return Field::B_;
+            return Field::UNKNOWN;
+        }
+
+        static Field dleq_field(const std::string& name) {
+            if (name == "e") return Field::E;
+            if (name == "s") return Field::S;
+            if (name == "r") return Field::R;
+            return Field::UNKNOWN;
+        }
+    };
+}
+
+//=============================================================================
+// RequestLimits Implementation
+//=============================================================================
+
+RequestLimits RequestLimits::from_settings(const settings::MintLimits& settings) {
+    RequestLimits limits;
+    limits.max_inputs = non_negative(settings.mint_max_request_length);
+    limits.max_outputs = limits.max_inputs;
+    limits.max_secret_length = non_negative(settings.mint_max_secret_length);
+    limits.max_body_bytes = ENVELOPE_BYTES +
+        limits.max_inputs * (limits.max_secret_length * ESCAPED_BYTE_SIZE + PROOF_OVERHEAD_BYTES) +
+        limits.max_outputs * OUTPUT_BYTES;
+    return limits;
+}
+
+RequestLimits RequestLimits::current() {
+    return from_settings(settings::current_settings());
+}
+
+//=============================================================================
+// ParsedRequest Implementation
+//=============================================================================
+
+void ParsedRequest::clear() noexcept {
+    inputs.clear();
+    outputs.clear();
+    quote.reset();
+    signature.reset();
+}
+
+//=============================================================================
+// RequestParser Implementation
+//=============================================================================
+
+ParsedRequest RequestParser::parse(RequestKind kind, string_view body) const {
+    ParsedRequest result;
+    parse(kind, body, result);
+    return result;
+}
+
+void RequestParser::parse(RequestKind kind, string_view body, ParsedRequest& out) const {
+    try_parse(kind, body, out).value();
+}
+
+Result<ParsedRequest> RequestParser::try_parse(RequestKind kind, string_view body) const {
+    ParsedRequest result;
+    Result<void> status = try_parse(kind, body, result);
+    if (!status) {
+        return status.error();
+    }
+    return result;
+}
+
+Result<void> RequestParser::try_parse(RequestKind kind, string_view body, ParsedRequest& out) const {
+    const RequestLimits request_limits = limits();
+
+    // Cheapest rejection first: no byte of an oversized body is looked at
+    if (body.size() > request_limits.max_body_bytes) {
+        return Error(CashuErrorCode::TRANSACTION,
+                     "request body too large (" + to_string(body.size()) + " > " +
+                     to_string(request_limits.max_body_bytes) + " bytes)");
+    }
+
+    out.clear();
+    RequestHandler handler(kind, request_limits, out);
+    json::sax_parse(body.begin(), body.end(), &handler);
+    Result<void> status = handler.finish();
+    if (!status) {
+        return status;
+    }
+
+    // Hash all secrets at once, in parallel
+    out.inputs.compute_pending_Y();
+    return {};
+}
+
+} // namespace cashu::core
@@ -0,0 +1,238 @@
+// NUTSHELL COMPATIBILITY: cashu/core/errors.py
+// Non-throwing error path implementation
+
+#include "cashu/core/result.hpp"
+#include "cashu/core/errors.hpp"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    struct DefaultError {
+        CashuErrorCode code;
+        const char* detail;
+    };
+
+    // Details of the errors.hpp classes; codes without a DEFAULT_DETAIL use
+    // the fallback of create_error_from_code()
+    const DefaultError DEFAULT_ERRORS[] = {
+        {CashuErrorCode::GENERIC, ""},
+        {CashuErrorCode::NOT_ALLOWED, NotAllowedError::DEFAULT_DETAIL},
+        {CashuErrorCode::OUTPUTS_ALREADY_SIGNED, OutputsAlreadySignedError::DEFAULT_DETAIL},
+        {CashuErrorCode::INVALID_PROOFS, InvalidProofsError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION, TransactionError::DEFAULT_DETAIL},
+        {CashuErrorCode::TOKEN_ALREADY_SPENT, TokenAlreadySpentError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_NOT_BALANCED, "transaction not balanced"},
+        {CashuErrorCode::SECRET_TOO_LONG, SecretTooLongError::DEFAULT_DETAIL},
+        {CashuErrorCode::NO_SECRET_IN_PROOFS, NoSecretInProofsError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_UNIT, "transaction unit error"},
+        {CashuErrorCode::TRANSACTION_AMOUNT_EXCEEDS_LIMIT, "amount exceeds limit"},
+        {CashuErrorCode::TRANSACTION_DUPLICATE_INPUTS, TransactionDuplicateInputsError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_DUPLICATE_OUTPUTS, TransactionDuplicateOutputsError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_MULTIPLE_UNITS, TransactionMultipleUnitsError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_UNIT_MISMATCH, TransactionUnitMismatchError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_AMOUNTLESS_INVOICE, TransactionAmountlessInvoiceError::DEFAULT_DETAIL},
+        {CashuErrorCode::TRANSACTION_AMOUNT_INVOICE_MISMATCH, TransactionAmountInvoiceMismatchError::DEFAULT_DETAIL},
+        {CashuErrorCode::KEYSET, KeysetError::DEFAULT_DETAIL},
+        {CashuErrorCode::KEYSET_NOT_FOUND, KeysetNotFoundError::DEFAULT_DETAIL},
+        {CashuErrorCode::KEYSET_INACTIVE, KeysetInactiveError::DEFAULT_DETAIL},
+        {CashuErrorCode::LIGHTNING, LightningError::DEFAULT_DETAIL},
+        {CashuErrorCode::QUOTE_NOT_PAID, QuoteNotPaidError::DEFAULT_DETAIL},
+        {CashuErrorCode::TOKENS_ALREADY_ISSUED, TokensAlreadyIssuedError::DEFAULT_DETAIL},
+        {CashuErrorCode::MINTING_DISABLED, MintingDisabledError::DEFAULT_DETAIL},
+        {CashuErrorCode::LIGHTNING_PAYMENT_FAILED, LightningPaymentFailedError::DEFAULT_DETAIL},
+        {CashuErrorCode::QUOTE_PENDING, QuotePendingError::DEFAULT_DETAIL},
+        {CashuErrorCode::INVOICE_ALREADY_PAID, InvoiceAlreadyPaidError::DEFAULT_DETAIL},
+        {CashuErrorCode::QUOTE_EXPIRED, QuoteExpiredError::DEFAULT_DETAIL},
+        {CashuErrorCode::QUOTE_SIGNATURE_INVALID, QuoteSignatureInvalidError::DEFAULT_DETAIL},
+        {CashuErrorCode::QUOTE_REQUIRES_PUBKEY, QuoteRequiresPubkeyError::DEFAULT_DETAIL},
+        {CashuErrorCode::CLEAR_AUTH_REQUIRED, ClearAuthRequiredError::DEFAULT_DETAIL},
+        {CashuErrorCode::CLEAR_AUTH_FAILED, ClearAuthFailedError::DEFAULT_DETAIL},
+        {CashuErrorCode::BLIND_AUTH_REQUIRED, BlindAuthRequiredError::DEFAULT_DETAIL},
+        {CashuErrorCode::BLIND_AUTH_FAILED, BlindAuthFailedError::DEFAULT_DETAIL},
+        {CashuErrorCode::BLIND_AUTH_AMOUNT_EXCEEDED, BlindAuthAmountExceededError::DEFAULT_DETAIL},
+        {CashuErrorCode::BLIND_AUTH_RATE_LIMIT_EXCEEDED, BlindAuthRateLimitExceededError::DEFAULT_DETAIL}
+    };
+
+    constexpr size_t DEFAULT_ERROR_COUNT = sizeof(DEFAULT_ERRORS) / sizeof(DEFAULT_ERRORS[0]);
+
+    // Index into DEFAULT_ERRORS, or DEFAULT_ERROR_COUNT for unknown codes
+    size_t default_index(CashuErrorCode code) noexcept {
+        for (size_t i = 0; i < DEFAULT_ERROR_COUNT; ++i) {
+            if (DEFAULT_ERRORS[i].code == code) {
+                return i;
+            }
+        }
+        return DEFAULT_ERROR_COUNT;
+    }
+
+    string serialize(CashuErrorCode code, string_view detail) {
+        return nlohmann::json{
+            {"code", static_cast<int>(code)},
+            {"detail", string(detail)}
+        }.dump();
+    }
+
+    // Bodies of DEFAULT_ERRORS, serialized on first use
+    const vector<string>& default_bodies() {
+        static const vector<string> bodies = [] {
+            vector<string> result;
+            result.reserve(DEFAULT_ERROR_COUNT);
+            for (const DefaultError& error : DEFAULT_ERRORS) {
+                result.push_back(serialize(error.code, error.detail));
+            }
+            return result;
+        }();
+        return bodies;
+    }
+
+    optional<string> custom(const string& detail) {
+        return detail.empty() ? nullopt : optional<string>(detail);
+    }
+}
+
+string_view default_detail(CashuErrorCode code) noexcept {
+    size_t index = default_index(code);
+    return index < DEFAULT_ERROR_COUNT ? DEFAULT_ERRORS[index].detail : "";
+}
+
+const string& default_error_body(CashuErrorCode code) {
+    size_t index = default_index(code);
+    if (index == DEFAULT_ERROR_COUNT) {
+        throw out_of_range("Unknown error code: " + to_string(static_cast<int>(code)));
+    }
+    return default_bodies()[index];
+}
+
+//=============================================================================
+// Error Implementation
+//=============================================================================
+
+Error::Error(CashuErrorCode code, string detail) : code_(code), detail_(std::move(detail)) {
+    if (!detail_.empty() || default_index(code_) == DEFAULT_ERROR_COUNT) {
+        body_ = serialize(code_, this->detail());
+    }
+}
+
+Error Error::from(const CashuError& error) {
+    CashuErrorCode code = static_cast<CashuErrorCode>(error.get_code());
+    if (error.get_detail() == default_detail(code) && default_index(code) != DEFAULT_ERROR_COUNT) {
+        return Error(code);
+    }
+    return Error(code, error.get_detail());
+}
+
+string_view Error::detail() const noexcept {
+    return detail_.empty() ? default_detail(code_) : string_view(detail_);
+}
+
+const string& Error::body() const {
+    return body_.empty() ? default_error_body(code_) : body_;
+}
+
+void Error::raise() const {
+    const string& detail = detail_;
+    switch (code_) {
+        case CashuErrorCode::GENERIC:
+            throw invalid_argument(detail);
+
+        // General errors (10000-10999)
+        case CashuErrorCode::NOT_ALLOWED:
+            throw NotAllowedError(custom(detail));
+        case CashuErrorCode::OUTPUTS_ALREADY_SIGNED:
+            throw OutputsAlreadySignedError(custom(detail));
+        case CashuErrorCode::INVALID_PROOFS:
+            throw InvalidProofsError(custom(detail));
+
+        // Transaction errors (11000-11999)
+        case CashuErrorCode::TRANSACTION:
+            throw TransactionError(custom(detail));
+        case CashuErrorCode::TOKEN_ALREADY_SPENT:
+            throw TokenAlreadySpentError(custom(detail));
+        case CashuErrorCode::TRANSACTION_NOT_BALANCED:
+            throw TransactionNotBalancedError(string(this->detail()));
+        case CashuErrorCode::SECRET_TOO_LONG:
+            throw SecretTooLongError(string(this->detail()));
+        case CashuErrorCode::NO_SECRET_IN_PROOFS:
+            throw NoSecretInProofsError(custom(detail));
+        case CashuErrorCode::TRANSACTION_UNIT:
+            throw TransactionUnitError(string(this->detail()));
+        case CashuErrorCode::TRANSACTION_AMOUNT_EXCEEDS_LIMIT:
+            throw TransactionAmountExceedsLimitError(string(this->detail()));
+        case CashuErrorCode::TRANSACTION_DUPLICATE_INPUTS:
+            throw TransactionDuplicateInputsError(custom(detail));
+        case CashuErrorCode::TRANSACTION_DUPLICATE_OUTPUTS:
+            throw TransactionDuplicateOutputsError(custom(detail));
+        case CashuErrorCode::TRANSACTION_MULTIPLE_UNITS:
+            throw TransactionMultipleUnitsError(custom(detail));
+        case CashuErrorCode::TRANSACTION_UNIT_MISMATCH:
+            throw TransactionUnitMismatchError(custom(detail));
+        case CashuErrorCode::TRANSACTION_AMOUNTLESS_INVOICE:
+            throw TransactionAmountlessInvoiceError(custom(detail));
+        case CashuErrorCode::TRANSACTION_AMOUNT_INVOICE_MISMATCH:
+            throw TransactionAmountInvoiceMismatchError(custom(detail));
+
+        // Keyset errors (12000-12999)
+        case CashuErrorCode::KEYSET:
+            throw KeysetError(custom(detail));
+        case CashuErrorCode::KEYSET_NOT_FOUND: {
+            // KeysetNotFoundError takes the keyset id and builds the detail itself
+            const string prefix = string(KeysetNotFoundError::DEFAULT_DETAIL) + ": ";
+            if (detail.compare(0, prefix.size(), prefix) == 0) {
+                throw KeysetNotFoundError(detail.substr(prefix.size()));
+            }
+            throw KeysetNotFoundError();
+        }
+        case CashuErrorCode::KEYSET_INACTIVE:
+            throw KeysetInactiveError(custom(detail));
+
+        // Lightning errors (20000-29999)
+        case CashuErrorCode::LIGHTNING:
+            throw LightningError(custom(detail));
+        case CashuErrorCode::QUOTE_NOT_PAID:
+            throw QuoteNotPaidError(custom(detail));
+        case CashuErrorCode::TOKENS_ALREADY_ISSUED:
+            throw TokensAlreadyIssuedError(custom(detail));
+        case CashuErrorCode::MINTING_DISABLED:
+            throw MintingDisabledError(custom(detail));
+        case CashuErrorCode::LIGHTNING_PAYMENT_FAILED:
+            throw LightningPaymentFailedError(custom(detail));
+        case CashuErrorCode::QUOTE_PENDING:
+            throw QuotePendingError(custom(detail));
+        case CashuErrorCode::INVOICE_ALREADY_PAID:
+            throw InvoiceAlreadyPaidError(custom(detail));
+        case CashuErrorCode::QUOTE_EXPIRED:
+            throw QuoteExpiredError(custom(detail));
+        case CashuErrorCode::QUOTE_SIGNATURE_INVALID:
+            throw QuoteSignatureInvalidError(custom(detail));
+        case CashuErrorCode::QUOTE_REQUIRES_PUBKEY:
+            throw QuoteRequiresPubkeyError(custom(detail));
+
+        // Authentication errors (30000-31999)
+        case CashuErrorCode::CLEAR_AUTH_REQUIRED:
+            throw ClearAuthRequiredError(custom(detail));
+        case CashuErrorCode::CLEAR_AUTH_FAILED:
+            throw ClearAuthFailedError(custom(detail));
+        case CashuErrorCode::BLIND_AUTH_REQUIRED:
+            throw BlindAuthRequiredError(custom(detail));
+        case CashuErrorCode::BLIND_AUTH_FAILED:
+            throw BlindAuthFailedError(custom(detail));
+        case CashuErrorCode::BLIND_AUTH_AMOUNT_EXCEEDED:
+            throw BlindAuthAmountExceededError(custom(detail));
+        case CashuErrorCode::BLIND_AUTH_RATE_LIMIT_EXCEEDED:
+            throw BlindAuthRateLimitExceededError(custom(detail));
+    }
+
+    // Codes from Error::from() that have no class of their own
+    throw CashuError(string(this->detail()), static_cast<int>(code_));
+}
+
+} // namespace cashu::core
@@ -0,0 +1,203 @@
+// NUTSHELL COMPATIBILITY: cashu/core/secret.py, cashu/core/p2pk.py, cashu/core/htlc.py
+// NUT-10 well-known secret parsing
+
+#include "cashu/core/secret.hpp"
+#include <nlohmann/json.hpp>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace cashu::core::secret {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // Decimal integer as accepted by Python int() for tag values (no whitespace)
+    int64_t parse_int64(const string& str, const char* tag) {
+        size_t pos = 0;
+        bool negative = false;
+        if (!str.empty() && (str[0] == '-' || str[0] == '+')) {
+            negative = str[0] == '-';
+            pos = 1;
+        }
+        if (pos == str.size()) {
+            throw invalid_argument(string("Invalid ") + tag + " tag: " + str);
+        }
+        uint64_t value = 0;
+        constexpr uint64_t LIMIT = static_cast<uint64_t>(numeric_limits<int64_t>::max());
+        for (; pos < str.size(); ++pos) {
+            char c = str[pos];
+            if (c < '0' || c > '9') {
+                throw invalid_argument(string("Invalid ") + tag + " tag: " + str);
+            }
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+            if (value > LIMIT) {
+                throw invalid_argument(string("Invalid ") + tag + " tag: " + str);
+            }
+        }
+        return negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    }
+
+    size_t parse_n_sigs(const string& str, const char* tag) {
+        int64_t value = parse_int64(str, tag);
+        if (value < 1) {
+            throw invalid_argument(string("Invalid ") + tag + " tag: " + str);
+        }
+        return static_cast<size_t>(value);
+    }
+
+    const string& required_string(const json& object, const char* key) {
+        auto it = object.find(key);
+        if (it == object.end() || !it->is_string()) {
+            throw invalid_argument(string("Secret is missing string field: ") + key);
+        }
+        return it->get_ref<const string&>();
+    }
+}
+
+//=============================================================================
+// Enum Conversions
+//=============================================================================
+
+string to_string(SecretKind kind) {
+    switch (kind) {
+        case SecretKind::P2PK: return "P2PK";
+        case SecretKind::HTLC: return "HTLC";
+        default: throw invalid_argument("Invalid SecretKind");
+    }
+}
+
+SecretKind secret_kind_from_string(string_view str) {
+    if (str == "P2PK") return SecretKind::P2PK;
+    if (str == "HTLC") return SecretKind::HTLC;
+    throw invalid_argument("Invalid SecretKind: " + string(str));
+}
+
+string to_string(SigFlag flag) {
+    switch (flag) {
+        case SigFlag::SIG_INPUTS: return "SIG_INPUTS";
+        case SigFlag::SIG_ALL: return "SIG_ALL";
+        default: throw invalid_argument("Invalid SigFlag");
+    }
+}
+
+SigFlag sig_flag_from_string(string_view str) {
+    if (str == "SIG_INPUTS") return SigFlag::SIG_INPUTS;
+    if (str == "SIG_ALL") return SigFlag::SIG_ALL;
+    throw invalid_argument("Invalid SigFlag: " + string(str));
+}
+
+//=============================================================================
+// Tags Implementation
+//=============================================================================
+
+optional<string> Tags::get_tag(string_view name) const {
+    for (const auto& tag : tags) {
+        if (tag.size() >= 2 && tag[0] == name) {
+            return tag[1];
+        }
+    }
+    return nullopt;
+}
+
+vector<string> Tags::get_tag_all(string_view name) const {
+    vector<string> values;
+    for (const auto& tag : tags) {
+        if (!tag.empty() && tag[0] == name) {
+            values.insert(values.end(), tag.begin() + 1, tag.end());
+        }
+    }
+    return values;
+}
+
+//=============================================================================
+// Secret Implementation
+//=============================================================================
+
+vector<string> Secret::signing_pubkeys() const {
+    vector<string> result;
+    result.reserve(pubkeys.size() + 1);
+    if (kind == SecretKind::P2PK) {
+        result.push_back(data);
+    }
+    result.insert(result.end(), pubkeys.begin(), pubkeys.end());
+    return result;
+}
+
+bool Secret::is_well_known(string_view secret) {
+    for (char c : secret) {
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return c == '[';
+        }
+    }
+    return false;
+}
+
+Secret Secret::deserialize(string_view secret) {
+    Secret result = parse(secret);
+    result.decode_tags();
+    return result;
+}
+
+Secret Secret::parse(string_view secret) {
+    // NUTSHELL COMPATIBILITY: kind, kwargs = json.loads(secret)
+    json parsed = json::parse(secret.begin(), secret.end(), nullptr, false);
+    if (parsed.is_discarded() || !parsed.is_array() || parsed.size() != 2 ||
+        !parsed[0].is_string() || !parsed[1].is_object()) {
+        throw invalid_argument("Secret is not a well-known secret");
+    }
+
+    Secret result;
+    result.kind = secret_kind_from_string(parsed[0].get_ref<const string&>());
+    const json& body = parsed[1];
+    result.data = required_string(body, "data");
+    result.nonce = required_string(body, "nonce");
+
+    auto tags_it = body.find("tags");
+    if (tags_it != body.end() && !tags_it->is_null()) {
+        if (!tags_it->is_array()) {
+            throw invalid_argument("Secret tags must be a list");
+        }
+        result.tags.tags.reserve(tags_it->size());
+        for (const auto& tag : *tags_it) {
+            if (!tag.is_array()) {
+                throw invalid_argument("Secret tag must be a list of strings");
+            }
+            vector<string> values;
+            values.reserve(tag.size());
+            for (const auto& value : tag) {
+                if (!value.is_string()) {
+                    throw invalid_argument("Secret tag must be a list of strings");
+                }
+                values.push_back(value.get<string>());
+            }
+            result.tags.tags.push_back(move(values));
+        }
+    }
+
+    return result;
+}
+
+void Secret::decode_tags() {
+    // Decode spending-condition tags once
+    if (auto value = tags.get_tag("sigflag")) {
+        sigflag = sig_flag_from_string(*value);
+    }
+    if (auto value = tags.get_tag("locktime")) {
+        locktime = parse_int64(*value, "locktime");
+    }
+    if (auto value = tags.get_tag("n_sigs")) {
+        n_sigs = parse_n_sigs(*value, "n_sigs");
+    }
+    if (auto value = tags.get_tag("n_sigs_refund")) {
+        n_sigs_refund = parse_n_sigs(*value, "n_sigs_refund");
+    }
+    pubkeys = tags.get_tag_all("pubkeys");
+    refund = tags.get_tag_all("refund");
+}
+
+} // namespace cashu::core::secret
@@ -12,50 +12,101 @@
 #include <unordered_map>
 #include <algorithm>
 #include <cctype>
+#include <csignal>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
 
 using namespace std;
 using namespace boost::multiprecision;
 
 namespace cashu::core::settings {
 
-// Global settings instance
-std::unique_ptr<Settings> settings = nullptr;
+//=============================================================================
+// Utility Functions
+//=============================================================================
 
-// Environment variables cache
-static unordered_map<string, string> env_cache;
+namespace {
+    // Values from the loaded .env file; replaced as a whole by load_env_file()
+    shared_mutex env_cache_mutex;
+    unordered_map<string, string> env_cache;
+
+    // Process environment first, then the .env file
+    optional<string> lookup_env(const string& key) {
+        if (const char* env_val = getenv(key.c_str())) {
+            return string(env_val);
+        }
+        shared_lock<shared_mutex> lock(env_cache_mutex);
+        auto it = env_cache.find(key);
+        if (it != env_cache.end()) {
+            return it->second;
+        }
+        return nullopt;
+    }
+
+    // Published snapshot; readers go through load_published()
+#if defined(__cpp_lib_atomic_shared_ptr) && __cpp_lib_atomic_shared_ptr >= 201711L
+    atomic<shared_ptr<const SettingsSnapshot>> published;
+
+    shared_ptr<const SettingsSnapshot> load_published() {
+        return published.load(memory_order_acquire);
+    }
+
+    void store_published(shared_ptr<const SettingsSnapshot> snapshot) {
+        published.store(move(snapshot), memory_order_release);
+    }
+#else
+    shared_ptr<const SettingsSnapshot> published;
+
+    shared_ptr<const SettingsSnapshot> load_published() {
+        return atomic_load_explicit(&published, memory_order_acquire);
+    }
+
+    void store_published(shared_ptr<const SettingsSnapshot> snapshot) {
+        atomic_store_explicit(&published, move(snapshot), memory_order_release);
+    }
+#endif
+
+    // Generation of the published snapshot; 0 until settings are initialized
+    atomic<uint64_t> published_generation{0};
+    mutex reload_mutex;        // Serializes initialization and reloads
+    once_flag settings_once;
+
+    atomic<bool> reload_requested{false};
+
+    void publish(Settings settings) {
+        uint64_t generation = published_generation.load(memory_order_relaxed) + 1;
+        store_published(make_shared<const SettingsSnapshot>(move(settings), generation));
+        published_generation.store(generation, memory_order_release);
+    }
+
+    void signal_reload(int) {
+        SettingsWatcher::request_reload();
+    }
+}
 
 // Helper functions for environment variable conversion
 template<>
 bool EnvironmentLoader::get_env<bool>(const string& key, const bool& default_value) {
-    const char* env_val = getenv(key.c_str());
+    optional<string> env_val = lookup_env(key);
     if (!env_val) {
-        auto it = env_cache.find(key);
-        if (it != env_cache.end()) {
-            env_val = it->second.c_str();
-        } else {
-            return default_value;
-        }
+        return default_value;
     }
     
-    string val = env_val;
+    string val = *env_val;
     transform(val.begin(), val.end(), val.begin(), ::tolower);
     return val == "true" || val == "1" || val == "yes" || val == "on";
 }
 
 template<>
 int EnvironmentLoader::get_env<int>(const string& key, const int& default_value) {
-    const char* env_val = getenv(key.c_str());
+    optional<string> env_val = lookup_env(key);
     if (!env_val) {
-        auto it = env_cache.find(key);
-        if (it != env_cache.end()) {
-            env_val = it->second.c_str();
-        } else {
-            return default_value;
-        }
+        return default_value;
     }
     
     try {
-        return stoi(env_val);
+        return stoi(*env_val);
     } catch (const exception&) {
         return default_value;
     }
@@ -63,18 +114,13 @@ int EnvironmentLoader::get_env<int>(const string& key, const int& default_value)
 
 template<>
 double EnvironmentLoader::get_env<double>(const string& key, const double& default_value) {
-    const char* env_val = getenv(key.c_str());
+    optional<string> env_val = lookup_env(key);
     if (!env_val) {
-        auto it = env_cache.find(key);
-        if (it != env_cache.end()) {
-            env_val = it->second.c_str();
-        } else {
-            return default_value;
-        }
+        return default_value;
     }
     
     try {
-        return stod(env_val);
+        return stod(*env_val);
     } catch (const exception&) {
         return default_value;
     }
@@ -82,16 +128,7 @@ double EnvironmentLoader::get_env<double>(const string& key, const double& defau
 
 template<>
 string EnvironmentLoader::get_env<string>(const string& key, const string& default_value) {
-    const char* env_val = getenv(key.c_str());
-    if (!env_val) {
-        auto it = env_cache.find(key);
-        if (it != env_cache.end()) {
-            return it->second;
-        } else {
-            return default_value;
-        }
-    }
-    return string(env_val);
+    return lookup_env(key).value_or(default_value);
 }
 
 // EnvironmentLoader implementation
@@ -121,6 +158,7 @@ void EnvironmentLoader::load_env_file(const string& env_file) {
     
     ifstream file(env_file);
     string line;
+    unordered_map<string, string> values;
     
     while (getline(file, line)) {
         // Skip empty lines and comments
@@ -150,8 +188,11 @@ void EnvironmentLoader::load_env_file(const string& env_file) {
             value = value.substr(1, value.size() - 2);
         }
         
-        env_cache[key] = value;
+        values[key] = value;
     }
+    
+    unique_lock<shared_mutex> lock(env_cache_mutex);
+    env_cache = move(values);
 }
 
 // CashuSettings implementation
@@ -179,6 +220,7 @@ EnvSettings::EnvSettings()
     , debug_profiling(false)
     , debug_mint_only_deprecated(false)
     , db_connection_pool(true)
+    , thread_pool_size(0)
 {
     const char* home = getenv("HOME");
     cashu_dir = home ? string(home) + "/.cashu" : ".cashu";
@@ -189,6 +231,7 @@ EnvSettings::EnvSettings()
     debug_profiling = EnvironmentLoader::get_env("DEBUG_PROFILING", debug_profiling);
     debug_mint_only_deprecated = EnvironmentLoader::get_env("DEBUG_MINT_ONLY_DEPRECATED", debug_mint_only_deprecated);
     db_connection_pool = EnvironmentLoader::get_env("DB_CONNECTION_POOL", db_connection_pool);
+    thread_pool_size = EnvironmentLoader::get_env("THREAD_POOL_SIZE", thread_pool_size);
     
     string db_backup = EnvironmentLoader::get_env("DB_BACKUP_PATH", string(""));
     if (!db_backup.empty()) {
@@ -206,6 +249,8 @@ MintSettings::MintSettings()
     , mint_max_secret_length(1024)
     , mint_input_fee_ppk(0)
     , mint_disable_melt_on_error(false)
+    , mint_batch_window_us(200)
+    , mint_batch_max_size(256)
     , mint_regular_tasks_interval_seconds(3600)
 {
     string private_key = EnvironmentLoader::get_env("MINT_PRIVATE_KEY", string(""));
@@ -218,6 +263,11 @@ MintSettings::MintSettings()
         mint_seed_decryption_key = decryption_key;
     }
     
+    string keyset_cache_path = EnvironmentLoader::get_env("MINT_KEYSET_CACHE_PATH", string(""));
+    if (!keyset_cache_path.empty()) {
+        mint_keyset_cache_path = keyset_cache_path;
+    }
+    
     mint_derivation_path = EnvironmentLoader::get_env("MINT_DERIVATION_PATH", mint_derivation_path);
     mint_listen_host = EnvironmentLoader::get_env("MINT_LISTEN_HOST", mint_listen_host);
     mint_listen_port = EnvironmentLoader::get_env("MINT_LISTEN_PORT", mint_listen_port);
@@ -226,6 +276,8 @@ MintSettings::MintSettings()
     mint_max_secret_length = EnvironmentLoader::get_env("MINT_MAX_SECRET_LENGTH", mint_max_secret_length);
     mint_input_fee_ppk = EnvironmentLoader::get_env("MINT_INPUT_FEE_PPK", mint_input_fee_ppk);
     mint_disable_melt_on_error = EnvironmentLoader::get_env("MINT_DISABLE_MELT_ON_ERROR", mint_disable_melt_on_error);
+    mint_batch_window_us = EnvironmentLoader::get_env("MINT_BATCH_WINDOW_US", mint_batch_window_us);
+    mint_batch_max_size = EnvironmentLoader::get_env("MINT_BATCH_MAX_SIZE", mint_batch_max_size);
     mint_regular_tasks_interval_seconds = EnvironmentLoader::get_env("MINT_REGULAR_TASKS_INTERVAL_SECONDS", mint_regular_tasks_interval_seconds);
 }
 
@@ -520,6 +572,15 @@ void Settings::validate_settings() {
         throw runtime_error("Input fee must be non-negative.");
     }
     
+    // Validate batching settings
+    if (MintSettings::mint_batch_window_us < 0) {
+        throw runtime_error("Batch window must be non-negative.");
+    }
+    
+    if (MintSettings::mint_batch_max_size <= 0) {
+        throw runtime_error("Batch size must be positive.");
+    }
+    
     // Validate timeout settings
     if (MintSettings::mint_regular_tasks_interval_seconds <= 0) {
         throw runtime_error("Regular tasks interval must be positive.");
@@ -528,21 +589,122 @@ void Settings::validate_settings() {
     if (MintLimits::mint_websocket_read_timeout <= 0) {
         throw runtime_error("WebSocket read timeout must be positive.");
     }
+    
+    if (EnvSettings::thread_pool_size < 0) {
+        throw runtime_error("Thread pool size must be non-negative.");
+    }
 }
 
 // Global functions
 void initialize_settings() {
-    if (!settings) {
-        settings = make_unique<Settings>();
-        settings->initialize();
-    }
+    call_once(settings_once, []() {
+        lock_guard<mutex> lock(reload_mutex);
+        Settings startup;
+        startup.initialize();
+        publish(move(startup));
+    });
+}
+
+const Settings& get_settings() {
+    return current_settings();
+}
+
+// SettingsSnapshot implementation
+SettingsSnapshot::SettingsSnapshot(Settings settings, uint64_t generation)
+    : settings(move(settings))
+    , generation(generation)
+{
 }
 
-Settings& get_settings() {
-    if (!settings) {
+shared_ptr<const SettingsSnapshot> settings_snapshot() {
+    if (published_generation.load(memory_order_acquire) == 0) {
         initialize_settings();
     }
-    return *settings;
+    return load_published();
+}
+
+const Settings& current_settings() {
+    // Each thread keeps the snapshot it last read alive; refreshing it only
+    // when the generation moved keeps the common path to one atomic load
+    thread_local shared_ptr<const SettingsSnapshot> cached;
+    if (!cached || cached->generation != published_generation.load(memory_order_acquire)) {
+        cached = settings_snapshot();
+    }
+    return cached->settings;
+}
+
+shared_ptr<const SettingsSnapshot> reload_settings() {
+    initialize_settings();
+    lock_guard<mutex> lock(reload_mutex);
+    // A fresh instance re-reads the environment; it throws before publishing if invalid
+    Settings reloaded;
+    reloaded.initialize();
+    publish(move(reloaded));
+    return load_published();
+}
+
+// SettingsWatcher implementation
+SettingsWatcher::SettingsWatcher(chrono::milliseconds interval)
+    : interval_(interval)
+    , thread_(&SettingsWatcher::run, this)
+{
+}
+
+SettingsWatcher::~SettingsWatcher() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void SettingsWatcher::request_reload() noexcept {
+    reload_requested.store(true, memory_order_relaxed);
+}
+
+void SettingsWatcher::install_signal_handler(int signum) {
+    signal(signum, signal_reload);
+}
+
+optional<string> SettingsWatcher::last_error() const {
+    lock_guard<mutex> lock(mutex_);
+    return last_error_;
+}
+
+void SettingsWatcher::run() {
+    // Identity of the .env file the published settings were loaded from
+    auto file_state = []() {
+        string path = EnvironmentLoader::find_env_file();
+        error_code ec;
+        auto modified = path.empty() ? filesystem::file_time_type() : filesystem::last_write_time(path, ec);
+        return make_pair(path, modified);
+    };
+    auto loaded = file_state();
+    
+    unique_lock<mutex> lock(mutex_);
+    while (!stopping_) {
+        cv_.wait_for(lock, interval_);
+        if (stopping_) {
+            break;
+        }
+        auto current = file_state();
+        bool requested = reload_requested.exchange(false, memory_order_relaxed);
+        if (!requested && current == loaded) {
+            continue;
+        }
+        lock.unlock();
+        optional<string> error;
+        try {
+            reload_settings();
+        } catch (const exception& e) {
+            error = e.what();
+        }
+        // A broken file is not retried until it changes again
+        loaded = current;
+        lock.lock();
+        last_error_ = error;
+    }
 }
 
-} // namespace cashu::core::settings
\ No newline at end of file
+} // namespace cashu::core::settings
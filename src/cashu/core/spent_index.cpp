@@ -0,0 +1,504 @@
+// NUTSHELL COMPATIBILITY: proofs_used lookups of Ledger._check_proofs_spendable
+// In-memory spent-proof index implementation
+
+#include "cashu/core/spent_index.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace cashu::core {
+
+using base::Point33;
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    constexpr size_t MIN_CHUNK_SIZE = 256;
+    constexpr size_t MIN_TABLE_CAPACITY = 64;
+    // Filter bits per expected proof, before the block count is rounded up to
+    // a power of two: about 0.1% false positives for this split block filter
+    // (8 bits would give about 3%)
+    constexpr size_t FILTER_BITS_PER_PROOF = 16;
+    constexpr size_t FILTER_BLOCK_BITS = 512;
+
+    // Slot states. An occupied slot holds OCCUPIED | tag, plus READY once its
+    // key is written and FROZEN once it has been copied to a larger table.
+    constexpr uint64_t EMPTY = 0;
+    constexpr uint64_t MOVED = 1;      // Was empty when its table grew
+    constexpr uint64_t TOMBSTONE = 2;  // Erased; never reused
+    constexpr uint64_t OCCUPIED = uint64_t(1) << 63;
+    constexpr uint64_t READY = uint64_t(1) << 62;
+    constexpr uint64_t FROZEN = uint64_t(1) << 61;
+    constexpr uint64_t TAG_MASK = FROZEN - 1;
+
+    enum class Probe {
+        INSERTED,
+        PRESENT,
+        ABSENT,
+        ERASED,
+        MOVED,  // The table has grown; retry in the new one
+        FULL
+    };
+
+    void pause() {
+        this_thread::yield();
+    }
+}
+
+//=============================================================================
+// Internal Structures
+//=============================================================================
+
+struct SpentIndex::Hashes {
+    uint64_t index;  // Shard in the low bits, start slot above them
+    uint64_t tag;    // OCCUPIED | tag bits
+    uint64_t block;  // Filter block
+    uint64_t bits;   // Eight 6-bit positions, one per filter word
+};
+
+// Split block Bloom filter: one 512-bit block per key, one bit per word
+struct alignas(64) SpentIndex::Block {
+    atomic<uint64_t> words[8];
+
+    Block() {
+        for (auto& word : words) {
+            word.store(0, memory_order_relaxed);
+        }
+    }
+};
+
+struct SpentIndex::Table {
+    struct Slot {
+        atomic<uint64_t> state{EMPTY};
+        Point33 key;
+    };
+
+    size_t mask;
+    size_t max_used;               // Growth threshold (75% load)
+    atomic<size_t> used{0};        // Claimed slots, tombstones included
+    unique_ptr<Slot[]> slots;
+
+    explicit Table(size_t capacity)
+        : mask(capacity - 1), max_used(capacity - capacity / 4), slots(new Slot[capacity]) {}
+
+    size_t capacity() const noexcept { return mask + 1; }
+
+    // Wait for a claimed slot to finish writing its key; returns READY
+    // (possibly FROZEN) or TOMBSTONE if the key was erased meanwhile
+    static uint64_t ready_state(const Slot& slot, uint64_t state) {
+        while ((state & OCCUPIED) && !(state & READY)) {
+            pause();
+            state = slot.state.load(memory_order_acquire);
+        }
+        return state;
+    }
+
+    Probe insert(const Point33& Y, size_t start, uint64_t tag) {
+        // Probing is linear and slots never return to EMPTY, so two inserts of
+        // one key pass the same claimed slots and the second meets the first
+        for (size_t i = 0; i <= mask; ++i) {
+            Slot& slot = slots[(start + i) & mask];
+            uint64_t state = slot.state.load(memory_order_acquire);
+            for (;;) {
+                if (state == EMPTY) {
+                    if (slot.state.compare_exchange_weak(state, tag, memory_order_acq_rel,
+                                                         memory_order_acquire)) {
+                        slot.key = Y;
+                        slot.state.store(tag | READY, memory_order_release);
+                        return Probe::INSERTED;
+                    }
+                    continue;
+                }
+                if (state == MOVED) {
+                    return Probe::MOVED;
+                }
+                if (state != TOMBSTONE && (state & (OCCUPIED | TAG_MASK)) == tag &&
+                    ready_state(slot, state) != TOMBSTONE && slot.key == Y) {
+                    return Probe::PRESENT;
+                }
+                break;
+            }
+        }
+        return Probe::FULL;
+    }
+
+    Probe find(const Point33& Y, size_t start, uint64_t tag) const {
+        for (size_t i = 0; i <= mask; ++i) {
+            const Slot& slot = slots[(start + i) & mask];
+            uint64_t state = slot.state.load(memory_order_acquire);
+            if (state == EMPTY) {
+                return Probe::ABSENT;
+            }
+            if (state == MOVED) {
+                return Probe::MOVED;
+            }
+            if (state != TOMBSTONE && (state & (OCCUPIED | TAG_MASK)) == tag &&
+                ready_state(slot, state) != TOMBSTONE && slot.key == Y) {
+                return Probe::PRESENT;
+            }
+        }
+        return Probe::ABSENT;
+    }
+
+    Probe erase(const Point33& Y, size_t start, uint64_t tag) {
+        for (size_t i = 0; i <= mask; ++i) {
+            Slot& slot = slots[(start + i) & mask];
+            uint64_t state = slot.state.load(memory_order_acquire);
+            if (state == EMPTY) {
+                return Probe::ABSENT;
+            }
+            if (state == MOVED) {
+                return Probe::MOVED;
+            }
+            if (state == TOMBSTONE || (state & (OCCUPIED | TAG_MASK)) != tag) {
+                continue;
+            }
+            state = ready_state(slot, state);
+            if (state == TOMBSTONE || slot.key != Y) {
+                continue;
+            }
+            // A frozen slot has been copied; the erase must happen in the new table
+            while (!(state & FROZEN)) {
+                if (slot.state.compare_exchange_weak(state, TOMBSTONE, memory_order_acq_rel,
+                                                     memory_order_acquire)) {
+                    return Probe::ERASED;
+                }
+                if (state == TOMBSTONE) {
+                    return Probe::ABSENT;
+                }
+            }
+            return Probe::MOVED;
+        }
+        return Probe::ABSENT;
+    }
+};
+
+struct alignas(64) SpentIndex::Shard {
+    class Reader;
+
+    atomic<Table*> table{nullptr};
+    atomic<size_t> size{0};
+    mutex grow_mutex;
+    unique_ptr<Table> owned;  // The published table; replaced under grow_mutex
+    // Readers count themselves under the parity of the epoch they entered in.
+    // A grow flips the epoch after publishing the new table and frees the old
+    // one once the readers of the previous parity have left.
+    atomic<uint64_t> epoch{0};
+    mutable atomic<size_t> readers[2] = {0, 0};
+
+    // Wait until no reader can still hold a table replaced before this call
+    void synchronize() {
+        uint64_t old = epoch.load();
+        epoch.store(old + 1);
+        while (readers[old & 1].load() != 0) {
+            pause();
+        }
+    }
+};
+
+// Keeps the shard's tables alive while a thread probes them
+class SpentIndex::Shard::Reader {
+public:
+    explicit Reader(const Shard& shard) : shard_(shard) {
+        for (;;) {
+            uint64_t epoch = shard.epoch.load();
+            parity_ = epoch & 1;
+            shard.readers[parity_].fetch_add(1);
+            if (shard.epoch.load() == epoch) {
+                return;
+            }
+            shard.readers[parity_].fetch_sub(1);
+        }
+    }
+
+    ~Reader() { shard_.readers[parity_].fetch_sub(1); }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+private:
+    const Shard& shard_;
+    size_t parity_;
+};
+
+//=============================================================================
+// SpentIndex Implementation
+//=============================================================================
+
+SpentIndex::SpentIndex(size_t expected_proofs, size_t shards) {
+    size_t shard_count = next_power_of_two(max<size_t>(1, shards));
+    shard_mask_ = shard_count - 1;
+    shard_bits_ = 0;
+    while ((size_t(1) << shard_bits_) < shard_count) {
+        ++shard_bits_;
+    }
+
+    // Tables start at or below 75% load for the expected proofs
+    size_t per_shard = (expected_proofs + shard_count - 1) / shard_count;
+    size_t capacity = next_power_of_two(max(MIN_TABLE_CAPACITY, per_shard + per_shard / 3 + 1));
+    shards_.reset(new Shard[shard_count]);
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards_[i].owned = make_unique<Table>(capacity);
+        shards_[i].table.store(shards_[i].owned.get(), memory_order_release);
+    }
+
+    size_t filter_bits = max<size_t>(1, expected_proofs) * FILTER_BITS_PER_PROOF;
+    size_t blocks = next_power_of_two((filter_bits + FILTER_BLOCK_BITS - 1) / FILTER_BLOCK_BITS);
+    filter_.reset(new Block[blocks]);
+    filter_mask_ = blocks - 1;
+}
+
+SpentIndex::~SpentIndex() = default;
+
+SpentIndex::Hashes SpentIndex::hash(const Point33& Y) const noexcept {
+    // The x coordinate supplies four independent words
+    Hashes hashes;
+    hashes.index = hasher_.word(Y, 0);
+    hashes.tag = OCCUPIED | (hasher_.word(Y, 1) & TAG_MASK);
+    hashes.block = hasher_.word(Y, 2);
+    hashes.bits = hasher_.word(Y, 3);
+    return hashes;
+}
+
+bool SpentIndex::filter_may_contain(const Hashes& hashes) const noexcept {
+    const Block& block = filter_[hashes.block & filter_mask_];
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t bit = uint64_t(1) << ((hashes.bits >> (6 * i)) & 63);
+        if (!(block.words[i].load(memory_order_acquire) & bit)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SpentIndex::filter_add(const Hashes& hashes) noexcept {
+    Block& block = filter_[hashes.block & filter_mask_];
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t bit = uint64_t(1) << ((hashes.bits >> (6 * i)) & 63);
+        if (!(block.words[i].load(memory_order_relaxed) & bit)) {
+            block.words[i].fetch_or(bit, memory_order_release);
+        }
+    }
+}
+
+bool SpentIndex::insert(const Point33& Y) {
+    Hashes hashes = hash(Y);
+    // Set the filter first: once insert() returns, contains() must not miss Y
+    filter_add(hashes);
+
+    Shard& shard = shards_[hashes.index & shard_mask_];
+    size_t start = hashes.index >> shard_bits_;
+    for (;;) {
+        Table* full = nullptr;
+        bool inserted = false;
+        {
+            Shard::Reader reader(shard);
+            Table* table = shard.table.load(memory_order_acquire);
+            switch (table->insert(Y, start, hashes.tag)) {
+                case Probe::INSERTED:
+                    shard.size.fetch_add(1, memory_order_relaxed);
+                    if (table->used.fetch_add(1, memory_order_relaxed) + 1 <= table->max_used) {
+                        return true;
+                    }
+                    full = table;
+                    inserted = true;
+                    break;
+                case Probe::PRESENT:
+                    return false;
+                case Probe::FULL:
+                    full = table;
+                    break;
+                default:
+                    wait_for_growth(shard, table);
+                    continue;
+            }
+        }
+        // grow() waits for readers to leave, so it must run outside one
+        grow(shard, full);
+        if (inserted) {
+            return true;
+        }
+    }
+}
+
+bool SpentIndex::contains(const Point33& Y) const {
+    Hashes hashes = hash(Y);
+    if (!filter_may_contain(hashes)) {
+        return false;
+    }
+    const Shard& shard = shards_[hashes.index & shard_mask_];
+    size_t start = hashes.index >> shard_bits_;
+    Shard::Reader reader(shard);
+    for (;;) {
+        const Table* table = shard.table.load(memory_order_acquire);
+        Probe probe = table->find(Y, start, hashes.tag);
+        if (probe != Probe::MOVED) {
+            return probe == Probe::PRESENT;
+        }
+        wait_for_growth(shard, table);
+    }
+}
+
+bool SpentIndex::erase(const Point33& Y) {
+    Hashes hashes = hash(Y);
+    if (!filter_may_contain(hashes)) {
+        return false;
+    }
+    Shard& shard = shards_[hashes.index & shard_mask_];
+    size_t start = hashes.index >> shard_bits_;
+    Shard::Reader reader(shard);
+    for (;;) {
+        Table* table = shard.table.load(memory_order_acquire);
+        Probe probe = table->erase(Y, start, hashes.tag);
+        if (probe != Probe::MOVED) {
+            if (probe == Probe::ERASED) {
+                shard.size.fetch_sub(1, memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+        wait_for_growth(shard, table);
+    }
+}
+
+Result<void> SpentIndex::insert_all(const Point33* Ys, size_t count) {
+    // Reject known double spends before inserting, so that only a race with a
+    // concurrent spend leaves tombstones behind
+    if (find_spent(Ys, count) != count) {
+        return CashuErrorCode::TOKEN_ALREADY_SPENT;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!insert(Ys[i])) {
+            for (size_t j = 0; j < i; ++j) {
+                erase(Ys[j]);
+            }
+            return CashuErrorCode::TOKEN_ALREADY_SPENT;
+        }
+    }
+    return {};
+}
+
+Result<void> SpentIndex::insert_all(const base::ProofBatch& proofs) {
+    if (proofs.has_pending_Y()) {
+        throw logic_error("ProofBatch has rows without Y; call compute_pending_Y() first");
+    }
+    return insert_all(proofs.Y());
+}
+
+size_t SpentIndex::find_spent(const Point33* Ys, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        if (contains(Ys[i])) {
+            return i;
+        }
+    }
+    return count;
+}
+
+size_t SpentIndex::load(const vector<Point33>& Ys, ThreadPool& pool) {
+    atomic<size_t> inserted{0};
+    pool.parallel_for(Ys.size(), MIN_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            count += insert(Ys[i]) ? 1 : 0;
+        }
+        inserted.fetch_add(count, memory_order_relaxed);
+    });
+    return inserted.load();
+}
+
+size_t SpentIndex::load(const vector<models::ProofUsed>& proofs, ThreadPool& pool) {
+    atomic<size_t> inserted{0};
+    pool.parallel_for(proofs.size(), MIN_CHUNK_SIZE, [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const models::ProofUsed& proof = proofs[i];
+            Point33 Y = proof.y.has_value() ? base::point_from_hex(*proof.y, "y")
+                                            : base::hash_to_curve_Y(proof.secret);
+            count += insert(Y) ? 1 : 0;
+        }
+        inserted.fetch_add(count, memory_order_relaxed);
+    });
+    return inserted.load();
+}
+
+size_t SpentIndex::size() const noexcept {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        total += shards_[i].size.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+void SpentIndex::grow(Shard& shard, Table* full) {
+    lock_guard<mutex> lock(shard.grow_mutex);
+    if (shard.owned.get() != full) {
+        return;  // Another thread grew it
+    }
+
+    // Tombstones are dropped, so a table of mostly erased slots does not double
+    size_t capacity = full->capacity();
+    if (shard.size.load(memory_order_relaxed) >= capacity / 4) {
+        capacity *= 2;
+    }
+    auto grown = make_unique<Table>(capacity);
+
+    // Freeze every slot: empty ones become MOVED so no insert can land behind
+    // the copy, ready ones become FROZEN so erases retry in the new table
+    size_t copied = 0;
+    for (size_t i = 0; i <= full->mask; ++i) {
+        Table::Slot& slot = full->slots[i];
+        uint64_t state = slot.state.load(memory_order_acquire);
+        for (;;) {
+            if (state == EMPTY) {
+                if (slot.state.compare_exchange_weak(state, MOVED, memory_order_acq_rel,
+                                                     memory_order_acquire)) {
+                    break;
+                }
+                continue;
+            }
+            if (state == TOMBSTONE || state == MOVED) {
+                break;
+            }
+            state = Table::ready_state(slot, state);
+            if (state == TOMBSTONE) {
+                break;
+            }
+            if (slot.state.compare_exchange_weak(state, state | FROZEN, memory_order_acq_rel,
+                                                 memory_order_acquire)) {
+                // Not yet visible to other threads, so a plain probe suffices
+                Hashes hashes = hash(slot.key);
+                size_t start = hashes.index >> shard_bits_;
+                for (size_t j = 0;; ++j) {
+                    Table::Slot& target = grown->slots[(start + j) & grown->mask];
+                    if (target.state.load(memory_order_relaxed) == EMPTY) {
+                        target.key = slot.key;
+                        target.state.store(hashes.tag | READY, memory_order_relaxed);
+                        break;
+                    }
+                }
+                ++copied;
+                break;
+            }
+        }
+    }
+    grown->used.store(copied, memory_order_relaxed);
+
+    shard.table.store(grown.get(), memory_order_release);
+    // Free the old table once no reader can still be probing it
+    shard.synchronize();
+    shard.owned = move(grown);
+}
+
+void SpentIndex::wait_for_growth(const Shard& shard, const Table* old) {
+    while (shard.table.load(memory_order_acquire) == old) {
+        pause();
+    }
+}
+
+} // namespace cashu::core
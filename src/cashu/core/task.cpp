@@ -0,0 +1,63 @@
+// NUTSHELL COMPATIBILITY: asyncio coroutines used throughout nutshell's mint and wallet
+// Timer queue behind sleep_for()/sleep_until() - ENHANCEMENT beyond nutshell
+
+#include "cashu/core/task.hpp"
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// TimerQueue Implementation
+//=============================================================================
+
+TimerQueue::TimerQueue() : thread_(&TimerQueue::run, this) {}
+
+TimerQueue::~TimerQueue() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+TimerQueue& TimerQueue::global() {
+    static TimerQueue timers;
+    return timers;
+}
+
+void TimerQueue::schedule(clock::time_point deadline, function<void()> callback) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        entries_.push(Entry{deadline, next_sequence_++, move(callback)});
+    }
+    // The new entry may be earlier than the one the thread is sleeping for
+    cv_.notify_one();
+}
+
+void TimerQueue::run() {
+    unique_lock<mutex> lock(mutex_);
+    while (!stopping_) {
+        if (entries_.empty()) {
+            cv_.wait(lock);
+            continue;
+        }
+        clock::time_point deadline = entries_.top().deadline;
+        if (clock::now() < deadline) {
+            cv_.wait_until(lock, deadline);
+            continue;
+        }
+        function<void()> callback = move(const_cast<Entry&>(entries_.top()).callback);
+        entries_.pop();
+        lock.unlock();
+        try {
+            callback();
+        } catch (...) {
+            // Timer callbacks report errors through their own channels
+        }
+        lock.lock();
+    }
+}
+
+} // namespace cashu::core
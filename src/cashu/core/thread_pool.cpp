@@ -0,0 +1,187 @@
+// NUTSHELL COMPATIBILITY: Executor behind async_wrap in cashu/core/helpers.py
+// Work-stealing thread pool implementation - ENHANCEMENT beyond nutshell
+
+#include "cashu/core/thread_pool.hpp"
+#include "cashu/core/settings.hpp"
+#include <exception>
+
+using namespace std;
+
+namespace cashu::core {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    // Pool and deque index of the calling worker thread
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_worker = 0;
+
+    // Shared by the caller and helper tasks of one parallel_for
+    struct ChunkState {
+        size_t count = 0;
+        size_t chunks = 0;
+        size_t chunk_size = 0;
+        function<void(size_t, size_t)> body;
+        atomic<size_t> next{0};
+        atomic<size_t> done{0};
+        mutex done_mutex;
+        condition_variable done_cv;
+        exception_ptr error;  // Guarded by done_mutex
+
+        // Claim and run chunks until none are left
+        void run() {
+            for (;;) {
+                size_t chunk = next.fetch_add(1);
+                if (chunk >= chunks) {
+                    return;
+                }
+                size_t begin = chunk * chunk_size;
+                size_t end = min(count, begin + chunk_size);
+                exception_ptr failure;
+                try {
+                    body(begin, end);
+                } catch (...) {
+                    failure = current_exception();
+                }
+                lock_guard<mutex> lock(done_mutex);
+                if (failure && !error) {
+                    error = failure;
+                }
+                if (done.fetch_add(1) + 1 == chunks) {
+                    done_cv.notify_all();
+                }
+            }
+        }
+    };
+}
+
+//=============================================================================
+// ThreadPool Implementation
+//=============================================================================
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = max<size_t>(1, thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(make_unique<Worker>());
+    }
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool(static_cast<size_t>(max(0, settings::get_settings().thread_pool_size)));
+    return pool;
+}
+
+bool ThreadPool::in_worker() const noexcept {
+    return current_pool == this;
+}
+
+void ThreadPool::post(function<void()> task, TaskPriority priority) {
+    size_t target = in_worker() ? current_worker : next_worker_.fetch_add(1) % workers_.size();
+    {
+        // Count before pushing so a popped task never underflows queued_
+        lock_guard<mutex> lock(sleep_mutex_);
+        queued_.fetch_add(1);
+    }
+    {
+        Worker& worker = *workers_[target];
+        lock_guard<mutex> lock(worker.mutex);
+        worker.queues[static_cast<size_t>(priority)].push_back(move(task));
+    }
+    sleep_cv_.notify_one();
+}
+
+bool ThreadPool::pop_task(size_t self, function<void()>& task) {
+    size_t n = workers_.size();
+    for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority) {
+        // Own deque LIFO, then steal FIFO from the others
+        for (size_t k = 0; k < n; ++k) {
+            Worker& worker = *workers_[(self + k) % n];
+            lock_guard<mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+            if (k == 0 && in_worker()) {
+                task = move(queue.back());
+                queue.pop_back();
+            } else {
+                task = move(queue.front());
+                queue.pop_front();
+            }
+            queued_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::run_pending_task() {
+    function<void()> task;
+    if (!pop_task(in_worker() ? current_worker : 0, task)) {
+        return false;
+    }
+    try {
+        task();
+    } catch (...) {
+        // Posted task exceptions are discarded (submit() reports them via the future)
+    }
+    return true;
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    for (;;) {
+        if (run_pending_task()) {
+            continue;
+        }
+        unique_lock<mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this]() { return queued_.load() > 0 || stopping_; });
+        if (stopping_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::run_chunks(size_t count, size_t chunks, function<void(size_t, size_t)> body,
+                            TaskPriority priority) {
+    auto state = make_shared<ChunkState>();
+    state->count = count;
+    state->chunk_size = (count + chunks - 1) / chunks;
+    state->chunks = (count + state->chunk_size - 1) / state->chunk_size;
+    state->body = move(body);
+
+    // Helpers that start after all chunks are claimed return immediately
+    for (size_t i = 1; i < state->chunks; ++i) {
+        post([state]() { state->run(); }, priority);
+    }
+    state->run();
+
+    unique_lock<mutex> lock(state->done_mutex);
+    state->done_cv.wait(lock, [&state]() { return state->done.load() == state->chunks; });
+    if (state->error) {
+        rethrow_exception(state->error);
+    }
+}
+
+} // namespace cashu::core
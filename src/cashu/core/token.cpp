@@ -0,0 +1,640 @@
+// NUTSHELL COMPATIBILITY: cashu/core/base.py TokenV3 / TokenV4
+// Token serialization implementation (V3 JSON and V4 CBOR)
+
+#include "cashu/core/token.hpp"
+#include "cashu/core/errors.hpp"
+#include "cashu/core/json_writer.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace cashu::core::base {
+
+//=============================================================================
+// Utility Functions
+//=============================================================================
+
+namespace {
+    constexpr size_t MAX_CBOR_DEPTH = 16;
+
+    // CBOR major types (RFC 8949)
+    constexpr uint8_t CBOR_UINT = 0;
+    constexpr uint8_t CBOR_BYTES = 2;
+    constexpr uint8_t CBOR_TEXT = 3;
+    constexpr uint8_t CBOR_ARRAY = 4;
+    constexpr uint8_t CBOR_MAP = 5;
+    constexpr uint8_t CBOR_TAG = 6;
+    constexpr uint8_t CBOR_NULL = 0xF6;
+
+    int base64_value(char c) {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+' || c == '-') return 62;
+        if (c == '/' || c == '_') return 63;
+        return -1;
+    }
+
+    // Append base64url with '=' padding (urlsafe_b64encode)
+    void base64url_append(string& out, const uint8_t* data, size_t size) {
+        static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        out.reserve(out.size() + (size + 2) / 3 * 4);
+        size_t i = 0;
+        for (; i + 3 <= size; i += 3) {
+            uint32_t n = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+            out.push_back(alphabet[(n >> 18) & 63]);
+            out.push_back(alphabet[(n >> 12) & 63]);
+            out.push_back(alphabet[(n >> 6) & 63]);
+            out.push_back(alphabet[n & 63]);
+        }
+        if (i < size) {
+            uint32_t n = uint32_t(data[i]) << 16;
+            if (i + 1 < size) n |= uint32_t(data[i + 1]) << 8;
+            out.push_back(alphabet[(n >> 18) & 63]);
+            out.push_back(alphabet[(n >> 12) & 63]);
+            out.push_back(i + 1 < size ? alphabet[(n >> 6) & 63] : '=');
+            out.push_back('=');
+        }
+    }
+
+    // Decode standard or urlsafe base64, padded or not, into out (replacing its contents)
+    void base64_decode(string_view encoded, vector<uint8_t>& out) {
+        while (!encoded.empty() && encoded.back() == '=') {
+            encoded.remove_suffix(1);
+        }
+        if (encoded.size() % 4 == 1) {
+            throw invalid_argument("Invalid base64 length");
+        }
+
+        out.clear();
+        out.reserve(encoded.size() * 3 / 4);
+        uint32_t buffer = 0;
+        int bits = 0;
+        for (char c : encoded) {
+            int value = base64_value(c);
+            if (value < 0) {
+                throw invalid_argument("Invalid base64 character");
+            }
+            buffer = (buffer << 6) | static_cast<uint32_t>(value);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out.push_back(static_cast<uint8_t>((buffer >> bits) & 0xFF));
+            }
+        }
+    }
+
+    string_view strip_prefix(string_view token, string_view prefix) {
+        if (token.substr(0, prefix.size()) != prefix) {
+            throw invalid_argument("Token must start with " + string(prefix));
+        }
+        return token.substr(prefix.size());
+    }
+
+    //---- CBOR writer ----
+
+    void cbor_head(vector<uint8_t>& out, uint8_t major, uint64_t value) {
+        uint8_t type = static_cast<uint8_t>(major << 5);
+        if (value < 24) {
+            out.push_back(type | static_cast<uint8_t>(value));
+        } else if (value <= 0xFF) {
+            out.push_back(type | 24);
+            out.push_back(static_cast<uint8_t>(value));
+        } else if (value <= 0xFFFF) {
+            out.push_back(type | 25);
+            for (int shift = 8; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(value >> shift));
+        } else if (value <= 0xFFFFFFFF) {
+            out.push_back(type | 26);
+            for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(value >> shift));
+        } else {
+            out.push_back(type | 27);
+            for (int shift = 56; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void cbor_text(vector<uint8_t>& out, string_view text) {
+        cbor_head(out, CBOR_TEXT, text.size());
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    // Hex string written as a CBOR byte string, decoded straight into out
+    void cbor_hex_bytes(vector<uint8_t>& out, const string& hex, const char* field) {
+        if (hex.size() % 2 != 0) {
+            throw invalid_argument(string(field) + " must be hex");
+        }
+        size_t size = hex.size() / 2;
+        cbor_head(out, CBOR_BYTES, size);
+        size_t offset = out.size();
+        out.resize(offset + size);
+        if (!crypto::secp_utils::hex_to_bytes(hex, out.data() + offset, size)) {
+            throw invalid_argument(string(field) + " must be hex");
+        }
+    }
+
+    //---- CBOR reader ----
+
+    class CborReader {
+    public:
+        CborReader(const uint8_t* data, size_t size) : pos_(data), end_(data + size) {}
+
+        bool at_end() const { return pos_ == end_; }
+        size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+        uint8_t peek() const {
+            if (pos_ == end_) fail("unexpected end of data");
+            return *pos_;
+        }
+
+        // Read an item head; rejects indefinite lengths (cbor2 never emits them)
+        uint64_t head(uint8_t& major) {
+            uint8_t initial = peek();
+            ++pos_;
+            major = initial >> 5;
+            uint8_t info = initial & 31;
+            if (info < 24) return info;
+            if (info > 27) fail("indefinite or reserved length");
+            size_t bytes = size_t(1) << (info - 24);
+            if (remaining() < bytes) fail("unexpected end of data");
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                value = (value << 8) | *pos_++;
+            }
+            return value;
+        }
+
+        uint64_t expect(uint8_t expected_major, const char* what) {
+            uint8_t major;
+            uint64_t value = head(major);
+            if (major != expected_major) fail(string(what) + " has wrong type");
+            return value;
+        }
+
+        // Container length, bounded by the remaining input so hostile counts cannot force huge reserves
+        size_t length(uint8_t major, const char* what) {
+            uint64_t count = expect(major, what);
+            if (count > remaining()) fail(string(what) + " length exceeds input");
+            return static_cast<size_t>(count);
+        }
+
+        string_view text(const char* what) {
+            size_t size = payload(CBOR_TEXT, what);
+            string_view view(reinterpret_cast<const char*>(pos_), size);
+            pos_ += size;
+            return view;
+        }
+
+        ByteView bytes(const char* what) {
+            size_t size = payload(CBOR_BYTES, what);
+            ByteView view{pos_, size};
+            pos_ += size;
+            return view;
+        }
+
+        bool null() {
+            if (peek() == CBOR_NULL) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void skip(size_t depth = 0) {
+            if (depth > MAX_CBOR_DEPTH) fail("nesting too deep");
+            uint8_t major;
+            uint64_t value = head(major);
+            switch (major) {
+                case CBOR_BYTES:
+                case CBOR_TEXT:
+                    if (value > remaining()) fail("string length exceeds input");
+                    pos_ += value;
+                    break;
+                case CBOR_ARRAY:
+                    for (uint64_t i = 0; i < value; ++i) skip(depth + 1);
+                    break;
+                case CBOR_MAP:
+                    for (uint64_t i = 0; i < value; ++i) {
+                        skip(depth + 1);
+                        skip(depth + 1);
+                    }
+                    break;
+                case CBOR_TAG:
+                    skip(depth + 1);
+                    break;
+                default:  // Integers and simple values/floats: head only
+                    break;
+            }
+        }
+
+        [[noreturn]] static void fail(const string& detail) {
+            throw invalid_argument("Invalid token CBOR: " + detail);
+        }
+
+    private:
+        const uint8_t* pos_;
+        const uint8_t* end_;
+
+        size_t payload(uint8_t major, const char* what) {
+            uint64_t size = expect(major, what);
+            if (size > remaining()) fail(string(what) + " length exceeds input");
+            return static_cast<size_t>(size);
+        }
+    };
+
+    DLEQView read_dleq(CborReader& reader) {
+        DLEQView dleq;
+        bool has_e = false, has_s = false, has_r = false;
+        size_t fields = reader.length(CBOR_MAP, "dleq");
+        for (size_t i = 0; i < fields; ++i) {
+            string_view key = reader.text("dleq key");
+            if (key == "e") { dleq.e = reader.bytes("dleq.e"); has_e = true; }
+            else if (key == "s") { dleq.s = reader.bytes("dleq.s"); has_s = true; }
+            else if (key == "r") { dleq.r = reader.bytes("dleq.r"); has_r = true; }
+            else reader.skip();
+        }
+        if (!has_e || !has_s || !has_r) {
+            CborReader::fail("dleq requires e, s and r");
+        }
+        return dleq;
+    }
+
+    ProofView read_proof(CborReader& reader) {
+        ProofView proof;
+        bool has_amount = false, has_secret = false, has_C = false;
+        size_t fields = reader.length(CBOR_MAP, "proof");
+        for (size_t i = 0; i < fields; ++i) {
+            string_view key = reader.text("proof key");
+            if (key == "a") {
+                proof.amount = reader.expect(CBOR_UINT, "proof amount");
+                has_amount = true;
+            } else if (key == "s") {
+                proof.secret = reader.text("proof secret");
+                has_secret = true;
+            } else if (key == "c") {
+                proof.C = reader.bytes("proof C");
+                has_C = true;
+            } else if (key == "d") {
+                if (!reader.null()) proof.dleq = read_dleq(reader);
+            } else if (key == "w") {
+                if (!reader.null()) proof.witness = reader.text("proof witness");
+            } else {
+                reader.skip();
+            }
+        }
+        if (!has_amount || !has_secret || !has_C) {
+            CborReader::fail("proof requires a, s and c");
+        }
+        return proof;
+    }
+
+    // Read one {"i": id, "p": [proofs]} group, appending its proofs to out
+    void read_group(CborReader& reader, vector<ProofView>& out) {
+        optional<ByteView> keyset_id;
+        bool has_proofs = false;
+        size_t first = out.size();
+        size_t fields = reader.length(CBOR_MAP, "token group");
+        for (size_t i = 0; i < fields; ++i) {
+            string_view key = reader.text("token group key");
+            if (key == "i") {
+                keyset_id = reader.bytes("keyset id");
+            } else if (key == "p") {
+                size_t count = reader.length(CBOR_ARRAY, "proofs");
+                out.reserve(out.size() + count);
+                for (size_t k = 0; k < count; ++k) {
+                    out.push_back(read_proof(reader));
+                }
+                has_proofs = true;
+            } else {
+                reader.skip();
+            }
+        }
+        if (!keyset_id || !has_proofs) {
+            CborReader::fail("token group requires i and p");
+        }
+        // "i" may follow "p", so assign the id once the group is complete
+        for (size_t k = first; k < out.size(); ++k) {
+            out[k].keyset_id = *keyset_id;
+        }
+    }
+
+    Proof proof_from_json(const json& j) {
+        Proof proof(j.at("id").get<string>(), j.at("amount").get<amount_t>(),
+                    j.at("secret").get<string>(), j.at("C").get<string>());
+        if (j.contains("dleq") && !j["dleq"].is_null()) {
+            const json& dleq = j["dleq"];
+            proof.dleq = DLEQWallet(dleq.at("e").get<string>(), dleq.at("s").get<string>(),
+                                    dleq.value("r", string()));
+        }
+        if (j.contains("witness") && !j["witness"].is_null()) {
+            proof.witness = j["witness"].get<string>();
+        }
+        return proof;
+    }
+}
+
+//=============================================================================
+// View Implementation
+//=============================================================================
+
+string ByteView::hex() const {
+    return crypto::secp_utils::bytes_to_hex(data, size);
+}
+
+Proof ProofView::to_proof() const {
+    Proof proof(keyset_id.hex(), amount, string(secret), C.hex());
+    if (dleq.has_value()) {
+        proof.dleq = DLEQWallet(dleq->e.hex(), dleq->s.hex(), dleq->r.hex());
+    }
+    if (witness.has_value()) {
+        proof.witness = string(*witness);
+    }
+    return proof;
+}
+
+//=============================================================================
+// TokenV3 Implementation
+//=============================================================================
+
+amount_t TokenV3::amount() const {
+    amount_t total = 0;
+    for (const auto& entry : token) {
+        total = checked_add(total, sum_amounts(entry.proofs));
+    }
+    return total;
+}
+
+string TokenV3::serialize(bool include_dleq) const {
+    string body;
+    JsonWriter writer(body);
+    writer.begin_object().key("token").begin_array();
+    for (const auto& entry : token) {
+        writer.begin_object().field("mint", entry.mint).key("proofs");
+        write_json_array(writer, entry.proofs.data(), entry.proofs.size(),
+                         include_dleq ? ProofProjection::WITH_DLEQ : ProofProjection::NO_DLEQ);
+        writer.end_object();
+    }
+    writer.end_array();
+    if (memo.has_value() && !memo->empty()) {
+        writer.field("memo", memo.value());
+    }
+    if (unit.has_value() && !unit->empty()) {
+        writer.field("unit", unit.value());
+    }
+    writer.end_object();
+
+    string result(PREFIX);
+    base64url_append(result, reinterpret_cast<const uint8_t*>(body.data()), body.size());
+    return result;
+}
+
+TokenV3 TokenV3::deserialize(string_view token_str) {
+    vector<uint8_t> bytes;
+    base64_decode(strip_prefix(token_str, PREFIX), bytes);
+
+    json j;
+    try {
+        j = json::parse(bytes.begin(), bytes.end());
+    } catch (const json::exception& e) {
+        throw invalid_argument(string("Invalid V3 token JSON: ") + e.what());
+    }
+
+    TokenV3 result;
+    try {
+        for (const auto& entry_json : j.at("token")) {
+            Entry entry;
+            entry.mint = entry_json.at("mint").get<string>();
+            for (const auto& proof_json : entry_json.at("proofs")) {
+                entry.proofs.push_back(proof_from_json(proof_json));
+            }
+            result.token.push_back(std::move(entry));
+        }
+        if (j.contains("unit") && !j["unit"].is_null()) {
+            result.unit = j["unit"].get<string>();
+        }
+        if (j.contains("memo") && !j["memo"].is_null()) {
+            result.memo = j["memo"].get<string>();
+        }
+    } catch (const json::exception& e) {
+        throw invalid_argument(string("Invalid V3 token: ") + e.what());
+    }
+    return result;
+}
+
+//=============================================================================
+// TokenV4 Implementation
+//=============================================================================
+
+amount_t TokenV4::amount() const {
+    return sum_amounts(proofs);
+}
+
+void TokenV4::to_cbor(vector<uint8_t>& out, bool include_dleq) const {
+    // Keyset ids in first-seen order; tokens carry few keysets, so a linear scan is enough
+    vector<const string*> keyset_ids;
+    for (const auto& proof : proofs) {
+        if (none_of(keyset_ids.begin(), keyset_ids.end(), [&](const string* id) { return *id == proof.id(); })) {
+            keyset_ids.push_back(&proof.id());
+        }
+    }
+
+    // NUTSHELL COMPATIBILITY: key order t, d, m, u as in TokenV4.serialize_to_dict
+    bool has_memo = memo.has_value() && !memo->empty();
+    cbor_head(out, CBOR_MAP, has_memo ? 4 : 3);
+    cbor_text(out, "t");
+    cbor_head(out, CBOR_ARRAY, keyset_ids.size());
+    for (const string* keyset_id : keyset_ids) {
+        size_t count = count_if(proofs.begin(), proofs.end(), [&](const Proof& p) { return p.id() == *keyset_id; });
+        cbor_head(out, CBOR_MAP, 2);
+        cbor_text(out, "i");
+        cbor_hex_bytes(out, *keyset_id, "keyset id");
+        cbor_text(out, "p");
+        cbor_head(out, CBOR_ARRAY, count);
+        for (const auto& proof : proofs) {
+            if (proof.id() != *keyset_id) continue;
+            bool write_dleq = include_dleq && proof.dleq.has_value();
+            cbor_head(out, CBOR_MAP, 3 + (write_dleq ? 1 : 0) + (proof.witness.has_value() ? 1 : 0));
+            cbor_text(out, "a");
+            cbor_head(out, CBOR_UINT, proof.amount);
+            cbor_text(out, "s");
+            cbor_text(out, proof.secret);
+            cbor_text(out, "c");
+            cbor_hex_bytes(out, proof.C, "C");
+            if (write_dleq) {
+                cbor_text(out, "d");
+                cbor_head(out, CBOR_MAP, 3);
+                cbor_text(out, "e");
+                cbor_hex_bytes(out, proof.dleq->e, "dleq.e");
+                cbor_text(out, "s");
+                cbor_hex_bytes(out, proof.dleq->s, "dleq.s");
+                cbor_text(out, "r");
+                cbor_hex_bytes(out, proof.dleq->r, "dleq.r");
+            }
+            if (proof.witness.has_value()) {
+                cbor_text(out, "w");
+                cbor_text(out, proof.witness.value());
+            }
+        }
+    }
+    if (has_memo) {
+        cbor_text(out, "d");
+        cbor_text(out, memo.value());
+    }
+    cbor_text(out, "m");
+    cbor_text(out, mint);
+    cbor_text(out, "u");
+    cbor_text(out, unit);
+}
+
+void TokenV4::serialize(string& out, bool include_dleq) const {
+    // Per-thread scratch keeps repeated serialization allocation-free
+    thread_local vector<uint8_t> cbor;
+    cbor.clear();
+    to_cbor(cbor, include_dleq);
+    out.append(PREFIX.data(), PREFIX.size());
+    base64url_append(out, cbor.data(), cbor.size());
+}
+
+string TokenV4::serialize(bool include_dleq) const {
+    string out;
+    serialize(out, include_dleq);
+    return out;
+}
+
+TokenV4 TokenV4::deserialize(string_view token) {
+    vector<uint8_t> buffer;
+    return TokenV4View::parse(token, buffer).to_token();
+}
+
+TokenV4 TokenV4::from_v3(const TokenV3& token) {
+    if (token.token.empty()) {
+        throw invalid_argument("TokenV3 must contain proofs from exactly one mint");
+    }
+    TokenV4 result;
+    result.mint = token.token.front().mint;
+    for (const auto& entry : token.token) {
+        if (entry.mint != result.mint) {
+            throw invalid_argument("TokenV3 must contain proofs from exactly one mint");
+        }
+        result.proofs.insert(result.proofs.end(), entry.proofs.begin(), entry.proofs.end());
+    }
+    result.unit = token.unit.value_or("sat");
+    result.memo = token.memo;
+    return result;
+}
+
+TokenV3 TokenV4::to_v3() const {
+    TokenV3 result;
+    result.token.push_back(TokenV3::Entry{mint, proofs});
+    result.unit = unit;
+    result.memo = memo;
+    return result;
+}
+
+//=============================================================================
+// TokenV4View Implementation
+//=============================================================================
+
+TokenV4View TokenV4View::parse(string_view token, vector<uint8_t>& buffer) {
+    base64_decode(strip_prefix(token, TokenV4::PREFIX), buffer);
+    return parse_cbor(buffer.data(), buffer.size());
+}
+
+TokenV4View TokenV4View::parse_cbor(const uint8_t* data, size_t size) {
+    TokenV4View view;
+    CborReader reader(data, size);
+    bool has_mint = false, has_unit = false, has_groups = false;
+
+    size_t fields = reader.length(CBOR_MAP, "token");
+    for (size_t i = 0; i < fields; ++i) {
+        string_view key = reader.text("token key");
+        if (key == "m") {
+            view.mint = reader.text("mint");
+            has_mint = true;
+        } else if (key == "u") {
+            view.unit = reader.text("unit");
+            has_unit = true;
+        } else if (key == "d") {
+            if (!reader.null()) view.memo = reader.text("memo");
+        } else if (key == "t") {
+            size_t groups = reader.length(CBOR_ARRAY, "token groups");
+            for (size_t g = 0; g < groups; ++g) {
+                read_group(reader, view.proofs);
+            }
+            has_groups = true;
+        } else {
+            reader.skip();
+        }
+    }
+    if (!has_mint || !has_unit || !has_groups) {
+        CborReader::fail("token requires m, u and t");
+    }
+    if (!reader.at_end()) {
+        CborReader::fail("trailing bytes after token");
+    }
+    return view;
+}
+
+amount_t TokenV4View::amount() const {
+    return sum_amounts(proofs);
+}
+
+vector<Proof> TokenV4View::to_proofs() const {
+    vector<Proof> result;
+    result.reserve(proofs.size());
+    for (const auto& proof : proofs) {
+        result.push_back(proof.to_proof());
+    }
+    return result;
+}
+
+TokenV4 TokenV4View::to_token() const {
+    TokenV4 token;
+    token.mint = string(mint);
+    token.unit = string(unit);
+    if (memo.has_value()) {
+        token.memo = string(*memo);
+    }
+    token.proofs = to_proofs();
+    return token;
+}
+
+void TokenV4View::append_to(ProofBatch& batch) const {
+    batch.reserve(batch.size() + proofs.size());
+
+    // Proofs of one group share a keyset id: resolve each distinct id once
+    const ByteView* last_id = nullptr;
+    KeysetHandle handle;
+    for (const auto& proof : proofs) {
+        if (!last_id || proof.keyset_id.size != last_id->size ||
+            memcmp(proof.keyset_id.data, last_id->data, last_id->size) != 0) {
+            string id = proof.keyset_id.hex();
+            auto found = KeysetInterner::global().find(id);
+            if (!found) {
+                throw KeysetNotFoundError(id);
+            }
+            handle = *found;
+            last_id = &proof.keyset_id;
+        }
+
+        if (proof.C.size != 33) {
+            throw invalid_argument("C must be a 33-byte compressed point");
+        }
+        Point33 C;
+        memcpy(C.data(), proof.C.data, C.size());
+
+        optional<DLEQWallet> dleq;
+        if (proof.dleq.has_value()) {
+            dleq = DLEQWallet(proof.dleq->e.hex(), proof.dleq->s.hex(), proof.dleq->r.hex());
+        }
+        optional<string> witness;
+        if (proof.witness.has_value()) {
+            witness = string(*proof.witness);
+        }
+        batch.push_back_unhashed(handle, proof.amount, proof.secret, C, std::move(witness), std::move(dleq));
+    }
+}
+
+} // namespace cashu::core::base
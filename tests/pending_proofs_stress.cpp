@@ -0,0 +1,155 @@
+// Concurrency stress driver for PendingProofs
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude tests/pending_proofs_stress.cpp src/cashu/core/*.cpp src/cashu/core/crypto/*.cpp src/cashu/core/nuts/*.cpp -lsecp256k1 -lcrypto -o pending_proofs_stress && ./pending_proofs_stress
+//
+// Melts with overlapping input sets run concurrently on few stripes. Checks:
+//   - no Y is ever pending for two quotes at once
+//   - a successful mark holds every input, a failed one none
+//   - release() racing a mark of the same quote never leaves inputs behind:
+//     every input marked pending is released exactly once
+
+#include "cashu/core/pending_proofs.hpp"
+#include "test_support.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cashu::core;
+using namespace cashu::test;
+using base::Point33;
+
+namespace {
+    constexpr size_t THREADS = 8;
+    constexpr size_t POOL = 512;        // Ys shared by all melts
+    constexpr size_t ITERATIONS = 4000; // Melts per thread and phase
+    constexpr size_t MAX_INPUTS = 8;
+    constexpr size_t QUOTES_PER_THREAD = 4;
+
+    // Distinct random inputs from the pool
+    vector<size_t> pick(mt19937_64& rng) {
+        size_t count = 1 + rng() % MAX_INPUTS;
+        vector<size_t> picked;
+        while (picked.size() < count) {
+            size_t i = rng() % POOL;
+            bool seen = false;
+            for (size_t j : picked) {
+                seen = seen || j == i;
+            }
+            if (!seen) {
+                picked.push_back(i);
+            }
+        }
+        return picked;
+    }
+
+    string quote_name(size_t thread, size_t slot) {
+        return "quote-" + to_string(thread) + "-" + to_string(slot);
+    }
+
+    template<typename Worker>
+    void run_threads(size_t count, Worker worker) {
+        atomic<bool> start{false};
+        vector<thread> threads;
+        for (size_t t = 0; t < count; ++t) {
+            threads.emplace_back([&, t]() {
+                while (!start.load()) {
+                    this_thread::yield();
+                }
+                worker(t);
+            });
+        }
+        start.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+int main() {
+    const vector<Point33> pool = random_points(POOL, 42);
+    PendingProofs pending(4);
+
+    // Rejected sets leave nothing behind
+    check(!pending.try_mark_pending("empty", pool.data(), 0), "empty input set is rejected");
+    check(pending.inputs_of("empty").empty(), "rejected quote holds nothing");
+    vector<Point33> twice = {pool[0], pool[1], pool[0]};
+    check(pending.try_mark_pending("twice", twice).error().code() == CashuErrorCode::TRANSACTION_DUPLICATE_INPUTS,
+          "repeated input is a duplicate");
+    check(pending.size() == 0, "failed marks roll back");
+
+    // Phase 1: exclusivity. owner[i] mirrors which quote holds pool[i]; a
+    // successful mark must find every input unowned
+    vector<atomic<uint32_t>> owner(POOL);
+    run_threads(THREADS, [&](size_t t) {
+        mt19937_64 rng(t);
+        for (size_t k = 0; k < ITERATIONS; ++k) {
+            string quote = quote_name(t, k % QUOTES_PER_THREAD);
+            uint32_t id = static_cast<uint32_t>(t + 1);
+            vector<size_t> picked = pick(rng);
+            vector<Point33> Ys;
+            for (size_t i : picked) {
+                Ys.push_back(pool[i]);
+            }
+            if (!pending.try_mark_pending(quote, Ys)) {
+                continue;
+            }
+            for (size_t i : picked) {
+                uint32_t expected = 0;
+                check(owner[i].compare_exchange_strong(expected, id), "input is held by one quote only");
+                check(pending.quote_of(pool[i]) == quote, "marked input names its quote");
+            }
+            check(pending.inputs_of(quote).size() == Ys.size(), "quote holds its whole set");
+            for (size_t i : picked) {
+                owner[i].store(0);
+            }
+            check(pending.release(quote) == Ys.size(), "release frees the whole set");
+        }
+    });
+    check(pending.size() == 0, "nothing pending after phase 1");
+
+    // Phase 2: releases race marks of the same quotes
+    atomic<size_t> marked{0};
+    atomic<size_t> released{0};
+    run_threads(THREADS, [&](size_t t) {
+        mt19937_64 rng(100 + t);
+        for (size_t k = 0; k < ITERATIONS; ++k) {
+            if (t % 2 == 0) {
+                string quote = quote_name(t, k % QUOTES_PER_THREAD);
+                vector<Point33> Ys;
+                for (size_t i : pick(rng)) {
+                    Ys.push_back(pool[i]);
+                }
+                if (pending.try_mark_pending(quote, Ys)) {
+                    marked.fetch_add(Ys.size());
+                }
+                if (rng() % 2 == 0) {
+                    released.fetch_add(pending.release(quote));
+                }
+            } else {
+                // Release a quote another thread may be marking right now
+                string quote = quote_name(t - 1, rng() % QUOTES_PER_THREAD);
+                released.fetch_add(pending.release(quote));
+            }
+        }
+    });
+    for (size_t t = 0; t < THREADS; ++t) {
+        for (size_t slot = 0; slot < QUOTES_PER_THREAD; ++slot) {
+            released.fetch_add(pending.release(quote_name(t, slot)));
+        }
+    }
+    check(released.load() == marked.load(), "every marked input is released exactly once");
+    check(pending.size() == 0, "no input is left pending without a quote");
+
+    if (failures.load() != 0) {
+        fprintf(stderr, "%zu checks failed\n", failures.load());
+        return EXIT_FAILURE;
+    }
+    printf("pending_proofs_stress: ok (%zu inputs marked)\n", marked.load());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,58 @@
+// Check driver for malformed NUT-10 spending-condition tags
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude tests/spending_conditions_check.cpp src/cashu/core/*.cpp src/cashu/core/crypto/*.cpp src/cashu/core/nuts/*.cpp -lsecp256k1 -lcrypto -o spending_conditions_check && ./spending_conditions_check
+//
+// Checks:
+//   - a P2PK secret with a malformed n_sigs, locktime or sigflag tag is
+//     rejected with a TRANSACTION error even without a witness
+//   - a secret that is not shaped [kind, {data, nonce, tags}] is spent as a
+//     plain secret
+
+#include "cashu/core/conditions.hpp"
+#include "test_support.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace cashu::core;
+using namespace cashu::test;
+
+namespace {
+    const string PUBKEY = "02" + string(64, 'a');
+
+    string p2pk_secret(const string& tags) {
+        return R"(["P2PK",{"nonce":"00","data":")" + PUBKEY + R"(","tags":)" + tags + "}]";
+    }
+
+    Result<void> spend(const string& secret) {
+        vector<base::Proof> proofs;
+        proofs.emplace_back("009a1f293253e41e", 8, secret, PUBKEY);
+        return check_spending_conditions(proofs, {}, 0);
+    }
+
+    bool rejected(const Result<void>& result) {
+        return !result.has_value() && result.error().code() == CashuErrorCode::TRANSACTION;
+    }
+}
+
+int main() {
+    check(rejected(spend(p2pk_secret(R"([["n_sigs","abc"]])"))), "malformed n_sigs is rejected");
+    check(rejected(spend(p2pk_secret(R"([["n_sigs","0"]])"))), "zero n_sigs is rejected");
+    check(rejected(spend(p2pk_secret(R"([["locktime","1e9"]])"))), "malformed locktime is rejected");
+    check(rejected(spend(p2pk_secret(R"([["sigflag","SIG_SOME"]])"))), "unknown sigflag is rejected");
+    check(rejected(spend(p2pk_secret("[]"))), "valid P2PK lock without a signature is rejected");
+
+    check(spend(R"(["P2PK",{"data":"x"}])").has_value(), "secret without nonce is plain");
+    check(spend(R"(["P2PK","x"])").has_value(), "secret without body object is plain");
+    check(spend("plain secret").has_value(), "plain secret is unconditioned");
+
+    if (failures.load() != 0) {
+        fprintf(stderr, "%zu checks failed\n", failures.load());
+        return EXIT_FAILURE;
+    }
+    printf("spending_conditions_check: ok\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+// Concurrency stress driver for SpentIndex
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Iinclude tests/spent_index_stress.cpp src/cashu/core/*.cpp src/cashu/core/crypto/*.cpp src/cashu/core/nuts/*.cpp -lsecp256k1 -lcrypto -o spent_index_stress && ./spent_index_stress
+//
+// The index starts far below its final size, so every shard grows many times
+// while threads insert, erase and look up. Checks:
+//   - each contested Y is won by exactly one insert() per round
+//   - an inserted Y is found by contains() until it is erased
+//   - erase() succeeds once per inserted Y, and the final size() is exact
+
+#include "cashu/core/spent_index.hpp"
+#include "test_support.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cashu::core;
+using namespace cashu::test;
+using base::Point33;
+
+namespace {
+    constexpr size_t THREADS = 8;
+    constexpr size_t OWN_PER_THREAD = 20000;  // Distinct Ys per thread
+    constexpr size_t CONTESTED = 5000;         // Ys every thread tries to insert
+    constexpr size_t ROUNDS = 3;
+
+    // Insert own Ys, erase every other one and re-check both halves
+    void own_worker(SpentIndex& index, const vector<Point33>& own) {
+        for (const Point33& Y : own) {
+            check(index.insert(Y), "insert of a new Y succeeds");
+            check(index.contains(Y), "inserted Y is found");
+        }
+        for (size_t i = 0; i < own.size(); i += 2) {
+            check(index.erase(own[i]), "erase of an inserted Y succeeds");
+            check(!index.erase(own[i]), "second erase fails");
+        }
+        for (size_t i = 0; i < own.size(); ++i) {
+            check(index.contains(own[i]) == (i % 2 == 1), "erased Ys are gone, kept Ys remain");
+        }
+    }
+}
+
+int main() {
+    SpentIndex index(64, 4);
+
+    vector<vector<Point33>> own(THREADS);
+    for (size_t t = 0; t < THREADS; ++t) {
+        own[t] = random_points(OWN_PER_THREAD, 1000 + t);
+    }
+    vector<Point33> contested = random_points(CONTESTED, 7);
+
+    size_t expected = 0;
+    for (size_t round = 0; round < ROUNDS; ++round) {
+        vector<atomic<uint32_t>> wins(CONTESTED);
+        atomic<bool> start{false};
+        vector<thread> threads;
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&, t]() {
+                while (!start.load()) {
+                    this_thread::yield();
+                }
+                // Half the threads race for the contested Ys first, so their
+                // inserts overlap with growth triggered by the other half
+                if (t % 2 == 0) {
+                    for (size_t i = 0; i < CONTESTED; ++i) {
+                        if (index.insert(contested[i])) {
+                            wins[i].fetch_add(1);
+                        }
+                    }
+                }
+                if (round == 0) {
+                    own_worker(index, own[t]);
+                }
+                if (t % 2 == 1) {
+                    for (size_t i = CONTESTED; i-- > 0;) {
+                        if (index.insert(contested[i])) {
+                            wins[i].fetch_add(1);
+                        }
+                    }
+                }
+            });
+        }
+        start.store(true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (size_t i = 0; i < CONTESTED; ++i) {
+            check(wins[i].load() == (round == 0 ? 1u : 0u), "contested Y is won exactly once");
+            check(index.contains(contested[i]), "contested Y is spent");
+        }
+        if (round == 0) {
+            expected = CONTESTED + THREADS * (OWN_PER_THREAD / 2);
+        }
+        check(index.size() == expected, "size counts every kept Y once");
+    }
+
+    // Roll back the contested Ys from many threads at once
+    atomic<size_t> erased{0};
+    vector<thread> erasers;
+    for (size_t t = 0; t < THREADS; ++t) {
+        erasers.emplace_back([&]() {
+            for (const Point33& Y : contested) {
+                erased.fetch_add(index.erase(Y) ? 1 : 0);
+            }
+        });
+    }
+    for (auto& thread : erasers) {
+        thread.join();
+    }
+    check(erased.load() == CONTESTED, "each contested Y is erased exactly once");
+    check(index.size() == expected - CONTESTED, "size after concurrent erase");
+
+    if (failures.load() != 0) {
+        fprintf(stderr, "%zu checks failed\n", failures.load());
+        return EXIT_FAILURE;
+    }
+    printf("spent_index_stress: ok (%zu proofs)\n", index.size());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// Helpers shared by the standalone test drivers in this directory
+
+#include "cashu/core/base.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace cashu::test {
+
+// Failed checks so far; safe to update from any thread
+inline std::atomic<size_t> failures{0};
+
+/**
+ * @brief Record a failed check; the first 10 failures are printed
+ */
+inline void check(bool condition, const char* what) {
+    if (!condition && failures.fetch_add(1) < 10) {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+    }
+}
+
+/**
+ * @brief Distinct-looking compressed point bytes (not necessarily on the curve)
+ * @param count Number of points
+ * @param seed RNG seed, so runs are reproducible
+ */
+inline std::vector<core::base::Point33> random_points(size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<core::base::Point33> points(count);
+    for (core::base::Point33& point : points) {
+        point[0] = 0x02 | (rng() & 1);
+        for (size_t i = 1; i < point.size(); ++i) {
+            point[i] = static_cast<uint8_t>(rng());
+        }
+    }
+    return points;
+}
+
+} // namespace cashu::test